@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include "aligned_allocator.hpp"
+#include "vector.hpp"
+#include "vector_algorithms.hpp"
+
+/*
+    Storage policies: random reads over 256 MiB with 4 KiB pages against
+    transparent hugepages (TLB reach), first writes into reserved memory
+    with and without prefaulting, and a SIMD reduction over cache-line
+    aligned data against the same data shifted by one element (every
+    AVX-512 load splits a line).
+*/
+
+namespace
+{
+    constexpr size_t kGatherElements = size_t(32) << 20; // 256 MiB of uint64_t
+
+    template <typename Allocator>
+    Vector<uint64_t, Allocator> makeTable()
+    {
+        Vector<uint64_t, Allocator> v;
+        v.reserve(kGatherElements);
+        for (size_t i = 0; i < kGatherElements; ++i)
+        {
+            v.push_back(i);
+        }
+        return v;
+    }
+}
+
+template <typename Allocator>
+static void BM_RandomGather(benchmark::State &state)
+{
+    const auto table = makeTable<Allocator>();
+    std::mt19937_64 rng(3);
+    uint64_t sum = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < 1024; ++i)
+        {
+            sum += table[rng() % kGatherElements];
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+template <typename Allocator>
+static void BM_FirstTouchAfterReserve(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Vector<uint64_t, Allocator> v;
+        v.reserve(n);
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+
+        state.PauseTiming();
+        v = Vector<uint64_t, Allocator>();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ReduceAligned(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    AlignedVector<float, 64> v;
+    v.resize(n + 16, 1.0f);
+    const size_t offset = static_cast<size_t>(state.range(1));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(vector_algorithms::reduce(v.data() + offset, n));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(float)));
+}
+
+BENCHMARK_TEMPLATE(BM_RandomGather, std::allocator<uint64_t>);
+BENCHMARK_TEMPLATE(BM_RandomGather, HugePageAllocator<uint64_t, HugePages::Transparent>);
+BENCHMARK_TEMPLATE(BM_FirstTouchAfterReserve, HugePageAllocator<uint64_t, HugePages::None, false>)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_FirstTouchAfterReserve, HugePageAllocator<uint64_t, HugePages::None, true>)->Arg(1 << 22);
+// Offset 0 is line-aligned, offset 1 misaligns every load by 4 bytes
+BENCHMARK(BM_ReduceAligned)->Args({4096, 0})->Args({4096, 1})->Args({1 << 20, 0})->Args({1 << 20, 1});
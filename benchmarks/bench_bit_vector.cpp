@@ -0,0 +1,175 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "bit_vector.hpp"
+
+/*
+    BitVector against std::vector<bool> (also bit-packed, bit-at-a-time
+    algorithms) and Vector<bool> (one byte per flag): appending flags,
+    AND of two sets, counting set bits, and the rank/select index on
+    random queries, up to 2^28 bits.
+*/
+
+namespace
+{
+    constexpr size_t kQueries = 1 << 16;
+
+    std::vector<bool> randomFlags(size_t n, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<bool> flags(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            flags[i] = rng() & 1;
+        }
+        return flags;
+    }
+
+    template <typename Bits>
+    Bits build(const std::vector<bool> &flags)
+    {
+        Bits bits;
+        for (const bool flag : flags)
+        {
+            bits.push_back(flag);
+        }
+        return bits;
+    }
+
+    BitVector randomBitVector(size_t n, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        BitVector bits;
+        bits.reserve(n);
+        for (size_t i = 0; i < n; i += 64)
+        {
+            bits.append_bits(rng(), std::min<size_t>(64, n - i));
+        }
+        return bits;
+    }
+
+    size_t countOnes(const BitVector &bits) { return bits.count(); }
+    size_t countOnes(const std::vector<bool> &bits) { return static_cast<size_t>(std::count(bits.begin(), bits.end(), true)); }
+    size_t countOnes(const Vector<bool> &bits) { return static_cast<size_t>(std::count(bits.begin(), bits.end(), true)); }
+
+    void andInPlace(BitVector &a, const BitVector &b) { a &= b; }
+    void andInPlace(std::vector<bool> &a, const std::vector<bool> &b)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            a[i] = a[i] && b[i];
+        }
+    }
+    void andInPlace(Vector<bool> &a, const Vector<bool> &b)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            a[i] = a[i] && b[i];
+        }
+    }
+}
+
+template <typename Bits>
+static void BM_BitsPushBack(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Bits bits;
+        for (size_t i = 0; i < n; ++i)
+        {
+            bits.push_back((i * 0x9E3779B97F4A7C15ull) >> 63);
+        }
+        benchmark::DoNotOptimize(&bits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Bits>
+static void BM_BitsAnd(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Bits a = build<Bits>(randomFlags(n, 1));
+    const Bits b = build<Bits>(randomFlags(n, 2));
+    for (auto _ : state)
+    {
+        andInPlace(a, b);
+        benchmark::DoNotOptimize(&a);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Bits>
+static void BM_BitsCount(benchmark::State &state)
+{
+    const Bits bits = build<Bits>(randomFlags(static_cast<size_t>(state.range(0)), 3));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(countOnes(bits));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BitsRank(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const BitVector bits = randomBitVector(n, 4);
+    const RankSelect index(bits);
+    std::mt19937_64 rng(5);
+    std::vector<size_t> queries(kQueries);
+    for (size_t &q : queries)
+    {
+        q = rng() % n;
+    }
+
+    size_t i = 0;
+    size_t sum = 0;
+    for (auto _ : state)
+    {
+        sum += index.rank1(queries[i]);
+        i = (i + 1) % kQueries;
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_BitsSelect(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const BitVector bits = randomBitVector(n, 6);
+    const RankSelect index(bits);
+    std::mt19937_64 rng(7);
+    std::vector<size_t> queries(kQueries);
+    for (size_t &q : queries)
+    {
+        q = rng() % index.ones();
+    }
+
+    size_t i = 0;
+    size_t sum = 0;
+    for (auto _ : state)
+    {
+        sum += index.select1(queries[i]);
+        i = (i + 1) % kQueries;
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_BitsPushBack, BitVector)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BitsPushBack, std::vector<bool>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BitsPushBack, Vector<bool>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_BitsAnd, BitVector)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BitsAnd, std::vector<bool>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BitsAnd, Vector<bool>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_BitsCount, BitVector)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BitsCount, std::vector<bool>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BitsCount, Vector<bool>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_BitsRank)->RangeMultiplier(16)->Range(1 << 16, 1 << 28);
+BENCHMARK(BM_BitsSelect)->RangeMultiplier(16)->Range(1 << 16, 1 << 28);
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "concurrent_vector.hpp"
+#include "vector.hpp"
+
+/*
+    Many writers appending into one shared container: ConcurrentVector
+    (one fetch_add per element) against a Vector behind a mutex. Arg 0 is
+    the total element count, arg 1 the number of writer threads (1 to 64,
+    oversubscribing the machine past its hardware thread count).
+*/
+
+namespace
+{
+    void writerCounts(benchmark::internal::Benchmark *b)
+    {
+        for (int64_t threads = 1; threads <= 64; threads *= 2)
+        {
+            b->Args({1 << 20, threads});
+        }
+    }
+
+    // Runs append(i) for [0, total) split evenly across threads
+    template <typename Append>
+    void runWriters(size_t total, size_t threads, Append append)
+    {
+        std::vector<std::thread> writers;
+        writers.reserve(threads);
+        for (size_t t = 0; t < threads; ++t)
+        {
+            writers.emplace_back([=] {
+                for (size_t i = t; i < total; i += threads)
+                {
+                    append(static_cast<int64_t>(i));
+                }
+            });
+        }
+        for (std::thread &writer : writers)
+        {
+            writer.join();
+        }
+    }
+}
+
+static void BM_ConcurrentVectorAppend(benchmark::State &state)
+{
+    const size_t total = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        ConcurrentVector<int64_t> v;
+        runWriters(total, static_cast<size_t>(state.range(1)), [&v](int64_t x) { v.push_back(x); });
+        benchmark::DoNotOptimize(v[total - 1]);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_MutexVectorAppend(benchmark::State &state)
+{
+    const size_t total = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vector<int64_t> v;
+        std::mutex lock;
+        runWriters(total, static_cast<size_t>(state.range(1)), [&v, &lock](int64_t x) {
+            std::lock_guard<std::mutex> guard(lock);
+            v.push_back(x);
+        });
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ConcurrentVectorAppend)->Apply(writerCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MutexVectorAppend)->Apply(writerCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include "cow_vector.hpp"
+#include "vector.hpp"
+
+/*
+    Handing one buffer to a reader: a deep Vector copy against a CowVector
+    copy (refcount increment), and what the first write on a shared
+    CowVector costs (the deferred deep copy).
+*/
+
+namespace
+{
+    Vector<std::string> makeStrings(size_t n)
+    {
+        Vector<std::string> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(std::string(24, static_cast<char>('a' + i % 26)));
+        }
+        return v;
+    }
+}
+
+static void BM_HandOffVectorCopy(benchmark::State &state)
+{
+    const Vector<std::string> source = makeStrings(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        Vector<std::string> reader(source);
+        benchmark::DoNotOptimize(reader.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_HandOffCowCopy(benchmark::State &state)
+{
+    const CowVector<std::string> source = freeze(makeStrings(static_cast<size_t>(state.range(0))));
+    for (auto _ : state)
+    {
+        CowVector<std::string> reader(source);
+        benchmark::DoNotOptimize(reader.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_CowFirstWrite(benchmark::State &state)
+{
+    const CowVector<std::string> source = freeze(makeStrings(static_cast<size_t>(state.range(0))));
+    for (auto _ : state)
+    {
+        CowVector<std::string> writer(source);
+        writer.set(0, "changed");
+        benchmark::DoNotOptimize(writer.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_HandOffVectorCopy)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK(BM_HandOffCowCopy)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK(BM_CowFirstWrite)->RangeMultiplier(10)->Range(100, 1000000);
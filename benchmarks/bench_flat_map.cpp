@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "flat_map.hpp"
+
+/*
+    FlatMap against the node-based std::map and the hash-based
+    std::unordered_map, 10^3 to 10^7 uint64_t keys: random successful
+    lookups (the routing table case) and building the table from unsorted
+    pairs. BinarySearch and EytzingerSearch are both measured.
+*/
+
+namespace
+{
+    constexpr size_t kProbes = 1 << 16;
+
+    // n distinct random keys with their values
+    std::vector<std::pair<uint64_t, uint64_t>> makePairs(size_t n)
+    {
+        std::mt19937_64 rng(n);
+        std::vector<std::pair<uint64_t, uint64_t>> pairs;
+        pairs.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            // Odd multiplier: a bijection, so keys are distinct but unordered
+            pairs.emplace_back(i * 0x9E3779B97F4A7C15ull, rng());
+        }
+        return pairs;
+    }
+
+    // Keys to look up, all present, in random order
+    std::vector<uint64_t> makeProbes(const std::vector<std::pair<uint64_t, uint64_t>> &pairs)
+    {
+        std::mt19937_64 rng(7);
+        std::vector<uint64_t> probes;
+        probes.reserve(kProbes);
+        for (size_t i = 0; i < kProbes; ++i)
+        {
+            probes.push_back(pairs[rng() % pairs.size()].first);
+        }
+        return probes;
+    }
+
+    template <typename Map>
+    Map build(const std::vector<std::pair<uint64_t, uint64_t>> &pairs)
+    {
+        if constexpr (requires(Map m) { m.insert_range(pairs); })
+        {
+            Map map;
+            map.insert_range(pairs);
+            return map;
+        }
+        else
+        {
+            return Map(pairs.begin(), pairs.end());
+        }
+    }
+
+    using BinaryFlatMap = FlatMap<uint64_t, uint64_t>;
+    using EytzingerFlatMap = FlatMap<uint64_t, uint64_t, std::less<uint64_t>, EytzingerSearch>;
+}
+
+template <typename Map>
+static void BM_MapLookup(benchmark::State &state)
+{
+    const auto pairs = makePairs(static_cast<size_t>(state.range(0)));
+    const Map map = build<Map>(pairs);
+    const std::vector<uint64_t> probes = makeProbes(pairs);
+
+    size_t i = 0;
+    uint64_t sum = 0;
+    for (auto _ : state)
+    {
+        sum += map.find(probes[i])->second;
+        i = (i + 1) % kProbes;
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Map>
+static void BM_MapBuild(benchmark::State &state)
+{
+    const auto pairs = makePairs(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        Map map = build<Map>(pairs);
+        benchmark::DoNotOptimize(&map);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_MapLookup, std::map<uint64_t, uint64_t>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_MapLookup, std::unordered_map<uint64_t, uint64_t>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_MapLookup, BinaryFlatMap)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_MapLookup, EytzingerFlatMap)->RangeMultiplier(10)->Range(1000, 10000000);
+
+BENCHMARK_TEMPLATE(BM_MapBuild, std::map<uint64_t, uint64_t>)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MapBuild, std::unordered_map<uint64_t, uint64_t>)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MapBuild, BinaryFlatMap)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MapBuild, EytzingerFlatMap)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "vector.hpp"
+#include "incremental_vector.hpp"
+
+/*
+    Tail latency of individual push_back calls.
+
+    Each iteration fills a fresh container with n elements and times every
+    single push_back. The percentiles of that distribution are reported as
+    counters (nanoseconds): p50 stays flat for all containers, the p99/p999
+    and max columns show the reallocation spikes that IncrementalVector
+    spreads out over later pushes.
+*/
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    void reportPercentiles(benchmark::State &state, std::vector<int64_t> &latencies)
+    {
+        std::sort(latencies.begin(), latencies.end());
+        const auto at = [&](double q)
+        {
+            const size_t index = std::min(latencies.size() - 1, static_cast<size_t>(q * latencies.size()));
+            return static_cast<double>(latencies[index]);
+        };
+        state.counters["p50_ns"] = at(0.50);
+        state.counters["p99_ns"] = at(0.99);
+        state.counters["p999_ns"] = at(0.999);
+        state.counters["p9999_ns"] = at(0.9999);
+        state.counters["max_ns"] = static_cast<double>(latencies.back());
+    }
+}
+
+template <typename Container>
+static void BM_PushBackLatency(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<int64_t> latencies;
+    // One sample per push_back of the single iteration
+    latencies.reserve(n);
+
+    for (auto _ : state)
+    {
+        Container c;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto start = Clock::now();
+            c.push_back(static_cast<int>(i));
+            const auto stop = Clock::now();
+            if (latencies.size() < latencies.capacity())
+            {
+                latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+            }
+        }
+        benchmark::DoNotOptimize(c.size());
+    }
+
+    reportPercentiles(state, latencies);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_PushBackLatency, Vector<int>)->RangeMultiplier(10)->Range(100000, 100000000)->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_PushBackLatency, std::vector<int>)->RangeMultiplier(10)->Range(100000, 100000000)->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_PushBackLatency, IncrementalVector<int>)->RangeMultiplier(10)->Range(100000, 100000000)->Unit(benchmark::kMillisecond)->Iterations(1);
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include "mmap_vector.hpp"
+#include "vector.hpp"
+
+/*
+    Startup cost of a table of records: rebuilding a Vector from scratch
+    against reopening an MmapVector that already holds it (zero-copy, pages
+    are faulted in on first touch), plus push_back into the mapping.
+*/
+
+namespace
+{
+    struct Record
+    {
+        uint64_t id;
+        double value;
+        uint32_t flags;
+        uint32_t group;
+    };
+
+    Record makeRecord(size_t i)
+    {
+        return Record{i, static_cast<double>(i) * 0.5, static_cast<uint32_t>(i % 7), static_cast<uint32_t>(i % 100)};
+    }
+
+    std::string benchFile(const char *name)
+    {
+        return (std::filesystem::temp_directory_path() /
+                ("vector_bench_" + std::to_string(::getpid()) + "_" + name + ".bin"))
+            .string();
+    }
+}
+
+static void BM_RebuildVector(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vector<Record> table;
+        for (size_t i = 0; i < n; ++i)
+        {
+            table.push_back(makeRecord(i));
+        }
+        benchmark::DoNotOptimize(table.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ReopenMmap(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = benchFile("reopen");
+    {
+        MmapVector<Record> table(path, MmapOpenMode::Truncate, MmapFlushPolicy::None);
+        table.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            table.push_back(makeRecord(i));
+        }
+    }
+
+    for (auto _ : state)
+    {
+        MmapVector<Record> table(path, MmapOpenMode::OpenExisting, MmapFlushPolicy::None);
+        benchmark::DoNotOptimize(table[table.size() - 1].id);
+    }
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_MmapPushBack(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = benchFile("push");
+    for (auto _ : state)
+    {
+        MmapVector<Record> table(path, MmapOpenMode::Truncate, MmapFlushPolicy::None);
+        for (size_t i = 0; i < n; ++i)
+        {
+            table.push_back(makeRecord(i));
+        }
+        benchmark::DoNotOptimize(table.data());
+    }
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RebuildVector)->RangeMultiplier(10)->Range(1000, 10000000)->UseRealTime();
+BENCHMARK(BM_ReopenMmap)->RangeMultiplier(10)->Range(1000, 10000000)->UseRealTime();
+BENCHMARK(BM_MmapPushBack)->RangeMultiplier(10)->Range(1000, 10000000)->UseRealTime();
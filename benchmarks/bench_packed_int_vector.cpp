@@ -0,0 +1,229 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "packed_int_vector.hpp"
+
+/*
+    PackedIntVector on 2^20 values of typical column shapes: compression
+    ratio (counter "ratio", uncompressed / compressed) and decode speed in
+    decoded bytes per second, next to a plain Vector scan as the memory
+    bandwidth baseline. Also appending (encoding) and random access.
+*/
+
+namespace
+{
+    constexpr size_t kValues = 1 << 20;
+
+    // Sorted uint32_t row IDs with small gaps
+    struct SortedIds
+    {
+        using type = uint32_t;
+        static std::vector<type> make(size_t n)
+        {
+            std::mt19937 rng(1);
+            std::vector<type> values(n);
+            type id = 1000;
+            for (type &v : values)
+            {
+                id += 1 + rng() % 8;
+                v = id;
+            }
+            return values;
+        }
+    };
+
+    // Millisecond timestamps of irregular events
+    struct Timestamps
+    {
+        using type = uint64_t;
+        static std::vector<type> make(size_t n)
+        {
+            std::mt19937_64 rng(2);
+            std::exponential_distribution<double> gap(1.0 / 200);
+            std::vector<type> values(n);
+            type t = 1700000000000ull;
+            for (type &v : values)
+            {
+                t += static_cast<type>(gap(rng));
+                v = t;
+            }
+            return values;
+        }
+    };
+
+    // Small unsorted counts with a long tail
+    struct SkewedCounts
+    {
+        using type = uint32_t;
+        static std::vector<type> make(size_t n)
+        {
+            std::mt19937 rng(3);
+            std::geometric_distribution<type> count(0.02);
+            std::vector<type> values(n);
+            for (type &v : values)
+            {
+                v = count(rng);
+            }
+            return values;
+        }
+    };
+
+    // Noisy sensor samples drifting around a level
+    struct RandomWalk
+    {
+        using type = int32_t;
+        static std::vector<type> make(size_t n)
+        {
+            std::mt19937 rng(4);
+            std::vector<type> values(n);
+            type level = 0;
+            for (type &v : values)
+            {
+                level += static_cast<type>(rng() % 21) - 10;
+                v = level;
+            }
+            return values;
+        }
+    };
+
+    // Hashes: incompressible, the worst case
+    struct RandomU64
+    {
+        using type = uint64_t;
+        static std::vector<type> make(size_t n)
+        {
+            std::mt19937_64 rng(5);
+            std::vector<type> values(n);
+            for (type &v : values)
+            {
+                v = rng();
+            }
+            return values;
+        }
+    };
+
+    template <typename Dist>
+    void reportRatio(benchmark::State &state, const PackedIntVector<typename Dist::type> &packed)
+    {
+        state.counters["ratio"] = packed.compression_ratio();
+        state.counters["bits/value"] = 8.0 * static_cast<double>(packed.compressed_bytes()) / static_cast<double>(packed.size());
+    }
+}
+
+// All values into one Vector
+template <typename Dist>
+static void BM_PackedDecode(benchmark::State &state)
+{
+    using T = typename Dist::type;
+    const PackedIntVector<T> packed(Dist::make(kValues));
+    Vector<T> out;
+    for (auto _ : state)
+    {
+        packed.decode(out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * kValues * sizeof(T));
+    reportRatio<Dist>(state, packed);
+}
+
+// Sum of all values, a block at a time through one reused buffer
+template <typename Dist>
+static void BM_PackedScan(benchmark::State &state)
+{
+    using T = typename Dist::type;
+    const PackedIntVector<T> packed(Dist::make(kValues));
+    Vector<T> buffer;
+    for (auto _ : state)
+    {
+        T sum = 0;
+        packed.for_each_block(buffer, [&](std::span<const T> block)
+                              {
+                                  for (const T v : block)
+                                  {
+                                      sum += v;
+                                  }
+                              });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * kValues * sizeof(T));
+    reportRatio<Dist>(state, packed);
+}
+
+// Baseline: the same sum over the uncompressed values
+template <typename Dist>
+static void BM_PlainScan(benchmark::State &state)
+{
+    using T = typename Dist::type;
+    const std::vector<T> source = Dist::make(kValues);
+    const Vector<T> plain(source);
+    for (auto _ : state)
+    {
+        T sum = 0;
+        for (const T v : plain)
+        {
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * kValues * sizeof(T));
+}
+
+template <typename Dist>
+static void BM_PackedAppend(benchmark::State &state)
+{
+    using T = typename Dist::type;
+    const std::vector<T> values = Dist::make(kValues);
+    for (auto _ : state)
+    {
+        PackedIntVector<T> packed;
+        packed.append_range(values);
+        benchmark::DoNotOptimize(&packed);
+    }
+    state.SetBytesProcessed(state.iterations() * kValues * sizeof(T));
+}
+
+template <typename Dist>
+static void BM_PackedRandomAccess(benchmark::State &state)
+{
+    using T = typename Dist::type;
+    const PackedIntVector<T> packed(Dist::make(kValues));
+    std::mt19937 rng(6);
+    std::vector<size_t> probes(1 << 16);
+    for (size_t &p : probes)
+    {
+        p = rng() % kValues;
+    }
+
+    size_t i = 0;
+    T sum = 0;
+    for (auto _ : state)
+    {
+        sum += packed[probes[i]];
+        i = (i + 1) % probes.size();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_PackedDecode, SortedIds);
+BENCHMARK_TEMPLATE(BM_PackedDecode, Timestamps);
+BENCHMARK_TEMPLATE(BM_PackedDecode, SkewedCounts);
+BENCHMARK_TEMPLATE(BM_PackedDecode, RandomWalk);
+BENCHMARK_TEMPLATE(BM_PackedDecode, RandomU64);
+
+BENCHMARK_TEMPLATE(BM_PackedScan, SortedIds);
+BENCHMARK_TEMPLATE(BM_PackedScan, Timestamps);
+BENCHMARK_TEMPLATE(BM_PackedScan, SkewedCounts);
+BENCHMARK_TEMPLATE(BM_PlainScan, SortedIds);
+BENCHMARK_TEMPLATE(BM_PlainScan, Timestamps);
+
+BENCHMARK_TEMPLATE(BM_PackedAppend, SortedIds);
+BENCHMARK_TEMPLATE(BM_PackedAppend, Timestamps);
+BENCHMARK_TEMPLATE(BM_PackedAppend, SkewedCounts);
+
+BENCHMARK_TEMPLATE(BM_PackedRandomAccess, SortedIds);
+BENCHMARK_TEMPLATE(BM_PackedRandomAccess, SkewedCounts);
+BENCHMARK_TEMPLATE(BM_PackedRandomAccess, Timestamps);
@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include "remap_allocator.hpp"
+#include "vector.hpp"
+
+/*
+    push_back of doubles from empty up to 10M-100M elements (80-800 MB):
+    std::allocator copies the whole buffer on every doubling, RemapAllocator
+    moves page table entries with mremap instead.
+*/
+
+template <typename Allocator>
+static void BM_GrowLarge(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vector<double, Allocator> v;
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(static_cast<double>(i));
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_GrowLarge, std::allocator<double>)->RangeMultiplier(10)->Range(100000, 100000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GrowLarge, RemapAllocator<double>)->RangeMultiplier(10)->Range(100000, 100000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include "segmented_vector.hpp"
+#include "vector.hpp"
+#include "vector_algorithms.hpp"
+
+/*
+    SegmentedVector against Vector: appending non-trivial elements (Vector
+    moves every string on each reallocation, SegmentedVector never does),
+    and the price of segmented storage on reads, by index, by iterator and
+    chunk by chunk.
+*/
+
+namespace
+{
+    // Long enough to defeat the small-string buffer
+    std::string makeString(size_t i)
+    {
+        return std::string(24, static_cast<char>('a' + i % 26));
+    }
+
+    template <typename Container>
+    Container makeInts(size_t n)
+    {
+        Container v;
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(static_cast<int32_t>(i % 1000));
+        }
+        return v;
+    }
+}
+
+template <typename Container>
+static void BM_AppendStrings(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Container v;
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(makeString(i));
+        }
+        benchmark::DoNotOptimize(&v[n - 1]);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+static void BM_SumByIndex(benchmark::State &state)
+{
+    const Container v = makeInts<Container>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+        for (size_t i = 0; i < v.size(); ++i)
+        {
+            sum += v[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+static void BM_SumByIterator(benchmark::State &state)
+{
+    const Container v = makeInts<Container>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+        for (int32_t x : v)
+        {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SumByChunk(benchmark::State &state)
+{
+    const auto v = makeInts<SegmentedVector<int32_t>>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+        for (std::span<const int32_t> chunk : v.chunks())
+        {
+            for (int32_t x : chunk)
+            {
+                sum += x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SumByChunkSimd(benchmark::State &state)
+{
+    const auto v = makeInts<SegmentedVector<int32_t>>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+        for (std::span<const int32_t> chunk : v.chunks())
+        {
+            sum += vector_algorithms::reduce(chunk);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_AppendStrings, Vector<std::string>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_AppendStrings, SegmentedVector<std::string>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_SumByIndex, Vector<int32_t>)->RangeMultiplier(100)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_SumByIndex, SegmentedVector<int32_t>)->RangeMultiplier(100)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_SumByIterator, Vector<int32_t>)->RangeMultiplier(100)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_SumByIterator, SegmentedVector<int32_t>)->RangeMultiplier(100)->Range(1000, 10000000);
+BENCHMARK(BM_SumByChunk)->RangeMultiplier(100)->Range(1000, 10000000);
+BENCHMARK(BM_SumByChunkSimd)->RangeMultiplier(100)->Range(1000, 10000000);
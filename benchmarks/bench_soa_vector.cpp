@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include "soa_vector.hpp"
+#include "vector.hpp"
+#include "vector_algorithms.hpp"
+
+/*
+    Array-of-structs Vector<Particle> against SoAVector with the same twelve
+    fields, on passes that read one or two of them. The AoS scan drags the
+    other ten fields through the cache; the SoA scan streams one column and
+    can use the SIMD kernels.
+*/
+
+namespace
+{
+    struct Particle
+    {
+        float x, y, z;
+        float vx, vy, vz;
+        float mass, charge, radius, age;
+        int32_t id, flags;
+    };
+
+    using ParticleColumns =
+        SoAVector<float, float, float, float, float, float, float, float, float, float, int32_t, int32_t>;
+
+    Particle makeParticle(size_t i)
+    {
+        const float f = static_cast<float>(i % 1000);
+        return Particle{f, f, f, 1, 1, 1, 1, 0, 0.5f, 0, static_cast<int32_t>(i), 0};
+    }
+
+    Vector<Particle> makeAoS(size_t n)
+    {
+        Vector<Particle> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(makeParticle(i));
+        }
+        return v;
+    }
+
+    ParticleColumns makeSoA(size_t n)
+    {
+        ParticleColumns v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Particle p = makeParticle(i);
+            v.push_back(p.x, p.y, p.z, p.vx, p.vy, p.vz, p.mass, p.charge, p.radius, p.age, p.id, p.flags);
+        }
+        return v;
+    }
+}
+
+static void BM_SumFieldAoS(benchmark::State &state)
+{
+    const Vector<Particle> v = makeAoS(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        float sum = 0;
+        for (const Particle &p : v)
+        {
+            sum += p.x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SumFieldSoA(benchmark::State &state)
+{
+    const ParticleColumns v = makeSoA(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        float sum = 0;
+        for (float x : v.column<0>())
+        {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SumFieldSoASimd(benchmark::State &state)
+{
+    const ParticleColumns v = makeSoA(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(vector_algorithms::reduce(v.column<0>()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// x += vx, reads two fields and writes one
+static void BM_IntegrateAoS(benchmark::State &state)
+{
+    Vector<Particle> v = makeAoS(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (Particle &p : v)
+        {
+            p.x += p.vx;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_IntegrateSoA(benchmark::State &state)
+{
+    ParticleColumns v = makeSoA(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        vector_algorithms::add(v.data<0>(), v.data<3>(), v.data<0>(), v.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 1K (L1) to 10M (DRAM) particles
+BENCHMARK(BM_SumFieldAoS)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_SumFieldSoA)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_SumFieldSoASimd)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_IntegrateAoS)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_IntegrateSoA)->RangeMultiplier(10)->Range(1000, 10000000);
@@ -0,0 +1,249 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+#include "vector.hpp"
+
+/*
+    Vector vs std::vector on the operations that dominate real workloads.
+    Every benchmark is instantiated for
+
+      - int            trivial: memcpy/memmove paths
+      - std::string    non-trivial, nothrow move
+      - ThrowingMove   move constructor not noexcept, std::vector falls
+                       back to copying on growth
+
+    Sizes go from 8 to 10^8 elements for int. Non-trivial types stop at
+    10^6 so a full run stays within a few minutes and a few GB of RAM.
+*/
+
+namespace
+{
+    struct ThrowingMove
+    {
+        std::string payload;
+
+        ThrowingMove(int i) : payload(32, static_cast<char>('a' + i % 26)) {}
+        ThrowingMove(const ThrowingMove &) = default;
+        ThrowingMove(ThrowingMove &&other) noexcept(false) : payload(std::move(other.payload)) {}
+        ThrowingMove &operator=(const ThrowingMove &) = default;
+        ThrowingMove &operator=(ThrowingMove &&other) noexcept(false)
+        {
+            payload = std::move(other.payload);
+            return *this;
+        }
+    };
+
+    template <typename T>
+    T makeElement(int i)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            // Longer than the SSO buffer so every element owns heap memory
+            return std::string(32, static_cast<char>('a' + i % 26));
+        }
+        else
+        {
+            return T(i);
+        }
+    }
+
+    template <typename Container>
+    Container makeFilled(size_t n)
+    {
+        using T = typename Container::value_type;
+        Container c;
+        c.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            c.push_back(makeElement<T>(static_cast<int>(i)));
+        }
+        return c;
+    }
+
+    template <typename Container>
+    void setItems(benchmark::State &state)
+    {
+        using T = typename Container::value_type;
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(T)));
+    }
+}
+
+template <typename Container>
+static void BM_PushBack(benchmark::State &state)
+{
+    using T = typename Container::value_type;
+    const size_t n = static_cast<size_t>(state.range(0));
+    const T element = makeElement<T>(7);
+
+    for (auto _ : state)
+    {
+        Container c;
+        for (size_t i = 0; i < n; ++i)
+        {
+            c.push_back(element);
+        }
+        benchmark::DoNotOptimize(c.data());
+        benchmark::ClobberMemory();
+    }
+    setItems<Container>(state);
+}
+
+template <typename Container>
+static void BM_PushBackReserved(benchmark::State &state)
+{
+    using T = typename Container::value_type;
+    const size_t n = static_cast<size_t>(state.range(0));
+    const T element = makeElement<T>(7);
+
+    for (auto _ : state)
+    {
+        Container c;
+        c.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            c.push_back(element);
+        }
+        benchmark::DoNotOptimize(c.data());
+        benchmark::ClobberMemory();
+    }
+    setItems<Container>(state);
+}
+
+template <typename Container>
+static void BM_Iterate(benchmark::State &state)
+{
+    const Container c = makeFilled<Container>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        size_t checksum = 0;
+        for (const auto &v : c)
+        {
+            if constexpr (std::is_arithmetic_v<typename Container::value_type>)
+            {
+                checksum += static_cast<size_t>(v);
+            }
+            else if constexpr (std::is_same_v<typename Container::value_type, std::string>)
+            {
+                checksum += v.size();
+            }
+            else
+            {
+                checksum += v.payload.size();
+            }
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    setItems<Container>(state);
+}
+
+template <typename Container>
+static void BM_Copy(benchmark::State &state)
+{
+    const Container source = makeFilled<Container>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        Container copy(source);
+        benchmark::DoNotOptimize(copy.data());
+        benchmark::ClobberMemory();
+    }
+    setItems<Container>(state);
+}
+
+template <typename Container>
+static void BM_Move(benchmark::State &state)
+{
+    Container a = makeFilled<Container>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        Container b(std::move(a));
+        benchmark::DoNotOptimize(b.data());
+        a = std::move(b);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Container>
+static void BM_ReserveShrink(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Container c = makeFilled<Container>(n);
+
+    for (auto _ : state)
+    {
+        // Each iteration relocates the whole contents twice
+        c.reserve(2 * n);
+        c.shrink_to_fit();
+        benchmark::DoNotOptimize(c.data());
+    }
+    setItems<Container>(state);
+}
+
+// Range insert from another container's iterators: contiguous iterators of
+// trivial types take the memcpy path
+template <typename Container>
+static void BM_InsertRange(benchmark::State &state)
+{
+    const Container source = makeFilled<Container>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        Container c;
+        c.insert(c.end(), source.begin(), source.end());
+        benchmark::DoNotOptimize(c.data());
+        benchmark::ClobberMemory();
+    }
+    setItems<Container>(state);
+}
+
+// Cost of reallocation alone: grow a full vector one step past capacity
+template <typename Container>
+static void BM_Growth(benchmark::State &state)
+{
+    using T = typename Container::value_type;
+    const size_t n = static_cast<size_t>(state.range(0));
+    const T element = makeElement<T>(3);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Container c = makeFilled<Container>(n);
+        c.shrink_to_fit();
+        state.ResumeTiming();
+
+        c.push_back(element);
+        benchmark::DoNotOptimize(c.data());
+
+        state.PauseTiming();
+        c = Container();
+        state.ResumeTiming();
+    }
+    setItems<Container>(state);
+}
+
+#define VECTOR_BENCH_TRIVIAL(bm)                                                 \
+    BENCHMARK_TEMPLATE(bm, Vector<int>)->RangeMultiplier(10)->Range(8, 100000000); \
+    BENCHMARK_TEMPLATE(bm, std::vector<int>)->RangeMultiplier(10)->Range(8, 100000000)
+
+#define VECTOR_BENCH_NONTRIVIAL(bm)                                                         \
+    BENCHMARK_TEMPLATE(bm, Vector<std::string>)->RangeMultiplier(10)->Range(8, 1000000);       \
+    BENCHMARK_TEMPLATE(bm, std::vector<std::string>)->RangeMultiplier(10)->Range(8, 1000000);  \
+    BENCHMARK_TEMPLATE(bm, Vector<ThrowingMove>)->RangeMultiplier(10)->Range(8, 1000000);      \
+    BENCHMARK_TEMPLATE(bm, std::vector<ThrowingMove>)->RangeMultiplier(10)->Range(8, 1000000)
+
+#define VECTOR_BENCH_ALL(bm) \
+    VECTOR_BENCH_TRIVIAL(bm); \
+    VECTOR_BENCH_NONTRIVIAL(bm)
+
+VECTOR_BENCH_ALL(BM_PushBack);
+VECTOR_BENCH_ALL(BM_PushBackReserved);
+VECTOR_BENCH_ALL(BM_Iterate);
+VECTOR_BENCH_ALL(BM_Copy);
+VECTOR_BENCH_ALL(BM_Move);
+VECTOR_BENCH_ALL(BM_ReserveShrink);
+VECTOR_BENCH_ALL(BM_Growth);
+VECTOR_BENCH_TRIVIAL(BM_InsertRange);
@@ -0,0 +1,246 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include "vector.hpp"
+#include "vector_algorithms.hpp"
+
+/*
+    SIMD kernels (vector_algorithms.hpp) per instruction set against a
+    plain loop over Vector's iterators. Arg 0 is the element count, arg 1
+    the forced vector_algorithms::Isa (clamped to what the CPU supports,
+    the effective one is reported in the "isa" counter).
+*/
+
+namespace va = vector_algorithms;
+
+namespace
+{
+    template <typename T>
+    Vector<T> makeData(size_t n)
+    {
+        Vector<T> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(static_cast<T>(i % 97));
+        }
+        return v;
+    }
+
+    // Forces the requested kernels for the duration of one benchmark
+    struct ScopedIsa
+    {
+        explicit ScopedIsa(benchmark::State &state)
+        {
+            state.counters["isa"] = static_cast<double>(va::setIsa(static_cast<va::Isa>(state.range(1))));
+        }
+        ~ScopedIsa() { va::setIsa(va::detectIsa()); }
+    };
+
+    template <typename T>
+    void setItems(benchmark::State &state)
+    {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(T)));
+    }
+}
+
+template <typename T>
+static void BM_ReduceLoop(benchmark::State &state)
+{
+    const Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        T sum{};
+        for (const T &x : v)
+        {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_ReduceSimd(benchmark::State &state)
+{
+    ScopedIsa isa(state);
+    const Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(va::reduce(v));
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_FindLoop(benchmark::State &state)
+{
+    // Needle absent: the whole vector is scanned
+    const Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t index = 0;
+        for (auto it = v.begin(); it != v.end() && *it != T(1000); ++it)
+        {
+            ++index;
+        }
+        benchmark::DoNotOptimize(index);
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_FindSimd(benchmark::State &state)
+{
+    ScopedIsa isa(state);
+    const Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(va::find(v, T(1000)));
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_CountLoop(benchmark::State &state)
+{
+    const Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t c = 0;
+        for (const T &x : v)
+        {
+            c += x == T(5);
+        }
+        benchmark::DoNotOptimize(c);
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_CountSimd(benchmark::State &state)
+{
+    ScopedIsa isa(state);
+    const Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(va::count(v, T(5)));
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_MinLoop(benchmark::State &state)
+{
+    const Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        T m = v[0];
+        for (const T &x : v)
+        {
+            m = x < m ? x : m;
+        }
+        benchmark::DoNotOptimize(m);
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_MinSimd(benchmark::State &state)
+{
+    ScopedIsa isa(state);
+    const Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(va::min(v));
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_DotLoop(benchmark::State &state)
+{
+    const Vector<T> a = makeData<T>(static_cast<size_t>(state.range(0)));
+    const Vector<T> b = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        T sum{};
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            sum += a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_DotSimd(benchmark::State &state)
+{
+    ScopedIsa isa(state);
+    const Vector<T> a = makeData<T>(static_cast<size_t>(state.range(0)));
+    const Vector<T> b = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(va::dot(a, b));
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_ScaleLoop(benchmark::State &state)
+{
+    Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (T &x : v)
+        {
+            x *= T(1);
+        }
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+    setItems<T>(state);
+}
+
+template <typename T>
+static void BM_ScaleSimd(benchmark::State &state)
+{
+    ScopedIsa isa(state);
+    Vector<T> v = makeData<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        va::scale(v, T(1));
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+    setItems<T>(state);
+}
+
+// 1K (L1) to 10M (DRAM) elements
+#define VECTOR_BENCH_LOOP(bm, T) \
+    BENCHMARK_TEMPLATE(bm, T)->ArgsProduct({{1000, 100000, 10000000}, {0}})
+
+#define VECTOR_BENCH_SIMD(bm, T)                                                  \
+    BENCHMARK_TEMPLATE(bm, T)->ArgsProduct({{1000, 100000, 10000000},            \
+                                            {static_cast<int>(va::Isa::Scalar),  \
+                                             static_cast<int>(va::Isa::SSE2),    \
+                                             static_cast<int>(va::Isa::AVX2),    \
+                                             static_cast<int>(va::Isa::AVX512)}})
+
+#define VECTOR_BENCH_KERNEL(name, T)      \
+    VECTOR_BENCH_LOOP(BM_##name##Loop, T); \
+    VECTOR_BENCH_SIMD(BM_##name##Simd, T)
+
+#define VECTOR_BENCH_KERNEL_ALL_TYPES(name) \
+    VECTOR_BENCH_KERNEL(name, int32_t);     \
+    VECTOR_BENCH_KERNEL(name, float);       \
+    VECTOR_BENCH_KERNEL(name, double)
+
+VECTOR_BENCH_KERNEL_ALL_TYPES(Reduce);
+VECTOR_BENCH_KERNEL_ALL_TYPES(Find);
+VECTOR_BENCH_KERNEL_ALL_TYPES(Count);
+VECTOR_BENCH_KERNEL_ALL_TYPES(Min);
+VECTOR_BENCH_KERNEL_ALL_TYPES(Dot);
+VECTOR_BENCH_KERNEL_ALL_TYPES(Scale);
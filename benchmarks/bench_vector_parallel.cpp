@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include "vector.hpp"
+#include "vector_parallel.hpp"
+
+/*
+    Scaling of the parallel algorithms (vector_parallel.hpp) from one
+    thread to every hardware thread. Arg 0 is the element count, arg 1 the
+    pool size; a pool of 1 runs the same chunked code on the caller alone.
+    Wall-clock time is reported since the work runs on other threads.
+*/
+
+namespace
+{
+    Vector<int64_t> makeData(size_t n)
+    {
+        std::mt19937_64 rng(7);
+        Vector<int64_t> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(static_cast<int64_t>(rng() % 1000000));
+        }
+        return v;
+    }
+
+    void setItems(benchmark::State &state)
+    {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int64_t)));
+    }
+
+    // 1, 2, 4, ... up to and including the hardware thread count
+    void threadCounts(benchmark::internal::Benchmark *b, int64_t elements)
+    {
+        const int64_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (int64_t threads = 1; threads < hardware; threads *= 2)
+        {
+            b->Args({elements, threads});
+        }
+        b->Args({elements, hardware});
+    }
+}
+
+static void BM_ParallelForEach(benchmark::State &state)
+{
+    vector_parallel::ThreadPool pool(static_cast<size_t>(state.range(1)));
+    Vector<int64_t> v = makeData(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        vector_parallel::parallel_for_each(v, [](int64_t &x) { x = x * 3 + 1; }, vector_parallel::kAutoGrain, pool);
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+
+static void BM_ParallelReduce(benchmark::State &state)
+{
+    vector_parallel::ThreadPool pool(static_cast<size_t>(state.range(1)));
+    const Vector<int64_t> v = makeData(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(vector_parallel::parallel_reduce(v, vector_parallel::kAutoGrain, pool));
+    }
+    setItems(state);
+}
+
+static void BM_ParallelTransform(benchmark::State &state)
+{
+    vector_parallel::ThreadPool pool(static_cast<size_t>(state.range(1)));
+    const Vector<int64_t> in = makeData(static_cast<size_t>(state.range(0)));
+    Vector<int64_t> out;
+    out.resize(in.size());
+    for (auto _ : state)
+    {
+        vector_parallel::parallel_transform(in, out, [](int64_t x) { return x * x; }, vector_parallel::kAutoGrain,
+                                            pool);
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+
+static void BM_ParallelCopy(benchmark::State &state)
+{
+    vector_parallel::ThreadPool pool(static_cast<size_t>(state.range(1)));
+    const Vector<int64_t> in = makeData(static_cast<size_t>(state.range(0)));
+    Vector<int64_t> out;
+    out.resize(in.size());
+    for (auto _ : state)
+    {
+        vector_parallel::parallel_copy(in, out, vector_parallel::kAutoGrain, pool);
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+
+static void BM_ParallelSort(benchmark::State &state)
+{
+    vector_parallel::ThreadPool pool(static_cast<size_t>(state.range(1)));
+    const Vector<int64_t> source = makeData(static_cast<size_t>(state.range(0)));
+    Vector<int64_t> v;
+    v.resize(source.size());
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        vector_parallel::parallel_copy(source, v, vector_parallel::kAutoGrain, pool);
+        state.ResumeTiming();
+
+        vector_parallel::parallel_sort(v, std::less<>{}, vector_parallel::kAutoGrain, pool);
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+
+// Vector<std::string> copy constructor with ParallelConstructionScope
+static void BM_ParallelCopyConstruct(benchmark::State &state)
+{
+    vector_parallel::ThreadPool pool(static_cast<size_t>(state.range(1)));
+    Vector<std::string> table;
+    table.reserve(static_cast<size_t>(state.range(0)));
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        table.push_back(std::string(32, static_cast<char>('a' + i % 26)));
+    }
+
+    vector_parallel::ParallelConstructionScope scope(vector_parallel::kParallelConstructionThreshold, pool);
+    for (auto _ : state)
+    {
+        Vector<std::string> snapshot(table);
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ParallelForEach)->Apply([](auto *b) { threadCounts(b, 100000000); })->UseRealTime();
+BENCHMARK(BM_ParallelReduce)->Apply([](auto *b) { threadCounts(b, 100000000); })->UseRealTime();
+BENCHMARK(BM_ParallelTransform)->Apply([](auto *b) { threadCounts(b, 100000000); })->UseRealTime();
+BENCHMARK(BM_ParallelCopy)->Apply([](auto *b) { threadCounts(b, 100000000); })->UseRealTime();
+BENCHMARK(BM_ParallelSort)->Apply([](auto *b) { threadCounts(b, 10000000); })->UseRealTime();
+BENCHMARK(BM_ParallelCopyConstruct)->Apply([](auto *b) { threadCounts(b, 10000000); })->UseRealTime();
@@ -0,0 +1,267 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "aligned_allocator.hpp requires POSIX mmap"
+#endif
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+    Storage policies for Vector, as allocators.
+
+        AlignedVector<float, 64> samples;                     // data() % 64 == 0
+        Vector<Row, HugePageAllocator<Row>> table;            // THP-backed when large
+        Vector<Tick, HugePageAllocator<Tick, HugePages::Explicit, true>> ring;
+        ring.reserve(n);                                      // faulted in here, not on first write
+
+    AlignedAllocator guarantees an Alignment-byte aligned data() (a cache
+    line by default, 128 for adjacent-line prefetch pairs) so AVX-512 loads
+    never split across lines.
+
+    HugePageAllocator serves blocks of at least kHugePageSize from their own
+    anonymous mapping, rounded up and aligned to a 2 MiB boundary:
+      - HugePages::Transparent asks for transparent hugepages with
+        madvise(MADV_HUGEPAGE); the kernel backs the block with 2 MiB pages
+        when it can, cutting TLB misses by up to 512x.
+      - HugePages::Explicit takes pages from the reserved hugetlbfs pool
+        (MAP_HUGETLB) and falls back to Transparent when the pool is empty.
+      - HugePages::None maps regular pages (for prefaulting only).
+    With Prefault, every mapped block is populated at allocation, i.e. by
+    reserve() or a growing push_back, so later writes take no page faults.
+    Smaller blocks come from the aligned operator new. Where the kernel
+    lacks a feature the allocator silently uses the next one down.
+*/
+
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator
+{
+    static_assert(std::has_single_bit(Alignment), "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "Alignment must not be below alignof(T)");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, std::max(Alignment, alignof(U))>;
+    };
+
+    static constexpr size_t kAlignment = Alignment;
+
+    /*
+        Constructors
+    */
+    AlignedAllocator() noexcept = default;
+
+    template <typename U, size_t OtherAlignment>
+    AlignedAllocator(const AlignedAllocator<U, OtherAlignment> &) noexcept
+    {
+    }
+
+    [[nodiscard]] T *allocate(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T *p, size_t n) noexcept
+    {
+        ::operator delete(p, n * sizeof(T), std::align_val_t(Alignment));
+    }
+
+    // Blocks go back to operator delete with the same alignment they were
+    // allocated with, so only equal alignments can free each other's
+    template <typename U, size_t OtherAlignment>
+    bool operator==(const AlignedAllocator<U, OtherAlignment> &) const noexcept
+    {
+        return Alignment == OtherAlignment;
+    }
+};
+
+template <typename T, size_t Alignment = 64>
+using AlignedVector = Vector<T, AlignedAllocator<T, Alignment>>;
+
+enum class HugePages
+{
+    None,        // regular pages
+    Transparent, // madvise(MADV_HUGEPAGE)
+    Explicit     // MAP_HUGETLB, Transparent if the pool is empty
+};
+
+namespace page_detail
+{
+    inline constexpr size_t kHugePageSize = size_t(2) << 20;
+
+    inline size_t pageSize() noexcept
+    {
+        static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    // Anonymous mapping of length bytes starting on an alignment boundary:
+    // maps the slack too, then trims both ends
+    inline void *mapAligned(size_t length, size_t alignment)
+    {
+        const size_t padded = length + alignment;
+        void *raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (begin + alignment - 1) / alignment * alignment;
+        if (aligned > begin)
+        {
+            ::munmap(raw, aligned - begin);
+        }
+        const size_t tail = begin + padded - (aligned + length);
+        if (tail > 0)
+        {
+            ::munmap(reinterpret_cast<void *>(aligned + length), tail);
+        }
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // Faults every page in now. Fresh anonymous memory reads as zero, so
+    // writing zero changes nothing but residency
+    inline void prefault(void *p, size_t length) noexcept
+    {
+#ifdef MADV_POPULATE_WRITE
+        if (::madvise(p, length, MADV_POPULATE_WRITE) == 0)
+        {
+            return;
+        }
+#endif
+        volatile std::byte *bytes = static_cast<std::byte *>(p);
+        for (size_t offset = 0; offset < length; offset += pageSize())
+        {
+            bytes[offset] = std::byte{0};
+        }
+    }
+
+    inline void *mapPages(size_t length, HugePages mode, bool populate)
+    {
+#if defined(MAP_HUGETLB)
+        if (mode == HugePages::Explicit)
+        {
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_2MB
+            flags |= MAP_HUGE_2MB;
+#endif
+#ifdef MAP_POPULATE
+            if (populate)
+            {
+                flags |= MAP_POPULATE;
+            }
+#endif
+            void *p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                return p;
+            }
+        }
+#endif
+
+        void *p = mapAligned(length, mode == HugePages::None ? pageSize() : kHugePageSize);
+#ifdef MADV_HUGEPAGE
+        if (mode != HugePages::None)
+        {
+            ::madvise(p, length, MADV_HUGEPAGE);
+        }
+#endif
+        if (populate)
+        {
+            prefault(p, length);
+        }
+        return p;
+    }
+}
+
+template <typename T, HugePages Mode = HugePages::Transparent, bool Prefault = false>
+class HugePageAllocator
+{
+    static constexpr size_t kSmallAlignment = std::max<size_t>(64, alignof(T));
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = HugePageAllocator<U, Mode, Prefault>;
+    };
+
+    static constexpr size_t kHugePageSize = page_detail::kHugePageSize;
+    static constexpr HugePages kMode = Mode;
+    static constexpr bool kPrefault = Prefault;
+
+    /*
+        Constructors
+    */
+    HugePageAllocator() noexcept = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U, Mode, Prefault> &) noexcept
+    {
+    }
+
+    [[nodiscard]] T *allocate(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T) - kHugePageSize)
+        {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        if (!isMapped(bytes))
+        {
+            return static_cast<T *>(::operator new(bytes, std::align_val_t(kSmallAlignment)));
+        }
+        return static_cast<T *>(page_detail::mapPages(mappedLength(bytes), Mode, Prefault));
+    }
+
+    void deallocate(T *p, size_t n) noexcept
+    {
+        const size_t bytes = n * sizeof(T);
+        if (isMapped(bytes))
+        {
+            ::munmap(p, mappedLength(bytes));
+        }
+        else
+        {
+            ::operator delete(p, bytes, std::align_val_t(kSmallAlignment));
+        }
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U, Mode, Prefault> &) const noexcept
+    {
+        return true;
+    }
+
+private:
+    static bool isMapped(size_t bytes) noexcept { return bytes >= kHugePageSize; }
+
+    // Whole hugepages, so hugetlb mappings can be unmapped with the same length
+    static size_t mappedLength(size_t bytes) noexcept
+    {
+        return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    }
+};
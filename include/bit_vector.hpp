@@ -0,0 +1,769 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+// Private to this header, undefined at its end
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BIT_VECTOR_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+    Bit-packed vector of flags, 64 per word.
+
+        BitVector seen(n);
+        seen[i] = true;                    // proxy reference
+        seen &= allowed;                   // one AND per word
+        size_t hits = seen.count();        // hardware popcount
+
+        RankSelect index(seen);            // optional, ~25% extra memory
+        index.rank1(i);                    // ones before position i, O(1)
+        index.select1(k);                  // position of the k-th one
+
+    Bits past size() in the last word are always zero, so count(),
+    comparisons and the bulk operations work on whole words without
+    masking. push_back and resize touch one word per 64 bits, and
+    append_bits() adds up to 64 bits with one or two word writes.
+
+    count() picks a kernel at runtime: AVX-512 VPOPCNTQ (8 words per
+    instruction), then the POPCNT instruction, then a portable SWAR sum.
+    Single-word counts (rank, select) use POPCNT when the build enables it
+    (-mpopcnt, -march=...) and the inlined SWAR sum otherwise, never the
+    libgcc call std::popcount becomes without it.
+
+    RankSelect is built from a BitVector in one pass and reads its words
+    in place: it is valid until the BitVector is modified or destroyed.
+    Vector<bool> stays a plain vector of one-byte bools; BitVector is the
+    packed alternative and, like std::vector<bool>, hands out proxies.
+*/
+
+namespace bit_detail
+{
+    constexpr size_t kWordBits = 64;
+
+    constexpr size_t wordsFor(size_t bits) noexcept { return (bits + kWordBits - 1) / kWordBits; }
+
+    // The low `bits` bits set, bits < 64
+    constexpr uint64_t lowMask(size_t bits) noexcept { return (uint64_t(1) << bits) - 1; }
+
+    constexpr uint64_t kOnes8 = 0x0101010101010101ull;
+
+    // Ones in each byte of w, as bytes
+    constexpr uint64_t byteCounts(uint64_t w) noexcept
+    {
+        w = w - ((w >> 1) & 0x5555555555555555ull);
+        w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+        return (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    }
+
+    constexpr unsigned popcount(uint64_t w) noexcept
+    {
+#ifdef __POPCNT__
+        return static_cast<unsigned>(std::popcount(w));
+#else
+        return static_cast<unsigned>((byteCounts(w) * kOnes8) >> 56);
+#endif
+    }
+
+    // kSelectInByte[byte * 8 + k]: position of the k-th set bit of byte
+    inline constexpr auto kSelectInByte = []
+    {
+        std::array<uint8_t, 256 * 8> table{};
+        for (unsigned byte = 0; byte < 256; ++byte)
+        {
+            unsigned k = 0;
+            for (unsigned bit = 0; bit < 8; ++bit)
+            {
+                if ((byte >> bit) & 1)
+                {
+                    table[byte * 8 + k++] = static_cast<uint8_t>(bit);
+                }
+            }
+        }
+        return table;
+    }();
+
+    // Position of the k-th (from 0) set bit of w, k < popcount(w)
+    inline unsigned selectInWord(uint64_t w, unsigned k) noexcept
+    {
+#ifdef __BMI2__
+        return static_cast<unsigned>(std::countr_zero(_pdep_u64(uint64_t(1) << k, w)));
+#else
+        // Byte i of prefix holds the ones in bytes 0..i (at most 64, so the
+        // high bit of every byte is free): the target byte is the first
+        // whose prefix exceeds k, found with one subtraction for all bytes
+        const uint64_t prefix = byteCounts(w) * kOnes8;
+        const uint64_t above = ((prefix | (kOnes8 << 7)) - (k + 1) * kOnes8) & (kOnes8 << 7);
+        const unsigned shift = static_cast<unsigned>(std::countr_zero(above)) & ~7u;
+        k -= static_cast<unsigned>(((prefix << 8) >> shift) & 0xFF);
+        return shift + kSelectInByte[((w >> shift) & 0xFF) * 8 + k];
+#endif
+    }
+
+    /*
+        Bulk popcount kernels
+    */
+    inline size_t countPortable(const uint64_t *words, size_t n) noexcept
+    {
+        size_t sum = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            sum += popcount(words[i]);
+        }
+        return sum;
+    }
+
+#ifdef BIT_VECTOR_X86
+    [[gnu::target("popcnt")]] inline size_t countPopcnt(const uint64_t *words, size_t n) noexcept
+    {
+        // Four sums so consecutive popcnts do not wait on one add chain
+        size_t a = 0, b = 0, c = 0, d = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            a += static_cast<size_t>(__builtin_popcountll(words[i]));
+            b += static_cast<size_t>(__builtin_popcountll(words[i + 1]));
+            c += static_cast<size_t>(__builtin_popcountll(words[i + 2]));
+            d += static_cast<size_t>(__builtin_popcountll(words[i + 3]));
+        }
+        for (; i < n; ++i)
+        {
+            a += static_cast<size_t>(__builtin_popcountll(words[i]));
+        }
+        return a + b + c + d;
+    }
+
+    [[gnu::target("avx512f,avx512vpopcntdq")]] inline size_t countAvx512(const uint64_t *words, size_t n) noexcept
+    {
+        __m512i sum = _mm512_setzero_si512();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+        }
+        // Tail of up to 7 words as one masked load
+        const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(tail, words + i)));
+        alignas(64) uint64_t lanes[8];
+        _mm512_store_si512(lanes, sum);
+        return static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7]);
+    }
+#endif
+
+    using CountKernel = size_t (*)(const uint64_t *, size_t) noexcept;
+
+    inline CountKernel pickCountKernel() noexcept
+    {
+#ifdef BIT_VECTOR_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"))
+        {
+            return &countAvx512;
+        }
+        if (__builtin_cpu_supports("popcnt"))
+        {
+            return &countPopcnt;
+        }
+#endif
+        return &countPortable;
+    }
+
+    // Set bits in words[0, n), with the best kernel of the running CPU
+    inline size_t countOnes(const uint64_t *words, size_t n) noexcept
+    {
+        static const CountKernel kernel = pickCountKernel();
+        return kernel(words, n);
+    }
+}
+
+template <typename Allocator = VectorDefaultAllocator<uint64_t>>
+class BasicBitVector
+{
+public:
+    using word_type = uint64_t;
+    using value_type = bool;
+    using const_reference = bool;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr size_t kWordBits = bit_detail::kWordBits;
+
+    // Proxy for one bit: the word it lives in and its mask
+    class reference
+    {
+    public:
+        reference(const reference &) noexcept = default;
+
+        operator bool() const noexcept { return (*m_word & m_mask) != 0; }
+        bool operator~() const noexcept { return !static_cast<bool>(*this); }
+
+        // Assignment writes through, also on a const proxy (as
+        // std::vector<bool>::reference does since C++23), so the iterator
+        // is writable for the ranges algorithms
+        const reference &operator=(bool value) const noexcept
+        {
+            *m_word = (*m_word & ~m_mask) | ((word_type(0) - word_type(value)) & m_mask);
+            return *this;
+        }
+        reference &operator=(bool value) noexcept
+        {
+            std::as_const(*this) = value;
+            return *this;
+        }
+        reference &operator=(const reference &other) noexcept { return *this = static_cast<bool>(other); }
+
+        void flip() const noexcept { *m_word ^= m_mask; }
+
+        friend void swap(reference a, reference b) noexcept
+        {
+            const bool tmp = a;
+            a = static_cast<bool>(b);
+            b = tmp;
+        }
+
+    private:
+        friend class BasicBitVector;
+
+        reference(word_type *word, word_type mask) noexcept : m_word(word), m_mask(mask) {}
+
+        word_type *m_word;
+        word_type m_mask;
+    };
+
+    // Random access over bits with proxy references
+    template <bool IsConst>
+    class IteratorImpl
+    {
+    public:
+        // Proxy references are not real references, so only the C++20
+        // concept claims random access
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, bool, BasicBitVector::reference>;
+        using word_pointer = std::conditional_t<IsConst, const word_type *, word_type *>;
+
+        IteratorImpl() noexcept : m_words(nullptr), m_index(0) {}
+        IteratorImpl(word_pointer words, size_t index) noexcept : m_words(words), m_index(index) {}
+
+        template <bool Other>
+            requires(!Other && IsConst)
+        IteratorImpl(const IteratorImpl<Other> &other) noexcept : m_words(other.m_words), m_index(other.m_index)
+        {
+        }
+
+        template <bool>
+        friend class IteratorImpl;
+
+        reference operator*() const noexcept { return at(m_index); }
+        reference operator[](difference_type n) const noexcept { return at(m_index + n); }
+
+        // Bit position in the vector
+        size_t index() const noexcept { return m_index; }
+
+        IteratorImpl &operator++() noexcept
+        {
+            ++m_index;
+            return *this;
+        }
+        IteratorImpl operator++(int) noexcept
+        {
+            IteratorImpl it = *this;
+            ++m_index;
+            return it;
+        }
+        IteratorImpl &operator--() noexcept
+        {
+            --m_index;
+            return *this;
+        }
+        IteratorImpl operator--(int) noexcept
+        {
+            IteratorImpl it = *this;
+            --m_index;
+            return it;
+        }
+        IteratorImpl &operator+=(difference_type n) noexcept
+        {
+            m_index += n;
+            return *this;
+        }
+        IteratorImpl &operator-=(difference_type n) noexcept
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        friend IteratorImpl operator+(IteratorImpl it, difference_type n) noexcept { return it += n; }
+        friend IteratorImpl operator+(difference_type n, IteratorImpl it) noexcept { return it += n; }
+        friend IteratorImpl operator-(IteratorImpl it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const IteratorImpl &lhs, const IteratorImpl &rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        template <bool R>
+        bool operator==(const IteratorImpl<R> &other) const noexcept { return m_index == other.m_index; }
+        template <bool R>
+        auto operator<=>(const IteratorImpl<R> &other) const noexcept { return m_index <=> other.m_index; }
+
+    private:
+        reference at(size_t i) const noexcept
+        {
+            if constexpr (IsConst)
+            {
+                return (m_words[i / kWordBits] >> (i % kWordBits)) & 1;
+            }
+            else
+            {
+                return reference(m_words + i / kWordBits, word_type(1) << (i % kWordBits));
+            }
+        }
+
+        word_pointer m_words;
+        size_t m_index;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+
+    /* Constructors */
+    BasicBitVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+    explicit BasicBitVector(const Allocator &alloc) noexcept : m_words(alloc) {}
+
+    explicit BasicBitVector(size_t count, bool value = false, const Allocator &alloc = Allocator())
+        : m_words(alloc)
+    {
+        resize(count, value);
+    }
+
+    BasicBitVector(std::initializer_list<bool> bits, const Allocator &alloc = Allocator()) : m_words(alloc)
+    {
+        reserve(bits.size());
+        for (const bool bit : bits)
+        {
+            push_back(bit);
+        }
+    }
+
+    BasicBitVector(const BasicBitVector &) = default;
+    BasicBitVector &operator=(const BasicBitVector &) = default;
+
+    BasicBitVector(BasicBitVector &&other) noexcept
+        : m_words(std::move(other.m_words)), m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    BasicBitVector &operator=(BasicBitVector &&other) noexcept(noexcept(m_words = std::move(other.m_words)))
+    {
+        if (this != &other)
+        {
+            m_words = std::move(other.m_words);
+            // Unequal allocators move word by word and leave other's
+            // words in place; an empty other keeps no bits past size()
+            other.m_words.clear();
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    void swap(BasicBitVector &other) noexcept
+    {
+        m_words.swap(other.m_words);
+        std::swap(m_size, other.m_size);
+    }
+
+    friend void swap(BasicBitVector &lhs, BasicBitVector &rhs) noexcept { lhs.swap(rhs); }
+
+    /* Element access */
+    reference operator[](size_t index) noexcept
+    {
+        return reference(m_words.data() + index / kWordBits, word_type(1) << (index % kWordBits));
+    }
+
+    bool operator[](size_t index) const noexcept { return test(index); }
+
+    bool test(size_t index) const noexcept { return (m_words[index / kWordBits] >> (index % kWordBits)) & 1; }
+
+    reference at(size_t index)
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("BitVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    bool at(size_t index) const
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("BitVector index out of range");
+        }
+        return test(index);
+    }
+
+    void set(size_t index, bool value = true) noexcept { (*this)[index] = value; }
+    void reset(size_t index) noexcept { m_words[index / kWordBits] &= ~(word_type(1) << (index % kWordBits)); }
+    void flip(size_t index) noexcept { m_words[index / kWordBits] ^= word_type(1) << (index % kWordBits); }
+
+    // The packed bits, bit i at words()[i / 64] >> (i % 64). Bits past
+    // size() are zero
+    std::span<const word_type> words() const noexcept { return {m_words.data(), m_words.size()}; }
+
+    /* Modifiers */
+    void push_back(bool value)
+    {
+        const size_t offset = m_size % kWordBits;
+        if (offset == 0)
+        {
+            m_words.push_back(word_type(value));
+        }
+        else
+        {
+            m_words[m_size / kWordBits] |= word_type(value) << offset;
+        }
+        ++m_size;
+    }
+
+    // Appends the low `count` bits of `bits` (count <= 64), low bit first:
+    // at most one word write and one word push
+    void append_bits(word_type bits, size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (count < kWordBits)
+        {
+            bits &= bit_detail::lowMask(count);
+        }
+        const size_t offset = m_size % kWordBits;
+        if (offset == 0)
+        {
+            m_words.push_back(bits);
+        }
+        else
+        {
+            m_words[m_size / kWordBits] |= bits << offset;
+            if (offset + count > kWordBits)
+            {
+                m_words.push_back(bits >> (kWordBits - offset));
+            }
+        }
+        m_size += count;
+    }
+
+    void pop_back()
+    {
+        if (m_size == 0)
+        {
+            throw std::out_of_range("pop_back() called on empty BitVector");
+        }
+        resize(m_size - 1);
+    }
+
+    // New bits are filled a word at a time
+    void resize(size_t count, bool value = false)
+    {
+        if (count > m_size && value && m_size % kWordBits != 0)
+        {
+            m_words[m_size / kWordBits] |= ~bit_detail::lowMask(m_size % kWordBits);
+        }
+        m_words.resize(bit_detail::wordsFor(count), value ? ~word_type(0) : word_type(0));
+        m_size = count;
+        clearTail();
+    }
+
+    void clear() noexcept
+    {
+        m_words.clear();
+        m_size = 0;
+    }
+
+    void reserve(size_t bits) { m_words.reserve(bit_detail::wordsFor(bits)); }
+    void shrink_to_fit() { m_words.shrink_to_fit(); }
+
+    // Whole vector
+    void set() noexcept { fill(~word_type(0)); }
+    void reset() noexcept { fill(0); }
+    void flip() noexcept
+    {
+        for (word_type &word : m_words)
+        {
+            word = ~word;
+        }
+        clearTail();
+    }
+
+    /* Bulk operations */
+    // One instruction per word. Both sides must have the same size,
+    // otherwise std::invalid_argument is thrown
+    BasicBitVector &operator&=(const BasicBitVector &other)
+    {
+        return combine(other, [](word_type a, word_type b) { return a & b; });
+    }
+    BasicBitVector &operator|=(const BasicBitVector &other)
+    {
+        return combine(other, [](word_type a, word_type b) { return a | b; });
+    }
+    BasicBitVector &operator^=(const BasicBitVector &other)
+    {
+        return combine(other, [](word_type a, word_type b) { return a ^ b; });
+    }
+
+    BasicBitVector operator~() const
+    {
+        BasicBitVector result(*this);
+        result.flip();
+        return result;
+    }
+
+    friend BasicBitVector operator&(BasicBitVector lhs, const BasicBitVector &rhs) { return lhs &= rhs; }
+    friend BasicBitVector operator|(BasicBitVector lhs, const BasicBitVector &rhs) { return lhs |= rhs; }
+    friend BasicBitVector operator^(BasicBitVector lhs, const BasicBitVector &rhs) { return lhs ^= rhs; }
+
+    /* Queries */
+    size_t count() const noexcept { return bit_detail::countOnes(m_words.data(), m_words.size()); }
+
+    bool any() const noexcept
+    {
+        return std::any_of(m_words.begin(), m_words.end(), [](word_type word) { return word != 0; });
+    }
+    bool none() const noexcept { return !any(); }
+    bool all() const noexcept { return count() == m_size; }
+
+    friend bool operator==(const BasicBitVector &lhs, const BasicBitVector &rhs) noexcept
+    {
+        return lhs.m_size == rhs.m_size && std::equal(lhs.m_words.begin(), lhs.m_words.end(), rhs.m_words.begin());
+    }
+
+    size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+    size_t capacity() const noexcept { return m_words.capacity() * kWordBits; }
+    allocator_type get_allocator() const { return m_words.get_allocator(); }
+
+    iterator begin() noexcept { return iterator(m_words.data(), 0); }
+    iterator end() noexcept { return iterator(m_words.data(), m_size); }
+    const_iterator begin() const noexcept { return const_iterator(m_words.data(), 0); }
+    const_iterator end() const noexcept { return const_iterator(m_words.data(), m_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    // Restores the invariant that bits past m_size are zero
+    void clearTail() noexcept
+    {
+        if (m_size % kWordBits != 0)
+        {
+            m_words[m_size / kWordBits] &= bit_detail::lowMask(m_size % kWordBits);
+        }
+    }
+
+    void fill(word_type word) noexcept
+    {
+        std::fill(m_words.begin(), m_words.end(), word);
+        clearTail();
+    }
+
+    template <typename Op>
+    BasicBitVector &combine(const BasicBitVector &other, Op op)
+    {
+        if (other.m_size != m_size)
+        {
+            throw std::invalid_argument("BitVector: operands differ in size");
+        }
+        word_type *dst = m_words.data();
+        const word_type *src = other.m_words.data();
+        for (size_t i = 0, n = m_words.size(); i < n; ++i)
+        {
+            dst[i] = op(dst[i], src[i]);
+        }
+        return *this;
+    }
+
+    Vector<word_type, Allocator> m_words;
+    size_t m_size = 0;
+};
+
+using BitVector = BasicBitVector<>;
+
+/*
+    Succinct rank/select index over a BitVector.
+
+    Layout of Vigna's rank9: for every block of 512 bits (8 words), one
+    word holds the number of ones before the block and a second packs the
+    ones in words 0..j-1 of the block for j = 1..7, 9 bits each. rank1 is
+    then two adjacent loads and one popcount. select1/select0 also record
+    the block of every 512th one (zero), binary-search the few blocks
+    between two samples, pick the word from the packed counts and finish
+    inside the word. Extra memory: 25% of the bits plus the samples.
+*/
+class RankSelect
+{
+public:
+    /* Constructors */
+    RankSelect() = default;
+
+    template <typename Allocator>
+    explicit RankSelect(const BasicBitVector<Allocator> &bits) : RankSelect(bits.words(), bits.size())
+    {
+    }
+
+    // Bits as packed by BitVector: bit i at words[i / 64] >> (i % 64), bits
+    // past `size` zero
+    RankSelect(std::span<const uint64_t> words, size_t size) : m_words(words), m_size(size)
+    {
+        const size_t blocks = (words.size() + kBlockWords - 1) / kBlockWords;
+        m_counts.reserve(2 * blocks);
+        for (size_t block = 0; block < blocks; ++block)
+        {
+            uint64_t packed = 0;
+            size_t inBlock = 0;
+            for (size_t j = 0; j < kBlockWords; ++j)
+            {
+                if (j > 0)
+                {
+                    packed |= uint64_t(inBlock) << (9 * (j - 1));
+                }
+                const size_t word = block * kBlockWords + j;
+                inBlock += word < words.size() ? bit_detail::popcount(words[word]) : 0;
+            }
+            m_counts.push_back(m_ones);
+            m_counts.push_back(packed);
+
+            // Blocks holding the next samples
+            for (; m_samples1.size() * kSampleRate < m_ones + inBlock; m_samples1.push_back(block))
+            {
+            }
+            const size_t zerosBefore = block * kBlockBits - m_ones;
+            for (; m_samples0.size() * kSampleRate < zerosBefore + kBlockBits - inBlock; m_samples0.push_back(block))
+            {
+            }
+            m_ones += inBlock;
+        }
+        // Upper bounds of the search after the last sample
+        m_samples1.push_back(blocks == 0 ? 0 : blocks - 1);
+        m_samples0.push_back(blocks == 0 ? 0 : blocks - 1);
+    }
+
+    size_t size() const noexcept { return m_size; }
+    size_t ones() const noexcept { return m_ones; }
+    size_t zeros() const noexcept { return m_size - m_ones; }
+
+    // Ones in positions [0, i), i <= size()
+    size_t rank1(size_t i) const noexcept
+    {
+        if (i >= m_size)
+        {
+            return m_ones;
+        }
+        const size_t word = i / bit_detail::kWordBits;
+        const uint64_t *counts = m_counts.data() + 2 * (word / kBlockWords);
+        return counts[0] + relative(counts[1], word % kBlockWords) +
+               bit_detail::popcount(m_words[word] & bit_detail::lowMask(i % bit_detail::kWordBits));
+    }
+
+    size_t rank0(size_t i) const noexcept { return std::min(i, m_size) - rank1(i); }
+
+    // Position of the k-th one (from 0), size() if k >= ones()
+    size_t select1(size_t k) const noexcept { return select<true>(k); }
+
+    // Position of the k-th zero (from 0), size() if k >= zeros()
+    size_t select0(size_t k) const noexcept { return select<false>(k); }
+
+private:
+    static constexpr size_t kBlockWords = 8;
+    static constexpr size_t kBlockBits = kBlockWords * bit_detail::kWordBits;
+    static constexpr size_t kSampleRate = 512;
+
+    // Ones in words 0..j-1 of a block. For j = 0, t wraps to all ones and
+    // the shift becomes 63, reading the always-zero top bit: no branch
+    static size_t relative(uint64_t packed, size_t j) noexcept
+    {
+        const uint64_t t = uint64_t(j) - 1;
+        return static_cast<size_t>((packed >> ((t + (t >> 60 & 8)) * 9)) & 0x1FF);
+    }
+
+    // Ones (zeros) in words 0..j-1 of a block
+    template <bool One>
+    static size_t inWords(uint64_t packed, size_t j) noexcept
+    {
+        const size_t ones = relative(packed, j);
+        return One ? ones : j * bit_detail::kWordBits - ones;
+    }
+
+    template <bool One>
+    size_t before(size_t block) const noexcept
+    {
+        const size_t ones = static_cast<size_t>(m_counts[2 * block]);
+        return One ? ones : block * kBlockBits - ones;
+    }
+
+    template <bool One>
+    size_t select(size_t k) const noexcept
+    {
+        if (k >= (One ? ones() : zeros()))
+        {
+            return m_size;
+        }
+        const Vector<size_t> &samples = One ? m_samples1 : m_samples0;
+
+        // Last block with at most k ones (zeros) before it
+        size_t lo = samples[k / kSampleRate];
+        size_t hi = samples[k / kSampleRate + 1];
+        while (lo < hi)
+        {
+            const size_t mid = lo + (hi - lo + 1) / 2;
+            if (before<One>(mid) <= k)
+            {
+                lo = mid;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        k -= before<One>(lo);
+
+        // Word within the block: the number of words 1..7 with at most k
+        // ones (zeros) before them, counted without branches
+        const uint64_t packed = m_counts[2 * lo + 1];
+        size_t j = 0;
+        for (size_t w = 1; w < kBlockWords; ++w)
+        {
+            j += inWords<One>(packed, w) <= k;
+        }
+        k -= inWords<One>(packed, j);
+
+        const size_t word = lo * kBlockWords + j;
+        const uint64_t bits = One ? m_words[word] : ~m_words[word];
+        return word * bit_detail::kWordBits + bit_detail::selectInWord(bits, static_cast<unsigned>(k));
+    }
+
+    std::span<const uint64_t> m_words;
+    size_t m_size = 0;
+    size_t m_ones = 0;
+    // Per block: ones before it, packed in-block counts
+    Vector<uint64_t> m_counts;
+    // Block of every kSampleRate-th one / zero, then the last block
+    Vector<size_t> m_samples1;
+    Vector<size_t> m_samples0;
+};
+
+#undef BIT_VECTOR_X86
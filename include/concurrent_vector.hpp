@@ -0,0 +1,408 @@
+#pragma once
+
+#include "segmented_vector.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+
+/*
+    Append-only vector that many threads can grow at once.
+
+        ConcurrentVector<Result> results;
+        // on any thread, no lock:
+        size_t i = results.push_back(compute(job));
+        // once the writers are joined:
+        Vector<Result> flat = std::move(results).to_vector();
+
+    Elements live in segments of power-of-two size: segment k holds
+    kFirstSegmentSize << k elements. A writer claims its slots with a single
+    fetch_add on the size, installs a missing segment with a compare-and-swap
+    (the loser of a race frees its copy) and constructs in place. Segments
+    never move, so references and indices stay valid for the lifetime of the
+    container, and an indexed read is two loads and no loop (wait-free).
+
+    size() counts claimed slots, including ones still being constructed.
+    An element may be read once the push_back that made it has returned and
+    that fact has reached the reader (a join, a queue, an atomic flag) or
+    once ready(i) is true. If a constructor throws, its slot stays empty:
+    ready() reports it, at() throws, destruction and to_vector() skip it.
+
+    clear(), to_vector() and destruction need the writers to be done.
+    capacity() counts the leading segments that are installed.
+*/
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentVector
+{
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+
+    static constexpr size_t kFirstSegmentShift = 5;
+
+private:
+    using Index = segmented_detail::SegmentIndex<kFirstSegmentShift>;
+
+public:
+    static constexpr size_t kFirstSegmentSize = Index::kFirstSize;
+    static constexpr size_t kMaxSegments = Index::kMaxSegments;
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using Flag = std::atomic<uint8_t>;
+
+    // Per-slot construction state, stored after the elements of a segment
+    static constexpr uint8_t kEmpty = 0;
+    static constexpr uint8_t kReady = 1;
+    static constexpr uint8_t kFailed = 2;
+
+    Allocator m_alloc;
+    std::atomic<size_t> m_size;
+    std::atomic<size_t> m_failed;
+    std::atomic<T *> m_segments[kMaxSegments];
+
+public:
+    /*
+        Constructors
+    */
+    ConcurrentVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+        : ConcurrentVector(Allocator())
+    {
+    }
+
+    explicit ConcurrentVector(const Allocator &alloc) noexcept
+        : m_alloc(alloc), m_size(0), m_failed(0), m_segments{}
+    {
+    }
+
+    // Shared between threads by reference; copying or moving it while
+    // writers run cannot be made safe
+    ConcurrentVector(const ConcurrentVector &) = delete;
+    ConcurrentVector &operator=(const ConcurrentVector &) = delete;
+
+    ~ConcurrentVector()
+    {
+        release();
+    }
+
+    /*
+        Concurrent modifiers
+    */
+    // Returns the index of the new element
+    size_t push_back(const T &element)
+    {
+        return emplace_back(element);
+    }
+
+    size_t push_back(T &&element)
+    {
+        return emplace_back(std::move(element));
+    }
+
+    template <typename... Args>
+    size_t emplace_back(Args &&...args)
+    {
+        const size_t index = m_size.fetch_add(1, std::memory_order_relaxed);
+        constructAt(index, std::forward<Args>(args)...);
+        return index;
+    }
+
+    // Appends count value-initialized elements (or copies of value) in
+    // consecutive slots and returns the index of the first
+    size_t grow_by(size_t count)
+    {
+        return growBy(count, [this](T *slot) { alloc_traits::construct(m_alloc, slot); });
+    }
+
+    size_t grow_by(size_t count, const T &value)
+    {
+        return growBy(count, [this, &value](T *slot) { alloc_traits::construct(m_alloc, slot, value); });
+    }
+
+    // Allocates segments up front so pushes below capacity never allocate
+    void reserve(size_t capacity)
+    {
+        for (size_t segment = 0; capacity > 0 && segment < kMaxSegments && segmentBase(segment) < capacity; ++segment)
+        {
+            ensureSegment(segment);
+        }
+    }
+
+    /*
+        Element access (wait-free)
+    */
+    T &operator[](size_t index) noexcept
+    {
+        return *slot(index);
+    }
+
+    const T &operator[](size_t index) const noexcept
+    {
+        return *slot(index);
+    }
+
+    T &at(size_t index)
+    {
+        checkReady(index);
+        return *slot(index);
+    }
+
+    const T &at(size_t index) const
+    {
+        checkReady(index);
+        return *slot(index);
+    }
+
+    // Whether element index has been fully constructed
+    [[nodiscard]] bool ready(size_t index) const noexcept
+    {
+        if (index >= size())
+        {
+            return false;
+        }
+        const auto [segment, offset] = locate(index);
+        const T *elements = m_segments[segment].load(std::memory_order_acquire);
+        return elements != nullptr && flags(elements, segment)[offset].load(std::memory_order_acquire) == kReady;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size.load(std::memory_order_acquire); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        size_t segment = 0;
+        while (segment < kMaxSegments && m_segments[segment].load(std::memory_order_acquire) != nullptr)
+        {
+            ++segment;
+        }
+        return segmentBase(segment);
+    }
+
+    allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    /*
+        Quiescent operations (no concurrent writers)
+    */
+    // Destroys all elements and frees the segments
+    void clear() noexcept
+    {
+        release();
+        m_size.store(0, std::memory_order_relaxed);
+        m_failed.store(0, std::memory_order_relaxed);
+    }
+
+    // Copies the elements into one contiguous Vector, skipping empty slots
+    template <typename VectorAllocator = VectorDefaultAllocator<T>>
+    Vector<T, VectorAllocator> to_vector() const &
+    {
+        Vector<T, VectorAllocator> out;
+        compactInto(out, [](const T *first, const T *last) { return std::ranges::subrange(first, last); });
+        return out;
+    }
+
+    // Moves the elements out; the container is left empty
+    template <typename VectorAllocator = VectorDefaultAllocator<T>>
+    Vector<T, VectorAllocator> to_vector() &&
+    {
+        Vector<T, VectorAllocator> out;
+        compactInto(out, [](T *first, T *last) {
+            return std::ranges::subrange(std::make_move_iterator(first), std::make_move_iterator(last));
+        });
+        clear();
+        return out;
+    }
+
+private:
+    using Location = typename Index::Location;
+
+    static constexpr size_t segmentSize(size_t segment) noexcept { return Index::size(segment); }
+    static constexpr size_t segmentBase(size_t segment) noexcept { return Index::base(segment); }
+    static constexpr Location locate(size_t index) noexcept { return Index::locate(index); }
+
+    // Flags follow the elements, rounded up to whole T slots
+    static constexpr size_t flagSlots(size_t segment) noexcept
+    {
+        return (segmentSize(segment) * sizeof(Flag) + sizeof(T) - 1) / sizeof(T);
+    }
+
+    static Flag *flags(const T *elements, size_t segment) noexcept
+    {
+        return reinterpret_cast<Flag *>(const_cast<T *>(elements) + segmentSize(segment));
+    }
+
+    T *slot(size_t index) const noexcept
+    {
+        const auto [segment, offset] = locate(index);
+        return m_segments[segment].load(std::memory_order_acquire) + offset;
+    }
+
+    void checkReady(size_t index) const
+    {
+        if (!ready(index))
+        {
+            throw std::out_of_range("ConcurrentVector index out of range or not constructed");
+        }
+    }
+
+    // Returns the segment's storage, installing it if this thread is first
+    T *ensureSegment(size_t segment)
+    {
+        T *elements = m_segments[segment].load(std::memory_order_acquire);
+        if (elements != nullptr) [[likely]]
+        {
+            return elements;
+        }
+
+        const size_t slots = segmentSize(segment) + flagSlots(segment);
+        T *fresh = alloc_traits::allocate(m_alloc, slots);
+        Flag *state = flags(fresh, segment);
+        for (size_t i = 0; i < segmentSize(segment); ++i)
+        {
+            ::new (static_cast<void *>(state + i)) Flag(kEmpty);
+        }
+
+        if (m_segments[segment].compare_exchange_strong(elements, fresh, std::memory_order_acq_rel,
+                                                        std::memory_order_acquire))
+        {
+            return fresh;
+        }
+        // Another writer won the race
+        alloc_traits::deallocate(m_alloc, fresh, slots);
+        return elements;
+    }
+
+    template <typename... Args>
+    void constructAt(size_t index, Args &&...args)
+    {
+        const auto [segment, offset] = locate(index);
+        T *elements = nullptr;
+        try
+        {
+            elements = ensureSegment(segment);
+            alloc_traits::construct(m_alloc, elements + offset, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            markFailed(elements, segment, offset);
+            throw;
+        }
+        flags(elements, segment)[offset].store(kReady, std::memory_order_release);
+    }
+
+    // The claimed slot is lost; remember it so teardown can skip it
+    void markFailed(T *elements, size_t segment, size_t offset) noexcept
+    {
+        if (elements != nullptr)
+        {
+            flags(elements, segment)[offset].store(kFailed, std::memory_order_release);
+        }
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename Construct>
+    size_t growBy(size_t count, Construct construct)
+    {
+        const size_t first = m_size.fetch_add(count, std::memory_order_relaxed);
+        for (size_t index = first; index < first + count; ++index)
+        {
+            const auto [segment, offset] = locate(index);
+            T *elements = nullptr;
+            try
+            {
+                elements = ensureSegment(segment);
+                construct(elements + offset);
+            }
+            catch (...)
+            {
+                // Every remaining slot of the batch stays empty
+                for (size_t rest = index; rest < first + count; ++rest)
+                {
+                    const Location at = locate(rest);
+                    markFailed(m_segments[at.segment].load(std::memory_order_acquire), at.segment, at.offset);
+                }
+                throw;
+            }
+            flags(elements, segment)[offset].store(kReady, std::memory_order_release);
+        }
+        return first;
+    }
+
+    // Calls visit(first, last) for each run of constructed elements
+    template <typename Visit>
+    void forEachRun(Visit visit) const
+    {
+        const size_t size = m_size.load(std::memory_order_acquire);
+        const bool holes = m_failed.load(std::memory_order_acquire) > 0;
+        for (size_t segment = 0; segment < kMaxSegments && segmentBase(segment) < size; ++segment)
+        {
+            T *elements = m_segments[segment].load(std::memory_order_acquire);
+            if (elements == nullptr)
+            {
+                continue;
+            }
+            const size_t used = std::min(segmentSize(segment), size - segmentBase(segment));
+            if (!holes)
+            {
+                visit(elements, elements + used);
+                continue;
+            }
+
+            const Flag *state = flags(elements, segment);
+            size_t begin = 0;
+            while (begin < used)
+            {
+                while (begin < used && state[begin].load(std::memory_order_relaxed) != kReady)
+                {
+                    ++begin;
+                }
+                size_t end = begin;
+                while (end < used && state[end].load(std::memory_order_relaxed) == kReady)
+                {
+                    ++end;
+                }
+                if (begin < end)
+                {
+                    visit(elements + begin, elements + end);
+                }
+                begin = end;
+            }
+        }
+    }
+
+    template <typename Out, typename MakeRange>
+    void compactInto(Out &out, MakeRange makeRange) const
+    {
+        out.reserve(size() - m_failed.load(std::memory_order_acquire));
+        forEachRun([&](T *first, T *last) { out.append_range(makeRange(first, last)); });
+    }
+
+    void release() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            forEachRun([this](T *first, T *last) {
+                for (; first != last; ++first)
+                {
+                    alloc_traits::destroy(m_alloc, first);
+                }
+            });
+        }
+        for (size_t segment = 0; segment < kMaxSegments; ++segment)
+        {
+            T *elements = m_segments[segment].exchange(nullptr, std::memory_order_relaxed);
+            if (elements != nullptr)
+            {
+                alloc_traits::deallocate(m_alloc, elements, segmentSize(segment) + flagSlots(segment));
+            }
+        }
+    }
+};
@@ -0,0 +1,281 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+/*
+    Copy-on-write Vector for data handed to many readers.
+
+        Vector<Row> rows = load();
+        CowVector<Row> snapshot = freeze(std::move(rows));   // no element copied
+        for (Reader &r : readers) r.take(snapshot);            // refcount bump each
+        snapshot.push_back(extra);                             // private copy here, once
+
+    A CowVector points at a refcounted block holding an ordinary Vector.
+    Copies share the block; the first modifying call on a shared CowVector
+    copies the elements into a block of its own, then modifies that. Reads
+    never copy. freeze() moves an existing Vector's buffer into a block and
+    thaw() moves it back out when the snapshot is unshared.
+
+    The refcount is atomic, so copies may be made, read and destroyed on
+    different threads concurrently; a single CowVector object is not
+    synchronized, like std::shared_ptr. References returned by edit() are
+    only valid until the CowVector is next copied: writing through them
+    afterwards would change the copy too.
+*/
+template <typename T, typename Allocator = VectorDefaultAllocator<T>, typename GrowthPolicy = DoublingGrowth>
+class CowVector
+{
+public:
+    using vector_type = Vector<T, Allocator, GrowthPolicy>;
+    using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = size_t;
+    using const_reference = const T &;
+    using const_iterator = typename vector_type::const_iterator;
+
+private:
+    struct Shared
+    {
+        std::atomic<size_t> refs;
+        vector_type elements;
+
+        explicit Shared(vector_type &&v) : refs(1), elements(std::move(v)) {}
+    };
+
+    using shared_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Shared>;
+    using shared_traits = std::allocator_traits<shared_allocator>;
+
+    Shared *m_shared;
+
+public:
+    /*
+        Constructors
+    */
+    CowVector() noexcept : m_shared(nullptr) {}
+
+    CowVector(std::initializer_list<T> init)
+        : CowVector(vector_type(init))
+    {
+    }
+
+    // Takes over the buffer of v, see freeze()
+    explicit CowVector(vector_type &&v)
+        : m_shared(v.capacity() == 0 ? nullptr : makeShared(std::move(v)))
+    {
+    }
+
+    // Shares other's elements
+    CowVector(const CowVector &other) noexcept
+        : m_shared(other.m_shared)
+    {
+        if (m_shared)
+        {
+            m_shared->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowVector(CowVector &&other) noexcept
+        : m_shared(std::exchange(other.m_shared, nullptr))
+    {
+    }
+
+    ~CowVector()
+    {
+        release();
+    }
+
+    CowVector &operator=(const CowVector &other) noexcept
+    {
+        CowVector tmp(other);
+        swap(tmp);
+        return *this;
+    }
+
+    CowVector &operator=(CowVector &&other) noexcept
+    {
+        CowVector tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(CowVector &other) noexcept
+    {
+        std::swap(m_shared, other.m_shared);
+    }
+
+    friend void swap(CowVector &a, CowVector &b) noexcept
+    {
+        a.swap(b);
+    }
+
+    // Moves the elements out without copying if this is the only owner,
+    // copies them otherwise. Leaves this empty
+    vector_type thaw() &&
+    {
+        if (!m_shared)
+        {
+            return vector_type();
+        }
+        vector_type out = unique() ? std::move(m_shared->elements) : vector_type(m_shared->elements);
+        release();
+        m_shared = nullptr;
+        return out;
+    }
+
+    /*
+        Sharing
+    */
+    // Number of CowVectors sharing the elements (0 when empty)
+    [[nodiscard]] size_t use_count() const noexcept
+    {
+        return m_shared ? m_shared->refs.load(std::memory_order_acquire) : 0;
+    }
+
+    [[nodiscard]] bool unique() const noexcept { return use_count() <= 1; }
+
+    [[nodiscard]] bool shares_with(const CowVector &other) const noexcept
+    {
+        return m_shared != nullptr && m_shared == other.m_shared;
+    }
+
+    /*
+        Reading (never copies)
+    */
+    // The shared elements as a Vector, e.g. for APIs taking const Vector &
+    const vector_type &view() const noexcept
+    {
+        return m_shared ? m_shared->elements : emptyVector();
+    }
+
+    const T &operator[](size_t index) const noexcept { return m_shared->elements[index]; }
+
+    const T &at(size_t index) const
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("CowVector index out of range");
+        }
+        return m_shared->elements[index];
+    }
+
+    [[nodiscard]] const T *data() const noexcept { return m_shared ? m_shared->elements.data() : nullptr; }
+    [[nodiscard]] size_t size() const noexcept { return m_shared ? m_shared->elements.size() : 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return m_shared ? m_shared->elements.capacity() : 0; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    const_iterator begin() const noexcept { return view().begin(); }
+    const_iterator end() const noexcept { return view().end(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    /*
+        Writing (copies first if shared)
+    */
+    // Exclusive access to the elements for arbitrary modification
+    vector_type &edit()
+    {
+        if (!m_shared)
+        {
+            m_shared = makeShared(vector_type());
+        }
+        else if (!unique())
+        {
+            Shared *own = makeShared(vector_type(m_shared->elements));
+            release();
+            m_shared = own;
+        }
+        return m_shared->elements;
+    }
+
+    void set(size_t index, const T &value)
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("CowVector index out of range");
+        }
+        edit()[index] = value;
+    }
+
+    void push_back(const T &element)
+    {
+        edit().push_back(element);
+    }
+
+    void push_back(T &&element)
+    {
+        edit().push_back(std::move(element));
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        return edit().emplace_back(std::forward<Args>(args)...);
+    }
+
+    void pop_back()
+    {
+        if (empty())
+        {
+            throw std::out_of_range("pop_back() called on empty CowVector");
+        }
+        edit().pop_back();
+    }
+
+    void resize(size_t newSize)
+    {
+        edit().resize(newSize);
+    }
+
+    void reserve(size_t newCapacity)
+    {
+        edit().reserve(newCapacity);
+    }
+
+    // Drops this reference; other owners keep the elements
+    void clear() noexcept
+    {
+        release();
+        m_shared = nullptr;
+    }
+
+private:
+    static const vector_type &emptyVector() noexcept
+    {
+        static const vector_type empty;
+        return empty;
+    }
+
+    static Shared *makeShared(vector_type &&v)
+    {
+        shared_allocator alloc(v.get_allocator());
+        Shared *shared = shared_traits::allocate(alloc, 1);
+        ::new (static_cast<void *>(shared)) Shared(std::move(v));
+        return shared;
+    }
+
+    // The last owner destroys the block; acq_rel orders every owner's reads
+    // before the destruction
+    void release() noexcept
+    {
+        if (m_shared && m_shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            shared_allocator alloc(m_shared->elements.get_allocator());
+            m_shared->~Shared();
+            shared_traits::deallocate(alloc, m_shared, 1);
+        }
+    }
+};
+
+// Turns v into a shareable snapshot without copying its elements
+template <typename T, typename Allocator, typename GrowthPolicy>
+CowVector<T, Allocator, GrowthPolicy> freeze(Vector<T, Allocator, GrowthPolicy> &&v)
+{
+    return CowVector<T, Allocator, GrowthPolicy>(std::move(v));
+}
@@ -0,0 +1,1097 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/*
+    Sorted associative containers on contiguous storage.
+
+        FlatMap<uint32_t, Route> routes;
+        routes.insert_range(loaded);                  // one sort, one merge
+        if (auto it = routes.find(dst); it != routes.end()) use(it->second);
+
+        FlatSet<std::string, std::less<std::string>, EytzingerSearch> names{...};
+
+    FlatSet keeps its keys sorted in one Vector. FlatMap keeps keys and
+    values in two parallel Vectors, so a lookup binary-searches a dense
+    array of keys only and touches the value column once, at the end. No
+    pointer is chased on the way. Single inserts and erases shift the tail
+    (O(n)); bulk loads go through insert_range, which sorts the new
+    elements once and merges them with the existing ones in one pass.
+    extract() hands the Vectors out and adopt() takes them back, both
+    without copying (adopt sorts only if the keys are not sorted yet).
+
+    The Search policy decides how lookups walk the keys:
+      - BinarySearch (default): branchless lower bound on the sorted keys
+        that prefetches both possible next probes, no extra memory.
+      - EytzingerSearch: an extra copy of the keys in Eytzinger (BFS)
+        order, so the top levels of every search share a few cache lines
+        and deeper nodes are prefetched ahead. Rebuilt after every
+        modification: meant for tables that are loaded, then read.
+        Whether it beats BinarySearch depends on the machine's memory
+        parallelism, compare with BM_MapLookup before switching.
+
+    Any modification invalidates iterators, references and pointers. Keys
+    are never modified in place; FlatMap iterators yield
+    std::pair<const Key &, T &> proxies, const iterators a pair of const
+    references (flat_detail::ConstPairRef). Lookups take const Key &, a
+    transparent comparator does not enable heterogeneous lookup.
+*/
+
+namespace flat_detail
+{
+    inline void prefetch([[maybe_unused]] const void *p) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p);
+#endif
+    }
+
+    // Index of the first key not less than key. Each step halves the range
+    // with a conditional move instead of a branch mispredicted half the time
+    template <typename Key, typename Compare>
+    size_t lowerBound(const Key *keys, size_t n, const Key &key, const Compare &comp)
+    {
+        if (n == 0)
+        {
+            return 0;
+        }
+        const Key *base = keys;
+        while (n > 1)
+        {
+            const size_t half = n / 2;
+            // Both candidates for the next probe, so the load is in flight
+            // whichever way this comparison goes
+            prefetch(base + half / 2);
+            prefetch(base + half + half / 2);
+            base = comp(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<size_t>(base - keys) + (comp(*base, key) ? 1 : 0);
+    }
+
+    // Positions of keys[0, n) in sorted order, keeping only the first of
+    // equal keys (the one std::map::insert would keep)
+    template <typename Key, typename Compare>
+    Vector<size_t> sortedUniqueOrder(const Key *keys, size_t n, const Compare &comp)
+    {
+        Vector<size_t> order;
+        order.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            order.push_back(i);
+        }
+
+        const auto byKey = [&](size_t a, size_t b) { return comp(keys[a], keys[b]); };
+        if (!std::is_sorted(order.begin(), order.end(), byKey))
+        {
+            std::stable_sort(order.begin(), order.end(), byKey);
+        }
+        // Neighbours in sorted order are equal unless the first is less
+        const auto last = std::unique(order.begin(), order.end(), [&](size_t a, size_t b)
+                                      { return !comp(keys[a], keys[b]); });
+        order.erase(last, order.end());
+        return order;
+    }
+
+    // What a FlatMap const_iterator yields. A plain std::pair of const
+    // references and std::pair<Key, T> convert both ways, so in C++20 they
+    // have no common reference and the const iterator would not be
+    // indirectly_readable. This pair names one, see basic_common_reference
+    // below
+    template <typename Key, typename T>
+    struct ConstPairRef : std::pair<const Key &, const T &>
+    {
+        using std::pair<const Key &, const T &>::pair;
+    };
+
+    // The two columns of a FlatMap
+    template <typename KeyContainer, typename MappedContainer>
+    struct Columns
+    {
+        KeyContainer keys;
+        MappedContainer values;
+    };
+
+    template <typename Key, typename Compare>
+    bool isSortedUnique(const Key *keys, size_t n, const Compare &comp)
+    {
+        for (size_t i = 1; i < n; ++i)
+        {
+            if (!comp(keys[i - 1], keys[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+template <typename Key, typename T, typename U1, typename U2,
+          template <typename> class TQual, template <typename> class UQual>
+    requires std::convertible_to<UQual<std::pair<U1, U2>>, flat_detail::ConstPairRef<Key, T>>
+struct std::basic_common_reference<flat_detail::ConstPairRef<Key, T>, std::pair<U1, U2>, TQual, UQual>
+{
+    using type = flat_detail::ConstPairRef<Key, T>;
+};
+
+template <typename U1, typename U2, typename Key, typename T,
+          template <typename> class TQual, template <typename> class UQual>
+    requires std::convertible_to<TQual<std::pair<U1, U2>>, flat_detail::ConstPairRef<Key, T>>
+struct std::basic_common_reference<std::pair<U1, U2>, flat_detail::ConstPairRef<Key, T>, TQual, UQual>
+{
+    using type = flat_detail::ConstPairRef<Key, T>;
+};
+
+// Structured bindings see the pair
+template <typename Key, typename T>
+struct std::tuple_size<flat_detail::ConstPairRef<Key, T>> : std::integral_constant<size_t, 2>
+{
+};
+
+template <size_t I, typename Key, typename T>
+struct std::tuple_element<I, flat_detail::ConstPairRef<Key, T>>
+    : std::tuple_element<I, std::pair<const Key &, const T &>>
+{
+};
+
+/*
+    Search policies. Index<Key, Compare> is kept next to the sorted keys:
+    rebuild() after every modification, lowerBound() returns the position
+    of the first key not less than key and find() that of key, or
+    keys.size() for both if there is none.
+*/
+
+// Lower bound straight on the sorted keys
+struct BinarySearch
+{
+    template <typename Key, typename Compare>
+    class Index
+    {
+    public:
+        void rebuild(std::span<const Key>) noexcept {}
+        void clear() noexcept {}
+
+        size_t lowerBound(std::span<const Key> keys, const Key &key, const Compare &comp) const
+        {
+            return flat_detail::lowerBound(keys.data(), keys.size(), key, comp);
+        }
+
+        size_t find(std::span<const Key> keys, const Key &key, const Compare &comp) const
+        {
+            const size_t i = lowerBound(keys, key, comp);
+            return i < keys.size() && !comp(key, keys[i]) ? i : keys.size();
+        }
+    };
+};
+
+// Lower bound on a copy of the keys in Eytzinger order: node k (1-based)
+// has children 2k and 2k + 1, so a search reads the array front to back
+// and the descendants a few levels down sit in one or two cache lines that
+// are fetched while the current levels are compared
+struct EytzingerSearch
+{
+    template <typename Key, typename Compare>
+    class Index
+    {
+    public:
+        // Never throws: if the copy fails, lookups fall back to binary search
+        void rebuild(std::span<const Key> keys) noexcept
+        {
+            clear();
+            try
+            {
+                m_layout.reserve(keys.size());
+                for (size_t k = 1; k <= keys.size(); ++k)
+                {
+                    m_layout.push_back(keys[rankOf(k, keys.size())]);
+                }
+            }
+            catch (...)
+            {
+                clear();
+            }
+        }
+
+        void clear() noexcept
+        {
+            m_layout.clear();
+        }
+
+        size_t lowerBound(std::span<const Key> keys, const Key &key, const Compare &comp) const
+        {
+            const size_t n = keys.size();
+            if (m_layout.size() != n)
+            {
+                return flat_detail::lowerBound(keys.data(), n, key, comp);
+            }
+            const size_t k = descend(key, comp);
+            return k == 0 ? n : rankOf(k, n);
+        }
+
+        // Confirms a match on the node the search ended on, which is in
+        // cache, instead of loading the sorted key
+        size_t find(std::span<const Key> keys, const Key &key, const Compare &comp) const
+        {
+            const size_t n = keys.size();
+            if (m_layout.size() != n)
+            {
+                const size_t i = flat_detail::lowerBound(keys.data(), n, key, comp);
+                return i < n && !comp(key, keys[i]) ? i : n;
+            }
+            const size_t k = descend(key, comp);
+            return k != 0 && !comp(key, m_layout[k - 1]) ? rankOf(k, n) : n;
+        }
+
+    private:
+        // Nodes per cache line: node k's descendants log2(stride) levels
+        // down start at k * stride and share a line
+        static constexpr size_t kPrefetchStride = sizeof(Key) <= 64 ? 64 / sizeof(Key) : 1;
+
+        // Node holding the smallest key not less than key, 0 if none
+        size_t descend(const Key &key, const Compare &comp) const
+        {
+            const size_t n = m_layout.size();
+            if (n == 0)
+            {
+                return 0;
+            }
+
+            // All levels but the last are full: a fixed trip count, so the
+            // loop exit is predicted and only the last level needs a check
+            const Key *layout = m_layout.data();
+            const int fullLevels = std::bit_width(n) - 1;
+            size_t k = 1;
+            for (int level = 0; level < fullLevels; ++level)
+            {
+                if constexpr (kPrefetchStride > 1)
+                {
+                    // May point past the end near the bottom, which a
+                    // prefetch tolerates; computed as an integer since such
+                    // a pointer may not be formed
+                    flat_detail::prefetch(reinterpret_cast<const void *>(
+                        reinterpret_cast<uintptr_t>(layout) + (k * kPrefetchStride - 1) * sizeof(Key)));
+                }
+                k = 2 * k + (comp(layout[k - 1], key) ? 1 : 0);
+            }
+            // Last, partial level: step down only if node k exists
+            const bool exists = k <= n;
+            const size_t down = 2 * k + (comp(layout[(exists ? k : 1) - 1], key) ? 1 : 0);
+            k = exists ? down : k;
+            // Undo the trailing right turns (and the last left one): what
+            // is left is the last node where the search went left
+            return k >> (std::countr_one(k) + 1);
+        }
+
+        // Sorted position of node k in a tree of n nodes, computed rather
+        // than stored so a lookup costs no extra cache miss
+        static size_t rankOf(size_t k, size_t n) noexcept
+        {
+            const size_t height = static_cast<size_t>(std::bit_width(n));
+            const size_t depth = static_cast<size_t>(std::bit_width(k)) - 1;
+            // Position if the last level were full
+            const size_t full = ((2 * (k - (size_t(1) << depth)) + 1) << (height - depth - 1)) - 1;
+            // Last-level leaf j sits at full position 2j; the missing ones
+            // (j >= leaves) that come before k do not count
+            const size_t leaves = n - (size_t(1) << (height - 1)) + 1;
+            const size_t leavesBefore = (full + 1) / 2;
+            return full - (leavesBefore > leaves ? leavesBefore - leaves : 0);
+        }
+
+        Vector<Key> m_layout;
+    };
+};
+
+template <typename Key, typename Compare = std::less<Key>, typename Search = BinarySearch,
+          typename KeyContainer = Vector<Key>>
+class FlatSet
+{
+    static_assert(std::is_same_v<typename KeyContainer::value_type, Key>,
+                  "KeyContainer::value_type must be Key");
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using search_policy = Search;
+    using container_type = KeyContainer;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const Key &;
+    using const_reference = const Key &;
+    // Keys are immutable, both iterators are const
+    using iterator = typename KeyContainer::const_iterator;
+    using const_iterator = typename KeyContainer::const_iterator;
+
+private:
+    KeyContainer m_keys;
+    [[no_unique_address]] Compare m_comp;
+    typename Search::template Index<Key, Compare> m_index;
+
+public:
+    /*
+        Constructors
+    */
+    FlatSet() : m_keys(), m_comp() {}
+
+    explicit FlatSet(const Compare &comp) : m_keys(), m_comp(comp) {}
+
+    FlatSet(std::initializer_list<Key> init, const Compare &comp = Compare())
+        : FlatSet(comp)
+    {
+        insert_range(init);
+    }
+
+    template <std::ranges::input_range R>
+        requires(!std::same_as<std::remove_cvref_t<R>, FlatSet> &&
+                 !std::same_as<std::remove_cvref_t<R>, KeyContainer> &&
+                 std::constructible_from<Key, std::ranges::range_reference_t<R>>)
+    explicit FlatSet(R &&range, const Compare &comp = Compare())
+        : FlatSet(comp)
+    {
+        insert_range(std::forward<R>(range));
+    }
+
+    // Takes over keys, see adopt()
+    explicit FlatSet(KeyContainer &&keys, const Compare &comp = Compare())
+        : FlatSet(comp)
+    {
+        adopt(std::move(keys));
+    }
+
+    // Copies keys, then sorts the copy as adopt() does
+    explicit FlatSet(const KeyContainer &keys, const Compare &comp = Compare())
+        : FlatSet(KeyContainer(keys), comp)
+    {
+    }
+
+    /*
+        Lookup
+    */
+    const_iterator find(const Key &key) const
+    {
+        return begin() + m_index.find(std::span<const Key>(m_keys.data(), m_keys.size()), key, m_comp);
+    }
+
+    bool contains(const Key &key) const { return find(key) != end(); }
+    size_t count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+    const_iterator lower_bound(const Key &key) const { return begin() + lowerIndex(key); }
+
+    const_iterator upper_bound(const Key &key) const
+    {
+        const size_t i = lowerIndex(key);
+        return begin() + (i < size() && !m_comp(key, m_keys[i]) ? i + 1 : i);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+    {
+        const const_iterator first = lower_bound(key);
+        return {first, first != end() && !m_comp(key, *first) ? first + 1 : first};
+    }
+
+    /*
+        Modifiers
+    */
+    std::pair<iterator, bool> insert(const Key &key)
+    {
+        return insertKey(key);
+    }
+
+    std::pair<iterator, bool> insert(Key &&key)
+    {
+        return insertKey(std::move(key));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args)
+    {
+        return insertKey(Key(std::forward<Args>(args)...));
+    }
+
+    void insert(std::initializer_list<Key> init)
+    {
+        insert_range(init);
+    }
+
+    // Sorts the new keys once and merges them with the existing ones in a
+    // single pass. Keys already present are left alone
+    template <std::ranges::input_range R>
+    void insert_range(R &&range)
+    {
+        KeyContainer keys(m_keys.get_allocator());
+        if constexpr (std::ranges::sized_range<R>)
+        {
+            keys.reserve(static_cast<size_t>(std::ranges::size(range)));
+        }
+        for (auto &&key : range)
+        {
+            keys.emplace_back(std::forward<decltype(key)>(key));
+        }
+        mergeIn(std::move(keys));
+    }
+
+    size_t erase(const Key &key)
+    {
+        const const_iterator it = find(key);
+        if (it == end())
+        {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const difference_type index = first - begin();
+        m_keys.erase(first, last);
+        m_index.rebuild(m_keys);
+        return begin() + index;
+    }
+
+    void clear() noexcept
+    {
+        m_keys.clear();
+        m_index.clear();
+    }
+
+    void reserve(size_t n)
+    {
+        m_keys.reserve(n);
+    }
+
+    void swap(FlatSet &other) noexcept
+    {
+        using std::swap;
+        swap(m_keys, other.m_keys);
+        swap(m_comp, other.m_comp);
+        swap(m_index, other.m_index);
+    }
+
+    friend void swap(FlatSet &lhs, FlatSet &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    /*
+        Underlying storage
+    */
+    const KeyContainer &keys() const noexcept { return m_keys; }
+
+    // Moves the sorted keys out, leaving the set empty
+    KeyContainer extract() &&
+    {
+        KeyContainer keys = std::move(m_keys);
+        clear();
+        return keys;
+    }
+
+    // Replaces the contents with keys. Sorted, duplicate-free keys are
+    // taken over as they are; otherwise they are sorted and deduplicated
+    void adopt(KeyContainer &&keys)
+    {
+        if (flat_detail::isSortedUnique(keys.data(), keys.size(), m_comp))
+        {
+            m_keys = std::move(keys);
+            m_index.rebuild(m_keys);
+            return;
+        }
+        clear();
+        mergeIn(std::move(keys));
+    }
+
+    key_compare key_comp() const { return m_comp; }
+
+    [[nodiscard]] size_t size() const noexcept { return m_keys.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_keys.empty(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_keys.capacity(); }
+
+    const_iterator begin() const noexcept { return m_keys.begin(); }
+    const_iterator end() const noexcept { return m_keys.end(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    size_t lowerIndex(const Key &key) const
+    {
+        return m_index.lowerBound(std::span<const Key>(m_keys.data(), m_keys.size()), key, m_comp);
+    }
+
+    template <typename K>
+    std::pair<iterator, bool> insertKey(K &&key)
+    {
+        const size_t i = lowerIndex(key);
+        if (i < size() && !m_comp(key, m_keys[i]))
+        {
+            return {begin() + i, false};
+        }
+        m_keys.insert(m_keys.begin() + i, std::forward<K>(key));
+        m_index.rebuild(m_keys);
+        return {begin() + i, true};
+    }
+
+    // Merges unsorted keys into the sorted ones. The existing keys are only
+    // moved if that cannot throw, so the set is unchanged on exception
+    void mergeIn(KeyContainer &&keys)
+    {
+        const Vector<size_t> order = flat_detail::sortedUniqueOrder(keys.data(), keys.size(), m_comp);
+
+        KeyContainer merged(m_keys.get_allocator());
+        merged.reserve(m_keys.size() + order.size());
+        size_t i = 0;
+        for (size_t j : order)
+        {
+            for (; i < m_keys.size() && m_comp(m_keys[i], keys[j]); ++i)
+            {
+                merged.push_back(std::move_if_noexcept(m_keys[i]));
+            }
+            if (i == m_keys.size() || m_comp(keys[j], m_keys[i]))
+            {
+                merged.push_back(std::move(keys[j]));
+            }
+        }
+        for (; i < m_keys.size(); ++i)
+        {
+            merged.push_back(std::move_if_noexcept(m_keys[i]));
+        }
+
+        m_keys = std::move(merged);
+        m_index.rebuild(m_keys);
+    }
+};
+
+template <typename Key, typename T, typename Compare = std::less<Key>, typename Search = BinarySearch,
+          typename KeyContainer = Vector<Key>, typename MappedContainer = Vector<T>>
+class FlatMap
+{
+    static_assert(std::is_same_v<typename KeyContainer::value_type, Key>,
+                  "KeyContainer::value_type must be Key");
+    static_assert(std::is_same_v<typename MappedContainer::value_type, T>,
+                  "MappedContainer::value_type must be T");
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using search_policy = Search;
+    using key_container_type = KeyContainer;
+    using mapped_container_type = MappedContainer;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::pair<const Key &, T &>;
+    using const_reference = flat_detail::ConstPairRef<Key, T>;
+
+    // What extract() hands out and adopt() takes, the same type for every
+    // Compare and Search so columns can move between them
+    using containers = flat_detail::Columns<KeyContainer, MappedContainer>;
+
+    // Random access over both columns with proxy references
+    template <bool IsConst>
+    class IteratorImpl
+    {
+    public:
+        // The pairs yielded are prvalues, which the C++17 categories above
+        // input do not allow
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = FlatMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const_reference, FlatMap::reference>;
+        using mapped_pointer = std::conditional_t<IsConst, const T *, T *>;
+
+        // Makes it->first and it->second work on the proxy
+        struct pointer
+        {
+            reference ref;
+            const reference *operator->() const noexcept { return &ref; }
+        };
+
+        IteratorImpl() noexcept : m_key(nullptr), m_value(nullptr) {}
+        IteratorImpl(const Key *key, mapped_pointer value) noexcept : m_key(key), m_value(value) {}
+
+        template <bool Other>
+            requires(!Other && IsConst)
+        IteratorImpl(const IteratorImpl<Other> &other) noexcept : m_key(other.m_key), m_value(other.m_value)
+        {
+        }
+
+        template <bool>
+        friend class IteratorImpl;
+
+        reference operator*() const noexcept { return reference(*m_key, *m_value); }
+        reference operator[](difference_type n) const noexcept { return reference(m_key[n], m_value[n]); }
+        pointer operator->() const noexcept { return pointer{**this}; }
+
+        IteratorImpl &operator++() noexcept
+        {
+            ++m_key;
+            ++m_value;
+            return *this;
+        }
+        IteratorImpl operator++(int) noexcept
+        {
+            IteratorImpl it = *this;
+            ++*this;
+            return it;
+        }
+        IteratorImpl &operator--() noexcept
+        {
+            --m_key;
+            --m_value;
+            return *this;
+        }
+        IteratorImpl operator--(int) noexcept
+        {
+            IteratorImpl it = *this;
+            --*this;
+            return it;
+        }
+        IteratorImpl &operator+=(difference_type n) noexcept
+        {
+            m_key += n;
+            m_value += n;
+            return *this;
+        }
+        IteratorImpl &operator-=(difference_type n) noexcept
+        {
+            m_key -= n;
+            m_value -= n;
+            return *this;
+        }
+
+        friend IteratorImpl operator+(IteratorImpl it, difference_type n) noexcept { return it += n; }
+        friend IteratorImpl operator+(difference_type n, IteratorImpl it) noexcept { return it += n; }
+        friend IteratorImpl operator-(IteratorImpl it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const IteratorImpl &lhs, const IteratorImpl &rhs) noexcept
+        {
+            return lhs.m_key - rhs.m_key;
+        }
+
+        template <bool R>
+        bool operator==(const IteratorImpl<R> &other) const noexcept { return m_key == other.m_key; }
+        template <bool R>
+        auto operator<=>(const IteratorImpl<R> &other) const noexcept { return m_key <=> other.m_key; }
+
+    private:
+        const Key *m_key;
+        mapped_pointer m_value;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+
+private:
+    KeyContainer m_keys;
+    MappedContainer m_values;
+    [[no_unique_address]] Compare m_comp;
+    typename Search::template Index<Key, Compare> m_index;
+
+public:
+    /*
+        Constructors
+    */
+    FlatMap() : m_keys(), m_values(), m_comp() {}
+
+    explicit FlatMap(const Compare &comp) : m_keys(), m_values(), m_comp(comp) {}
+
+    FlatMap(std::initializer_list<value_type> init, const Compare &comp = Compare())
+        : FlatMap(comp)
+    {
+        insert_range(init);
+    }
+
+    template <std::ranges::input_range R>
+        requires(!std::same_as<std::remove_cvref_t<R>, FlatMap> &&
+                 !std::same_as<std::remove_cvref_t<R>, KeyContainer> &&
+                 std::constructible_from<value_type, std::ranges::range_reference_t<R>>)
+    explicit FlatMap(R &&range, const Compare &comp = Compare())
+        : FlatMap(comp)
+    {
+        insert_range(std::forward<R>(range));
+    }
+
+    // Takes over both columns, see adopt()
+    FlatMap(KeyContainer &&keys, MappedContainer &&values, const Compare &comp = Compare())
+        : FlatMap(comp)
+    {
+        adopt(std::move(keys), std::move(values));
+    }
+
+    /*
+        Lookup
+    */
+    iterator find(const Key &key)
+    {
+        const size_t i = findIndex(key);
+        return i == npos ? end() : at_index(i);
+    }
+
+    const_iterator find(const Key &key) const
+    {
+        const size_t i = findIndex(key);
+        return i == npos ? end() : at_index(i);
+    }
+
+    bool contains(const Key &key) const { return findIndex(key) != npos; }
+    size_t count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+    T &at(const Key &key)
+    {
+        return m_values[checkedIndex(key)];
+    }
+
+    const T &at(const Key &key) const
+    {
+        return m_values[checkedIndex(key)];
+    }
+
+    // Inserts a value-initialized T if key is missing
+    T &operator[](const Key &key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    T &operator[](Key &&key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    iterator lower_bound(const Key &key) { return at_index(lowerIndex(key)); }
+    const_iterator lower_bound(const Key &key) const { return at_index(lowerIndex(key)); }
+
+    iterator upper_bound(const Key &key) { return at_index(upperIndex(key)); }
+    const_iterator upper_bound(const Key &key) const { return at_index(upperIndex(key)); }
+
+    std::pair<iterator, iterator> equal_range(const Key &key)
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    /*
+        Modifiers
+    */
+    std::pair<iterator, bool> insert(const value_type &value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type &&value)
+    {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    // Constructs T from args only if key is missing
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args)
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args)
+    {
+        return tryEmplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key &key, M &&value)
+    {
+        return insertOrAssign(key, std::forward<M>(value));
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key &&key, M &&value)
+    {
+        return insertOrAssign(std::move(key), std::forward<M>(value));
+    }
+
+    void insert(std::initializer_list<value_type> init)
+    {
+        insert_range(init);
+    }
+
+    // Takes any range of pair-like elements. Sorts the new elements once and
+    // merges them with the existing ones in a single pass; keys already
+    // present keep their value, as with std::map::insert
+    template <std::ranges::input_range R>
+    void insert_range(R &&range)
+    {
+        KeyContainer keys(m_keys.get_allocator());
+        MappedContainer values(m_values.get_allocator());
+        if constexpr (std::ranges::sized_range<R>)
+        {
+            keys.reserve(static_cast<size_t>(std::ranges::size(range)));
+            values.reserve(static_cast<size_t>(std::ranges::size(range)));
+        }
+        for (auto &&element : range)
+        {
+            using Element = decltype(element);
+            keys.emplace_back(std::get<0>(std::forward<Element>(element)));
+            values.emplace_back(std::get<1>(std::forward<Element>(element)));
+        }
+        mergeIn(std::move(keys), std::move(values));
+    }
+
+    size_t erase(const Key &key)
+    {
+        const size_t i = findIndex(key);
+        if (i == npos)
+        {
+            return 0;
+        }
+        eraseIndices(i, i + 1);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, std::next(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const size_t index = static_cast<size_t>(first - cbegin());
+        eraseIndices(index, static_cast<size_t>(last - cbegin()));
+        return at_index(index);
+    }
+
+    void clear() noexcept
+    {
+        m_keys.clear();
+        m_values.clear();
+        m_index.clear();
+    }
+
+    void reserve(size_t n)
+    {
+        m_keys.reserve(n);
+        m_values.reserve(n);
+    }
+
+    void swap(FlatMap &other) noexcept
+    {
+        using std::swap;
+        swap(m_keys, other.m_keys);
+        swap(m_values, other.m_values);
+        swap(m_comp, other.m_comp);
+        swap(m_index, other.m_index);
+    }
+
+    friend void swap(FlatMap &lhs, FlatMap &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    /*
+        Underlying storage
+    */
+    // The sorted keys, and the values in the same order
+    const KeyContainer &keys() const noexcept { return m_keys; }
+    std::span<T> values() noexcept { return std::span<T>(m_values.data(), m_values.size()); }
+    std::span<const T> values() const noexcept { return std::span<const T>(m_values.data(), m_values.size()); }
+
+    // Moves both columns out, leaving the map empty
+    containers extract() &&
+    {
+        containers out{std::move(m_keys), std::move(m_values)};
+        clear();
+        return out;
+    }
+
+    // Replaces the contents with keys[i] -> values[i]. Sorted,
+    // duplicate-free keys are taken over as they are; otherwise the pairs
+    // are sorted and the first of equal keys is kept
+    void adopt(KeyContainer &&keys, MappedContainer &&values)
+    {
+        if (keys.size() != values.size())
+        {
+            throw std::invalid_argument("FlatMap::adopt: keys and values differ in size");
+        }
+        if (flat_detail::isSortedUnique(keys.data(), keys.size(), m_comp))
+        {
+            m_keys = std::move(keys);
+            m_values = std::move(values);
+            m_index.rebuild(m_keys);
+            return;
+        }
+        clear();
+        mergeIn(std::move(keys), std::move(values));
+    }
+
+    void adopt(containers &&columns)
+    {
+        adopt(std::move(columns.keys), std::move(columns.values));
+    }
+
+    key_compare key_comp() const { return m_comp; }
+
+    [[nodiscard]] size_t size() const noexcept { return m_keys.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_keys.empty(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_keys.capacity(); }
+
+    iterator begin() noexcept { return at_index(0); }
+    iterator end() noexcept { return at_index(size()); }
+    const_iterator begin() const noexcept { return at_index(0); }
+    const_iterator end() const noexcept { return at_index(size()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    iterator at_index(size_t i) noexcept { return iterator(m_keys.data() + i, m_values.data() + i); }
+    const_iterator at_index(size_t i) const noexcept { return const_iterator(m_keys.data() + i, m_values.data() + i); }
+
+    size_t lowerIndex(const Key &key) const
+    {
+        return m_index.lowerBound(std::span<const Key>(m_keys.data(), m_keys.size()), key, m_comp);
+    }
+
+    size_t upperIndex(const Key &key) const
+    {
+        const size_t i = lowerIndex(key);
+        return i < size() && !m_comp(key, m_keys[i]) ? i + 1 : i;
+    }
+
+    size_t findIndex(const Key &key) const
+    {
+        const size_t i = m_index.find(std::span<const Key>(m_keys.data(), m_keys.size()), key, m_comp);
+        return i < size() ? i : npos;
+    }
+
+    size_t checkedIndex(const Key &key) const
+    {
+        const size_t i = findIndex(key);
+        if (i == npos)
+        {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return i;
+    }
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> tryEmplace(K &&key, Args &&...args)
+    {
+        const size_t i = lowerIndex(key);
+        if (i < size() && !m_comp(key, m_keys[i]))
+        {
+            return {at_index(i), false};
+        }
+
+        m_keys.insert(m_keys.begin() + i, std::forward<K>(key));
+        try
+        {
+            m_values.emplace(m_values.begin() + i, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            m_keys.erase(m_keys.begin() + i);
+            throw;
+        }
+        m_index.rebuild(m_keys);
+        return {at_index(i), true};
+    }
+
+    template <typename K, typename M>
+    std::pair<iterator, bool> insertOrAssign(K &&key, M &&value)
+    {
+        auto result = tryEmplace(std::forward<K>(key), std::forward<M>(value));
+        if (!result.second)
+        {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    void eraseIndices(size_t first, size_t last)
+    {
+        m_keys.erase(m_keys.begin() + first, m_keys.begin() + last);
+        m_values.erase(m_values.begin() + first, m_values.begin() + last);
+        m_index.rebuild(m_keys);
+    }
+
+    // Merges unsorted pairs into the sorted columns. Existing pairs are
+    // moved only if neither the key nor the value move can throw, and copied
+    // otherwise, so the map is unchanged on exception
+    void mergeIn(KeyContainer &&keys, MappedContainer &&values)
+    {
+        constexpr bool moveExisting =
+            std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<T>;
+
+        const Vector<size_t> order = flat_detail::sortedUniqueOrder(keys.data(), keys.size(), m_comp);
+
+        KeyContainer mergedKeys(m_keys.get_allocator());
+        MappedContainer mergedValues(m_values.get_allocator());
+        mergedKeys.reserve(m_keys.size() + order.size());
+        mergedValues.reserve(m_keys.size() + order.size());
+
+        size_t i = 0;
+        const auto takeExisting = [&]
+        {
+            if constexpr (moveExisting)
+            {
+                mergedKeys.push_back(std::move(m_keys[i]));
+                mergedValues.push_back(std::move(m_values[i]));
+            }
+            else
+            {
+                mergedKeys.push_back(std::as_const(m_keys[i]));
+                mergedValues.push_back(std::as_const(m_values[i]));
+            }
+            ++i;
+        };
+        for (size_t j : order)
+        {
+            while (i < m_keys.size() && m_comp(m_keys[i], keys[j]))
+            {
+                takeExisting();
+            }
+            if (i == m_keys.size() || m_comp(keys[j], m_keys[i]))
+            {
+                mergedKeys.push_back(std::move(keys[j]));
+                mergedValues.push_back(std::move(values[j]));
+            }
+        }
+        while (i < m_keys.size())
+        {
+            takeExisting();
+        }
+
+        m_keys = std::move(mergedKeys);
+        m_values = std::move(mergedValues);
+        m_index.rebuild(m_keys);
+    }
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/*
+    Growth policies decide the capacity a container moves to once it runs
+    out of space. Every policy provides
+
+        static size_t grow(size_t capacity, size_t required, size_t elementSize);
+
+    returning a capacity of at least `required` elements. They are plain
+    types passed as template parameter, so the choice costs nothing at
+    runtime: memory vs. number of reallocations is traded per workload.
+*/
+
+namespace growth_detail
+{
+    // Largest element count whose byte size still fits in size_t
+    constexpr size_t maxElements(size_t elementSize)
+    {
+        return std::numeric_limits<size_t>::max() / elementSize;
+    }
+
+    constexpr size_t roundUp(size_t value, size_t multiple)
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+}
+
+// Capacity 1, 2, 4, 8, ... Fewest reallocations, up to 50% idle memory
+struct DoublingGrowth
+{
+    static constexpr size_t grow(size_t capacity, size_t required, size_t elementSize)
+    {
+        const size_t limit = growth_detail::maxElements(elementSize);
+        const size_t doubled = capacity == 0 ? 1 : (capacity > limit / 2 ? limit : 2 * capacity);
+        return std::max(doubled, required);
+    }
+};
+
+// Capacity grows by half each time. At most 33% idle memory, and freed
+// blocks eventually add up to a size the allocator can reuse for the
+// next request
+struct OneAndHalfGrowth
+{
+    static constexpr size_t grow(size_t capacity, size_t required, size_t elementSize)
+    {
+        const size_t limit = growth_detail::maxElements(elementSize);
+        const size_t grown = capacity < 2 ? capacity + 1 : (capacity > limit - capacity / 2 ? limit : capacity + capacity / 2);
+        return std::max(grown, required);
+    }
+};
+
+// Adds Step elements each time. Linear number of reallocations, for
+// vectors whose final size is roughly known and memory is tight
+template <size_t Step>
+struct FixedIncrementGrowth
+{
+    static_assert(Step > 0, "FixedIncrementGrowth needs a positive step");
+
+    static constexpr size_t grow(size_t capacity, size_t required, size_t elementSize)
+    {
+        const size_t limit = growth_detail::maxElements(elementSize);
+        const size_t grown = capacity > limit - Step ? limit : capacity + Step;
+        return std::max(grown, required);
+    }
+};
+
+/*
+    Size classes: round a byte count up to what the underlying allocator
+    will hand out anyway, so the spare bytes become usable capacity.
+*/
+
+// glibc malloc chunks: 16 byte granularity with one size_t of header,
+// minimum usable size of 24 bytes on 64-bit
+struct MallocSizeClass
+{
+    static constexpr size_t round(size_t bytes)
+    {
+        constexpr size_t header = sizeof(size_t);
+        constexpr size_t alignment = 2 * sizeof(size_t);
+        constexpr size_t minUsable = 4 * sizeof(size_t) - header;
+        if (bytes <= minUsable)
+        {
+            return minUsable;
+        }
+        return growth_detail::roundUp(bytes + header, alignment) - header;
+    }
+};
+
+// Whole 4 KiB pages
+struct PageSizeClass
+{
+    static constexpr size_t kPageSize = 4096;
+
+    static constexpr size_t round(size_t bytes)
+    {
+        return growth_detail::roundUp(bytes, kPageSize);
+    }
+};
+
+// Whole 2 MiB hugepages once a buffer is at least one hugepage large,
+// 4 KiB pages below that
+struct HugePageSizeClass
+{
+    static constexpr size_t kHugePageSize = size_t(2) << 20;
+
+    static constexpr size_t round(size_t bytes)
+    {
+        if (bytes < kHugePageSize)
+        {
+            return PageSizeClass::round(bytes);
+        }
+        return growth_detail::roundUp(bytes, kHugePageSize);
+    }
+};
+
+// Grows like Base, then widens the capacity to fill the whole size class
+template <typename SizeClass = MallocSizeClass, typename Base = DoublingGrowth>
+struct SizeClassGrowth
+{
+    static constexpr size_t grow(size_t capacity, size_t required, size_t elementSize)
+    {
+        const size_t target = Base::grow(capacity, required, elementSize);
+        if (target > growth_detail::maxElements(elementSize) / 2)
+        {
+            return target;
+        }
+        return std::max(target, SizeClass::round(target * elementSize) / elementSize);
+    }
+};
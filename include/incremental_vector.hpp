@@ -0,0 +1,538 @@
+#pragma once
+
+#include "vector.hpp"
+
+/*
+    Vector whose growth is spread over many push_backs.
+
+    A regular Vector moves all n elements the moment it runs out of space.
+    IncrementalVector instead allocates the bigger block and keeps the old
+    one alive; every following push_back migrates at most a bounded batch
+    of elements (in the style of Redis' incremental rehash). The batch is
+    sized so migration always finishes before the new block fills up, so
+    the worst case of any single operation is O(batch) plus one allocation.
+
+    While a migration is in flight the elements are split:
+
+        [0, migrated)         new block
+        [migrated, oldSize)   old block
+        [oldSize, size)       new block
+
+    Indexed access picks the right block with one well-predicted branch.
+    Contiguous storage is only guaranteed after settle() (which data()
+    calls), and migration moves elements, so references are not stable.
+*/
+template <typename T,
+          typename Allocator = VectorDefaultAllocator<T>,
+          typename GrowthPolicy = DoublingGrowth,
+          size_t MigrationBatch = 64>
+class IncrementalVector
+{
+    static_assert(MigrationBatch > 0, "MigrationBatch must be positive");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+
+    // Random access by index, so it stays valid across block boundaries
+    template <bool IsConst>
+    class IteratorImpl
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const T &, T &>;
+        using pointer = std::conditional_t<IsConst, const T *, T *>;
+        using container = std::conditional_t<IsConst, const IncrementalVector, IncrementalVector>;
+
+        IteratorImpl() noexcept : m_owner(nullptr), m_index(0) {}
+        IteratorImpl(container *owner, size_t index) noexcept : m_owner(owner), m_index(index) {}
+
+        template <bool Other>
+            requires(!Other && IsConst)
+        IteratorImpl(const IteratorImpl<Other> &other) noexcept : m_owner(other.m_owner), m_index(other.m_index)
+        {
+        }
+
+        template <bool>
+        friend class IteratorImpl;
+
+        reference operator*() const noexcept { return (*m_owner)[m_index]; }
+        pointer operator->() const noexcept { return &(*m_owner)[m_index]; }
+        reference operator[](difference_type n) const noexcept { return (*m_owner)[m_index + n]; }
+
+        IteratorImpl &operator++() noexcept
+        {
+            ++m_index;
+            return *this;
+        }
+        IteratorImpl operator++(int) noexcept
+        {
+            IteratorImpl it = *this;
+            ++m_index;
+            return it;
+        }
+        IteratorImpl &operator--() noexcept
+        {
+            --m_index;
+            return *this;
+        }
+        IteratorImpl operator--(int) noexcept
+        {
+            IteratorImpl it = *this;
+            --m_index;
+            return it;
+        }
+        IteratorImpl &operator+=(difference_type n) noexcept
+        {
+            m_index += n;
+            return *this;
+        }
+        IteratorImpl &operator-=(difference_type n) noexcept
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        friend IteratorImpl operator+(IteratorImpl it, difference_type n) noexcept { return it += n; }
+        friend IteratorImpl operator+(difference_type n, IteratorImpl it) noexcept { return it += n; }
+        friend IteratorImpl operator-(IteratorImpl it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const IteratorImpl &lhs, const IteratorImpl &rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        template <bool R>
+        bool operator==(const IteratorImpl<R> &other) const noexcept { return m_index == other.m_index; }
+        template <bool R>
+        auto operator<=>(const IteratorImpl<R> &other) const noexcept { return m_index <=> other.m_index; }
+
+    private:
+        container *m_owner;
+        size_t m_index;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static constexpr bool kTrivialDestroy = vector_detail::kTrivialDestroy<T, Allocator>;
+
+    // Current (new) block
+    T *m_data;
+    size_t m_size;
+    size_t m_capacity;
+
+    // Block being drained, nullptr when no migration is in flight
+    T *m_old;
+    size_t m_oldCapacity;
+    size_t m_oldSize;
+    size_t m_migrated;
+    // Elements to move per operation for the current migration
+    size_t m_batch;
+
+    [[no_unique_address]] Allocator m_alloc;
+
+public:
+    /*
+        Constructors
+    */
+    IncrementalVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+        : IncrementalVector(Allocator())
+    {
+    }
+
+    explicit IncrementalVector(const Allocator &alloc) noexcept
+        : m_data(nullptr), m_size(0), m_capacity(0),
+          m_old(nullptr), m_oldCapacity(0), m_oldSize(0), m_migrated(0), m_batch(MigrationBatch),
+          m_alloc(alloc)
+    {
+    }
+
+    IncrementalVector(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : IncrementalVector(alloc)
+    {
+        reserve(init.size());
+        vector_detail::copyElements(m_alloc, m_data, init.begin(), init.size());
+        m_size = init.size();
+    }
+
+    // The copy is settled: one contiguous block of exactly size() elements
+    IncrementalVector(const IncrementalVector &other)
+        : IncrementalVector(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+    }
+
+    IncrementalVector(const IncrementalVector &other, const Allocator &alloc)
+        : IncrementalVector(alloc)
+    {
+        reserve(other.m_size);
+        for (; m_size < other.m_size; ++m_size)
+        {
+            alloc_traits::construct(m_alloc, m_data + m_size, other[m_size]);
+        }
+    }
+
+    IncrementalVector(IncrementalVector &&other) noexcept
+        : IncrementalVector(other.m_alloc)
+    {
+        swapStorage(other);
+    }
+
+    // Steals the blocks when allocators are equal, otherwise moves
+    // element-wise into one settled block
+    IncrementalVector(IncrementalVector &&other, const Allocator &alloc)
+        : IncrementalVector(alloc)
+    {
+        if (m_alloc == other.m_alloc)
+        {
+            swapStorage(other);
+            return;
+        }
+        reserve(other.m_size);
+        for (; m_size < other.m_size; ++m_size)
+        {
+            alloc_traits::construct(m_alloc, m_data + m_size, std::move(other[m_size]));
+        }
+    }
+
+    ~IncrementalVector()
+    {
+        clear();
+        releaseOld();
+        if (m_data)
+        {
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+        }
+    }
+
+    // Like Vector: the temporary is built with the allocator this ends up
+    // owning, so blocks are always freed by the allocator that made them
+    IncrementalVector &operator=(const IncrementalVector &other)
+    {
+        if (this != &other)
+        {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                IncrementalVector tmp(other, other.m_alloc);
+                swapStorage(tmp);
+                // tmp must release our old blocks with our old allocator
+                using std::swap;
+                swap(m_alloc, tmp.m_alloc);
+            }
+            else
+            {
+                IncrementalVector tmp(other, m_alloc);
+                swapStorage(tmp);
+            }
+        }
+        return *this;
+    }
+
+    IncrementalVector &operator=(IncrementalVector &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+        if (this != &other)
+        {
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                IncrementalVector tmp(std::move(other));
+                swapStorage(tmp);
+                using std::swap;
+                swap(m_alloc, tmp.m_alloc);
+            }
+            else
+            {
+                // Element-wise (and possibly throwing) if the allocators differ
+                IncrementalVector tmp(std::move(other), m_alloc);
+                swapStorage(tmp);
+            }
+        }
+        return *this;
+    }
+
+    /*
+        Modifiers
+    */
+    template <typename U>
+    void push_back(U &&element)
+    {
+        emplace_back(std::forward<U>(element));
+    }
+
+    // O(MigrationBatch) moves at most, plus one allocation when a new
+    // migration starts
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (m_size == m_capacity) [[unlikely]]
+        {
+            return startGrowAndEmplace(std::forward<Args>(args)...);
+        }
+        // args may refer to an element of the old block, construct before
+        // the step moves it. The slot lies past every migrated position
+        alloc_traits::construct(m_alloc, m_data + m_size, std::forward<Args>(args)...);
+        if (m_old) [[unlikely]]
+        {
+            try
+            {
+                migrateStep();
+            }
+            catch (...)
+            {
+                if constexpr (!kTrivialDestroy)
+                {
+                    alloc_traits::destroy(m_alloc, m_data + m_size);
+                }
+                throw;
+            }
+        }
+        return m_data[m_size++];
+    }
+
+    void pop_back()
+    {
+        if (m_size == 0)
+        {
+            throw std::out_of_range("pop_back() called on empty vector");
+        }
+
+        const size_t last = m_size - 1;
+        if constexpr (!kTrivialDestroy)
+        {
+            alloc_traits::destroy(m_alloc, &(*this)[last]);
+        }
+        m_size = last;
+
+        if (m_old && last < m_oldSize)
+        {
+            // Popped from the not yet migrated part of the old block
+            m_oldSize = last;
+            if (m_migrated >= m_oldSize)
+            {
+                releaseOld();
+            }
+        }
+    }
+
+    void clear()
+    {
+        if (m_old)
+        {
+            vector_detail::destroyElements(m_alloc, m_data, m_migrated);
+            vector_detail::destroyElements(m_alloc, m_old + m_migrated, m_oldSize - m_migrated);
+            vector_detail::destroyElements(m_alloc, m_data + m_oldSize, m_size - m_oldSize);
+            releaseOld();
+        }
+        else
+        {
+            vector_detail::destroyElements(m_alloc, m_data, m_size);
+        }
+        m_size = 0;
+    }
+
+    // Settles first, then grows in one go like Vector::reserve
+    void reserve(size_t newCapacity)
+    {
+        settle();
+        if (newCapacity <= m_capacity)
+        {
+            return;
+        }
+
+        T *newData = alloc_traits::allocate(m_alloc, newCapacity);
+        try
+        {
+            vector_detail::relocateElements(m_alloc, newData, m_data, m_size);
+        }
+        catch (...)
+        {
+            alloc_traits::deallocate(m_alloc, newData, newCapacity);
+            throw;
+        }
+        if (m_data)
+        {
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+        }
+        m_data = newData;
+        m_capacity = newCapacity;
+    }
+
+    // Finishes any pending migration, afterwards all elements are contiguous
+    void settle()
+    {
+        while (m_old)
+        {
+            migrateStep();
+        }
+    }
+
+    [[nodiscard]] bool migrating() const noexcept { return m_old != nullptr; }
+
+    /*
+        Element access
+    */
+    T &operator[](size_t index) noexcept
+    {
+        assert(index < m_size);
+        if (m_old && index >= m_migrated && index < m_oldSize) [[unlikely]]
+        {
+            return m_old[index];
+        }
+        return m_data[index];
+    }
+
+    const T &operator[](size_t index) const noexcept
+    {
+        assert(index < m_size);
+        if (m_old && index >= m_migrated && index < m_oldSize) [[unlikely]]
+        {
+            return m_old[index];
+        }
+        return m_data[index];
+    }
+
+    T &at(size_t index)
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    const T &at(size_t index) const
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    T &back() noexcept { return (*this)[m_size - 1]; }
+    const T &back() const noexcept { return (*this)[m_size - 1]; }
+
+    // Contiguous view, completes a pending migration first
+    [[nodiscard]] T *data()
+    {
+        settle();
+        return m_data;
+    }
+
+    bool empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    /*
+        Iterators access
+    */
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, m_size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    // Moves the next batch of the old block over, releasing it when drained
+    void migrateStep()
+    {
+        const size_t count = std::min(m_batch, m_oldSize - m_migrated);
+        vector_detail::relocateElements(m_alloc, m_data + m_migrated, m_old + m_migrated, count);
+        m_migrated += count;
+        if (m_migrated == m_oldSize)
+        {
+            releaseOld();
+        }
+    }
+
+    // Allocates the next block and turns the current one into the migration
+    // source. No element is moved here
+    template <typename... Args>
+    VECTOR_COLD_NOINLINE T &startGrowAndEmplace(Args &&...args)
+    {
+        const size_t newCapacity = GrowthPolicy::grow(m_capacity, m_size + 1, sizeof(T));
+        T *newData = alloc_traits::allocate(m_alloc, newCapacity);
+
+        // args may refer to an element, construct before anything changes
+        try
+        {
+            alloc_traits::construct(m_alloc, newData + m_size, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            alloc_traits::deallocate(m_alloc, newData, newCapacity);
+            throw;
+        }
+
+        // Only reachable with a finished migration unless the growth policy
+        // left fewer free slots than batches, in which case drain now
+        try
+        {
+            settle();
+        }
+        catch (...)
+        {
+            if constexpr (!kTrivialDestroy)
+            {
+                alloc_traits::destroy(m_alloc, newData + m_size);
+            }
+            alloc_traits::deallocate(m_alloc, newData, newCapacity);
+            throw;
+        }
+
+        if (m_size > 0)
+        {
+            m_old = m_data;
+            m_oldCapacity = m_capacity;
+            m_oldSize = m_size;
+            m_migrated = 0;
+
+            // Enough per step to drain the old block before the new one fills
+            const size_t freeSlots = newCapacity - m_size - 1;
+            const size_t needed = freeSlots == 0 ? m_size : (m_size + freeSlots - 1) / freeSlots;
+            m_batch = std::max(MigrationBatch, needed);
+        }
+        else if (m_data)
+        {
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+        }
+
+        m_data = newData;
+        m_capacity = newCapacity;
+        return m_data[m_size++];
+    }
+
+    void releaseOld() noexcept
+    {
+        if (m_old)
+        {
+            alloc_traits::deallocate(m_alloc, m_old, m_oldCapacity);
+            m_old = nullptr;
+            m_oldCapacity = 0;
+            m_oldSize = 0;
+            m_migrated = 0;
+        }
+    }
+
+    void swapStorage(IncrementalVector &other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_old, other.m_old);
+        std::swap(m_oldCapacity, other.m_oldCapacity);
+        std::swap(m_oldSize, other.m_oldSize);
+        std::swap(m_migrated, other.m_migrated);
+        std::swap(m_batch, other.m_batch);
+    }
+};
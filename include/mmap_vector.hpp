@@ -0,0 +1,496 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "MmapVector requires POSIX mmap"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+    Vector of trivially copyable elements stored in a memory-mapped file.
+
+        MmapVector<Record> table("records.bin");
+        if (table.empty()) { ... fill once ... }
+        // Next start: contents are available immediately, nothing is read
+        // or copied up front; pages come in on first touch
+
+    The file starts with a 64-byte header (magic, format version, element
+    size/alignment, a user type tag, size, capacity) followed by capacity
+    elements. Growth extends the file with ftruncate and the mapping with
+    mremap (Linux; munmap/mmap elsewhere), following GrowthPolicy like
+    Vector. Reopening checks the header and throws on any mismatch.
+
+    Data reaches the file through the shared mapping; FlushPolicy decides
+    when msync forces it to disk. Pointers, references and iterators are
+    invalidated by growth, like Vector. Extending a file on a full disk
+    surfaces as SIGBUS on first write to the new pages, as with any mmap.
+*/
+
+// Identifies the element type in the file header beyond size/alignment.
+// Specialize with a distinct value per record layout/version
+template <typename T>
+struct mmap_type_tag : std::integral_constant<uint64_t, 0>
+{
+};
+
+enum class MmapOpenMode
+{
+    OpenOrCreate, // keep existing contents, create an empty file otherwise
+    OpenExisting, // throw if the file does not exist
+    Truncate      // start empty, discarding any existing contents
+};
+
+enum class MmapFlushPolicy
+{
+    None,    // leave write-back to the kernel (survives process crashes, not power loss)
+    OnClose, // msync on close()/destruction
+    Always   // msync after every modifying call as well
+};
+
+namespace mmap_detail
+{
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t elementSize;
+        uint32_t elementAlign;
+        uint32_t reserved;
+        uint64_t typeTag;
+        uint64_t size;
+        uint64_t capacity;
+    };
+
+    inline constexpr char kMagic[8] = {'C', 'V', 'E', 'C', 'M', 'M', 'A', 'P'};
+    inline constexpr uint32_t kFormatVersion = 1;
+
+    [[noreturn]] inline void throwErrno(const std::string &what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+}
+
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+class MmapVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "MmapVector stores raw bytes, T must be trivially copyable");
+    static_assert(alignof(T) <= 4096, "MmapVector elements must not need more than page alignment");
+
+public:
+    using value_type = T;
+    using growth_policy = GrowthPolicy;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
+    // Same contiguous iterators as Vector
+    using iterator = typename Vector<T>::iterator;
+    using const_iterator = typename Vector<T>::const_iterator;
+
+    // Elements start on a cache line (or their own alignment if larger)
+    static constexpr size_t kDataOffset =
+        (sizeof(mmap_detail::Header) + std::max<size_t>(64, alignof(T)) - 1) / std::max<size_t>(64, alignof(T)) *
+        std::max<size_t>(64, alignof(T));
+
+private:
+    int m_fd;
+    std::byte *m_map;
+    size_t m_mapped;
+    T *m_data;
+    MmapFlushPolicy m_flush;
+
+public:
+    /*
+        Constructors
+    */
+    explicit MmapVector(const std::string &path, MmapOpenMode mode = MmapOpenMode::OpenOrCreate,
+                        MmapFlushPolicy flush = MmapFlushPolicy::OnClose)
+        : m_fd(-1), m_map(nullptr), m_mapped(0), m_data(nullptr), m_flush(flush)
+    {
+        int flags = O_RDWR | O_CLOEXEC;
+        if (mode == MmapOpenMode::OpenOrCreate)
+        {
+            flags |= O_CREAT;
+        }
+        else if (mode == MmapOpenMode::Truncate)
+        {
+            flags |= O_CREAT | O_TRUNC;
+        }
+
+        m_fd = ::open(path.c_str(), flags, 0644);
+        if (m_fd < 0)
+        {
+            mmap_detail::throwErrno("MmapVector: cannot open " + path);
+        }
+
+        try
+        {
+            attach(path);
+        }
+        catch (...)
+        {
+            unmap();
+            ::close(m_fd);
+            throw;
+        }
+    }
+
+    MmapVector(MmapVector &&other) noexcept
+        : m_fd(std::exchange(other.m_fd, -1)),
+          m_map(std::exchange(other.m_map, nullptr)),
+          m_mapped(std::exchange(other.m_mapped, 0)),
+          m_data(std::exchange(other.m_data, nullptr)),
+          m_flush(other.m_flush)
+    {
+    }
+
+    MmapVector &operator=(MmapVector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            m_fd = std::exchange(other.m_fd, -1);
+            m_map = std::exchange(other.m_map, nullptr);
+            m_mapped = std::exchange(other.m_mapped, 0);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_flush = other.m_flush;
+        }
+        return *this;
+    }
+
+    MmapVector(const MmapVector &) = delete;
+    MmapVector &operator=(const MmapVector &) = delete;
+
+    ~MmapVector()
+    {
+        close();
+    }
+
+    // Flushes according to the policy and releases the file. Idempotent;
+    // the object is closed afterwards and must not be used except to be
+    // assigned or destroyed
+    void close() noexcept
+    {
+        if (m_fd < 0)
+        {
+            return;
+        }
+        if (m_flush != MmapFlushPolicy::None)
+        {
+            ::msync(m_map, m_mapped, MS_SYNC);
+        }
+        unmap();
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_fd >= 0; }
+
+    // Writes every dirty page to disk and waits for it
+    void flush()
+    {
+        if (::msync(m_map, m_mapped, MS_SYNC) != 0)
+        {
+            mmap_detail::throwErrno("MmapVector: msync failed");
+        }
+    }
+
+    [[nodiscard]] MmapFlushPolicy flush_policy() const noexcept { return m_flush; }
+    void set_flush_policy(MmapFlushPolicy flush) noexcept { m_flush = flush; }
+
+    /*
+        Modifiers
+    */
+    void push_back(const T &element)
+    {
+        emplace_back(element);
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        const size_t size = header().size;
+        if (size == header().capacity) [[unlikely]]
+        {
+            // Build first: args may refer to elements about to move
+            T element(std::forward<Args>(args)...);
+            remap(GrowthPolicy::grow(header().capacity, size + 1, sizeof(T)));
+            ::new (static_cast<void *>(m_data + size)) T(element);
+        }
+        else
+        {
+            ::new (static_cast<void *>(m_data + size)) T(std::forward<Args>(args)...);
+        }
+        header().size = size + 1;
+        afterWrite(size, 1);
+        return m_data[size];
+    }
+
+    void pop_back()
+    {
+        if (empty())
+        {
+            throw std::out_of_range("pop_back() called on empty MmapVector");
+        }
+        --header().size;
+        afterWrite(0, 0);
+    }
+
+    void clear() noexcept
+    {
+        header().size = 0;
+        afterWrite(0, 0);
+    }
+
+    // New elements are value-initialized
+    void resize(size_t newSize)
+    {
+        const size_t size = header().size;
+        if (newSize > header().capacity)
+        {
+            remap(GrowthPolicy::grow(header().capacity, newSize, sizeof(T)));
+        }
+        for (size_t i = size; i < newSize; ++i)
+        {
+            ::new (static_cast<void *>(m_data + i)) T();
+        }
+        header().size = newSize;
+        afterWrite(size, newSize > size ? newSize - size : 0);
+    }
+
+    /*
+        Capacity
+    */
+    void reserve(size_t newCapacity)
+    {
+        if (newCapacity > capacity())
+        {
+            remap(newCapacity);
+        }
+    }
+
+    // Truncates the file to the elements in use
+    void shrink_to_fit()
+    {
+        if (size() < capacity())
+        {
+            remap(size());
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return header().size; }
+    [[nodiscard]] size_t capacity() const noexcept { return header().capacity; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /*
+        Element access
+    */
+    T &operator[](size_t index) noexcept { return m_data[index]; }
+    const T &operator[](size_t index) const noexcept { return m_data[index]; }
+
+    T &at(size_t index)
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("MmapVector index out of range");
+        }
+        return m_data[index];
+    }
+
+    const T &at(size_t index) const
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("MmapVector index out of range");
+        }
+        return m_data[index];
+    }
+
+    [[nodiscard]] T *data() noexcept { return m_data; }
+    [[nodiscard]] const T *data() const noexcept { return m_data; }
+
+    /*
+        Iterators
+    */
+    iterator begin() noexcept { return iterator(m_data); }
+    iterator end() noexcept { return iterator(m_data + size()); }
+    const_iterator begin() const noexcept { return const_iterator(m_data); }
+    const_iterator end() const noexcept { return const_iterator(m_data + size()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    mmap_detail::Header &header() noexcept { return *reinterpret_cast<mmap_detail::Header *>(m_map); }
+    const mmap_detail::Header &header() const noexcept { return *reinterpret_cast<const mmap_detail::Header *>(m_map); }
+
+    static size_t fileLength(size_t capacity) noexcept { return kDataOffset + capacity * sizeof(T); }
+
+    // Maps the freshly opened file, writing a header into empty files and
+    // validating the one found otherwise
+    void attach(const std::string &path)
+    {
+        struct stat info;
+        if (::fstat(m_fd, &info) != 0)
+        {
+            mmap_detail::throwErrno("MmapVector: cannot stat " + path);
+        }
+
+        const bool fresh = info.st_size == 0;
+        if (fresh && ::ftruncate(m_fd, static_cast<off_t>(fileLength(0))) != 0)
+        {
+            mmap_detail::throwErrno("MmapVector: cannot size " + path);
+        }
+        if (!fresh && static_cast<size_t>(info.st_size) < kDataOffset)
+        {
+            throw std::runtime_error("MmapVector: " + path + " is too small to hold a header");
+        }
+
+        map(fresh ? fileLength(0) : static_cast<size_t>(info.st_size));
+
+        mmap_detail::Header &h = header();
+        if (fresh)
+        {
+            std::memcpy(h.magic, mmap_detail::kMagic, sizeof(h.magic));
+            h.version = mmap_detail::kFormatVersion;
+            h.elementSize = sizeof(T);
+            h.elementAlign = alignof(T);
+            h.reserved = 0;
+            h.typeTag = mmap_type_tag<T>::value;
+            h.size = 0;
+            h.capacity = 0;
+            return;
+        }
+
+        if (std::memcmp(h.magic, mmap_detail::kMagic, sizeof(h.magic)) != 0)
+        {
+            throw std::runtime_error("MmapVector: " + path + " is not an MmapVector file");
+        }
+        if (h.version != mmap_detail::kFormatVersion)
+        {
+            throw std::runtime_error("MmapVector: " + path + " has an unsupported format version");
+        }
+        if (h.elementSize != sizeof(T) || h.elementAlign != alignof(T) || h.typeTag != mmap_type_tag<T>::value)
+        {
+            throw std::runtime_error("MmapVector: " + path + " holds a different element type");
+        }
+        // Capacity is checked by division: a huge one would wrap fileLength
+        if (h.size > h.capacity || h.capacity > (m_mapped - kDataOffset) / sizeof(T))
+        {
+            throw std::runtime_error("MmapVector: " + path + " is truncated or corrupt");
+        }
+    }
+
+    void map(size_t length)
+    {
+        void *p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (p == MAP_FAILED)
+        {
+            mmap_detail::throwErrno("MmapVector: mmap failed");
+        }
+        m_map = static_cast<std::byte *>(p);
+        m_mapped = length;
+        m_data = reinterpret_cast<T *>(m_map + kDataOffset);
+    }
+
+    void unmap() noexcept
+    {
+        if (m_map != nullptr)
+        {
+            ::munmap(m_map, m_mapped);
+        }
+        m_map = nullptr;
+        m_mapped = 0;
+        m_data = nullptr;
+    }
+
+    // Resizes file and mapping to newCapacity elements. The file is grown
+    // before the mapping and shrunk after it, so no mapped page ever lies
+    // past the end of the file. Strong guarantee
+    void remap(size_t newCapacity)
+    {
+        if (newCapacity > (std::numeric_limits<off_t>::max() - kDataOffset) / sizeof(T))
+        {
+            throw std::length_error("MmapVector capacity exceeds the maximum file size");
+        }
+        const size_t oldLength = m_mapped;
+        const size_t newLength = fileLength(newCapacity);
+
+        if (newLength > oldLength && ::ftruncate(m_fd, static_cast<off_t>(newLength)) != 0)
+        {
+            mmap_detail::throwErrno("MmapVector: cannot grow file");
+        }
+
+#ifdef __linux__
+        void *p = ::mremap(m_map, oldLength, newLength, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED)
+        {
+            const int error = errno;
+            if (newLength > oldLength)
+            {
+                [[maybe_unused]] const int ignored = ::ftruncate(m_fd, static_cast<off_t>(oldLength));
+            }
+            errno = error;
+            mmap_detail::throwErrno("MmapVector: mremap failed");
+        }
+#else
+        // The old mapping stays valid until the new one exists
+        void *p = ::mmap(nullptr, newLength, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (p == MAP_FAILED)
+        {
+            const int error = errno;
+            if (newLength > oldLength)
+            {
+                [[maybe_unused]] const int ignored = ::ftruncate(m_fd, static_cast<off_t>(oldLength));
+            }
+            errno = error;
+            mmap_detail::throwErrno("MmapVector: mmap failed");
+        }
+        ::munmap(m_map, oldLength);
+#endif
+
+        m_map = static_cast<std::byte *>(p);
+        m_mapped = newLength;
+        m_data = reinterpret_cast<T *>(m_map + kDataOffset);
+        header().capacity = newCapacity;
+
+        if (newLength < oldLength)
+        {
+            // Only disk space is at stake, the mapping already shrank
+            [[maybe_unused]] const int ignored = ::ftruncate(m_fd, static_cast<off_t>(newLength));
+        }
+        afterWrite(0, 0);
+    }
+
+    // Under MmapFlushPolicy::Always, syncs the header and the pages holding
+    // elements [first, first + count)
+    void afterWrite(size_t first, size_t count) noexcept
+    {
+        if (m_flush != MmapFlushPolicy::Always)
+        {
+            return;
+        }
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t begin = count == 0 ? 0 : (kDataOffset + first * sizeof(T)) / page * page;
+        const size_t end = count == 0 ? kDataOffset : kDataOffset + (first + count) * sizeof(T);
+        if (begin > 0)
+        {
+            ::msync(m_map, kDataOffset, MS_SYNC);
+        }
+        ::msync(m_map + begin, end - begin, MS_SYNC);
+    }
+};
@@ -0,0 +1,545 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/*
+    Append-only vector of integers compressed in blocks of 128.
+
+        PackedIntVector<uint64_t> stamps;
+        for (...) stamps.push_back(t);          // encoded 128 at a time
+        uint64_t t = stamps[i];                 // random access, no decode
+        Vector<uint64_t> buffer;
+        stamps.for_each_block(buffer, [](std::span<const uint64_t> block) { ... });
+
+    Every full block is stored with its own bit width b, in one of two
+    modes, whichever needs fewer bits:
+      - frame of reference: value - block minimum, in b bits
+      - delta: value - the value L positions earlier (the block's first
+        value for the first L), minus the smallest such delta, in b bits.
+        Sorted IDs and timestamps need a few bits per value.
+    Values arriving after the last full block wait uncompressed in a tail.
+
+    Layout (SIMD-BP128): the payload of a block is b 16-byte vectors of
+    L = 16 / sizeof(T) lanes, value i living in lane i % L. Unpacking a
+    block is then the same shifts and masks on whole vectors, stamped out
+    per bit width, and the delta prefix sum runs down the lanes (one
+    vector add per L values) instead of one add per value. 16-byte vectors
+    are baseline on x86-64 (SSE2) and AArch64 (NEON), so there is no
+    runtime dispatch. Compilers without GCC vector extensions get the same
+    layout decoded one value at a time.
+
+    operator[] extracts one value from a frame-of-reference block in O(1)
+    and sums at most 8 * sizeof(T) deltas down one lane otherwise. Sequential
+    readers should decode whole blocks into a reused Vector<T> instead
+    (for_each_block, decode_block, decode). Values cannot be modified once
+    appended.
+*/
+
+namespace packed_detail
+{
+    constexpr size_t kBlockSize = 128;
+    constexpr size_t kVectorBytes = 16;
+
+    template <typename U>
+    constexpr unsigned kBits = std::numeric_limits<U>::digits;
+
+    // Values per 16-byte vector, and the number of vectors of a block
+    template <typename U>
+    constexpr size_t kLanes = kVectorBytes / sizeof(U);
+
+    template <typename U>
+    constexpr U lowMask(unsigned bits) noexcept
+    {
+        return bits >= kBits<U> ? U(~U(0)) : U((U(1) << bits) - 1);
+    }
+
+    // Value k of a lane in a block packed with `bits` bits per value
+    template <typename U>
+    U extract(const U *payload, size_t lane, size_t k, unsigned bits) noexcept
+    {
+        if (bits == 0)
+        {
+            return 0;
+        }
+        constexpr size_t L = kLanes<U>;
+        const size_t pos = k * bits;
+        const size_t word = pos / kBits<U>;
+        const unsigned shift = static_cast<unsigned>(pos % kBits<U>);
+        U value = U(payload[word * L + lane] >> shift);
+        if (shift + bits > kBits<U>)
+        {
+            value |= U(payload[(word + 1) * L + lane] << (kBits<U> - shift));
+        }
+        return U(value & lowMask<U>(bits));
+    }
+
+    template <typename U>
+    using UnpackFn = void (*)(const U *payload, U *out, U reference, U base) noexcept;
+
+#if defined(__GNUC__) || defined(__clang__)
+    // Fully unrolling unpack doubles decode speed but is most of the
+    // compile time of this header, and far more under sanitizers, which
+    // instrument every unrolled access. Unoptimized and sanitized builds,
+    // and builds defining PACKED_INT_VECTOR_NO_UNROLL (GCC has no macro
+    // for -fsanitize=undefined), keep the loop. PACKED_INT_VECTOR_UNROLL
+    // is private to unpack and undefined right after it
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(undefined_behavior_sanitizer)
+#define PACKED_INT_VECTOR_UNROLL
+#endif
+#endif
+#if !defined(PACKED_INT_VECTOR_UNROLL)
+#if defined(PACKED_INT_VECTOR_NO_UNROLL) || defined(__SANITIZE_ADDRESS__) || !defined(__OPTIMIZE__)
+#define PACKED_INT_VECTOR_UNROLL
+#else
+#define PACKED_INT_VECTOR_UNROLL _Pragma("GCC unroll 64")
+#endif
+#endif
+
+    template <typename U>
+    struct VecOf
+    {
+        typedef U type __attribute__((vector_size(kVectorBytes)));
+    };
+
+    template <typename U>
+    using Vec = typename VecOf<U>::type;
+
+    template <typename U>
+    [[gnu::always_inline]] inline Vec<U> load(const U *p) noexcept
+    {
+        Vec<U> v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    template <typename U>
+    [[gnu::always_inline]] inline void store(U *p, const Vec<U> &v) noexcept
+    {
+        std::memcpy(p, &v, sizeof(v));
+    }
+
+    // Decodes the 128 values of a block packed with Bits bits: every
+    // output vector is shifts of at most two input vectors, then the
+    // reference is added and, for delta blocks, the running lane sums.
+    // With Bits fixed, the unrolled loop has constant shifts and no
+    // branches left
+    template <typename U, unsigned Bits, bool Delta>
+    void unpack(const U *payload, U *out, U reference, U base) noexcept
+    {
+        constexpr unsigned W = kBits<U>;
+        constexpr size_t L = kLanes<U>;
+        const Vec<U> ref = Vec<U>{} + reference;
+        Vec<U> prev = Vec<U>{} + base;
+        PACKED_INT_VECTOR_UNROLL
+        for (unsigned k = 0; k < W; ++k)
+        {
+            Vec<U> v{};
+            if constexpr (Bits > 0)
+            {
+                const unsigned pos = k * Bits;
+                const unsigned shift = pos % W;
+                const U *word = payload + (pos / W) * L;
+                v = load(word) >> shift;
+                if (shift + Bits > W)
+                {
+                    v |= load(word + L) << (W - shift);
+                }
+                if constexpr (Bits < W)
+                {
+                    v &= lowMask<U>(Bits);
+                }
+            }
+            v += ref;
+            if constexpr (Delta)
+            {
+                prev += v;
+                v = prev;
+            }
+            store(out + k * L, v);
+        }
+    }
+#undef PACKED_INT_VECTOR_UNROLL
+
+    // Inverse of unpack for values already below 2^bits, natural order.
+    // Each output vector is filled in a register and stored once
+    template <typename U>
+    void pack(const U *values, U *payload, unsigned bits) noexcept
+    {
+        constexpr unsigned W = kBits<U>;
+        constexpr size_t L = kLanes<U>;
+        Vec<U> word{};
+        unsigned shift = 0;
+        for (unsigned k = 0; bits > 0 && k < W; ++k)
+        {
+            const Vec<U> v = load(values + k * L);
+            word |= v << shift;
+            shift += bits;
+            if (shift >= W)
+            {
+                store(payload, word);
+                payload += L;
+                shift -= W;
+                // High bits of v that did not fit start the next word
+                word = shift > 0 ? v >> (bits - shift) : Vec<U>{};
+            }
+        }
+    }
+#else
+    template <typename U, unsigned Bits, bool Delta>
+    void unpack(const U *payload, U *out, U reference, U base) noexcept
+    {
+        constexpr size_t L = kLanes<U>;
+        for (size_t lane = 0; lane < L; ++lane)
+        {
+            U prev = base;
+            for (size_t k = 0; k < kBits<U>; ++k)
+            {
+                U v = U(extract(payload, lane, k, Bits) + reference);
+                if constexpr (Delta)
+                {
+                    prev = U(prev + v);
+                    v = prev;
+                }
+                out[k * L + lane] = v;
+            }
+        }
+    }
+
+    template <typename U>
+    void pack(const U *values, U *payload, unsigned bits) noexcept
+    {
+        constexpr unsigned W = kBits<U>;
+        constexpr size_t L = kLanes<U>;
+        std::fill(payload, payload + bits * L, U(0));
+        for (size_t i = 0; bits > 0 && i < kBlockSize; ++i)
+        {
+            const size_t lane = i % L;
+            const unsigned pos = static_cast<unsigned>(i / L) * bits;
+            U *word = payload + (pos / W) * L + lane;
+            const unsigned shift = pos % W;
+            word[0] |= U(values[i] << shift);
+            if (shift + bits > W)
+            {
+                word[L] |= U(values[i] >> (W - shift));
+            }
+        }
+    }
+#endif
+
+    // unpack<U, b, Delta> for every width b in [0, bits of U]
+    template <typename U, bool Delta, unsigned... Bits>
+    constexpr auto unpackTable(std::integer_sequence<unsigned, Bits...>)
+    {
+        return std::array<UnpackFn<U>, sizeof...(Bits)>{&unpack<U, Bits, Delta>...};
+    }
+
+    template <typename U, bool Delta>
+    inline constexpr auto kUnpack = unpackTable<U, Delta>(std::make_integer_sequence<unsigned, kBits<U> + 1>{});
+}
+
+template <typename T>
+concept PackableInteger = std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= 8;
+
+template <PackableInteger T, typename Allocator = VectorDefaultAllocator<T>>
+class PackedIntVector
+{
+    // Encoding works on the unsigned type of the same width: wrapping
+    // differences are exact, and signed order only matters for the minima
+    using U = std::make_unsigned_t<T>;
+    using S = std::make_signed_t<T>;
+
+    struct Block
+    {
+        size_t offset; // first payload word
+        U reference;   // added to every unpacked value
+        U base;        // delta blocks: lane sums start here
+        uint8_t bits;
+        bool delta;
+    };
+
+    template <typename X>
+    using rebind = typename std::allocator_traits<Allocator>::template rebind_alloc<X>;
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using allocator_type = Allocator;
+
+    static constexpr size_t kBlockSize = packed_detail::kBlockSize;
+
+    /* Constructors */
+    PackedIntVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+    explicit PackedIntVector(const Allocator &alloc) noexcept
+        : m_blocks(rebind<Block>(alloc)), m_payload(rebind<U>(alloc)), m_tail(alloc)
+    {
+    }
+
+    PackedIntVector(std::initializer_list<T> init, const Allocator &alloc = Allocator()) : PackedIntVector(alloc)
+    {
+        append_range(init);
+    }
+
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    explicit PackedIntVector(R &&range, const Allocator &alloc = Allocator()) : PackedIntVector(alloc)
+    {
+        append_range(std::forward<R>(range));
+    }
+
+    /* Modifiers */
+    void push_back(T value)
+    {
+        m_tail.push_back(value);
+        if (m_tail.size() == kBlockSize)
+        {
+            try
+            {
+                flushTail();
+            }
+            catch (...)
+            {
+                m_tail.pop_back();
+                throw;
+            }
+        }
+    }
+
+    // Full blocks of a contiguous range are encoded straight from it
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void append_range(R &&range)
+    {
+        if constexpr (std::ranges::contiguous_range<R> &&
+                      std::same_as<std::remove_cv_t<std::ranges::range_value_t<R>>, T>)
+        {
+            const T *first = std::ranges::data(range);
+            const T *last = first + std::ranges::distance(range);
+            while (!m_tail.empty() && first != last)
+            {
+                push_back(*first++);
+            }
+            for (; last - first >= static_cast<std::ptrdiff_t>(kBlockSize); first += kBlockSize)
+            {
+                encodeBlock(first);
+            }
+            m_tail.append_range(std::span<const T>(first, last));
+        }
+        else
+        {
+            for (auto &&value : range)
+            {
+                push_back(static_cast<T>(value));
+            }
+        }
+    }
+
+    void clear() noexcept
+    {
+        m_blocks.clear();
+        m_payload.clear();
+        m_tail.clear();
+    }
+
+    void shrink_to_fit()
+    {
+        m_blocks.shrink_to_fit();
+        m_payload.shrink_to_fit();
+    }
+
+    void swap(PackedIntVector &other) noexcept
+    {
+        m_blocks.swap(other.m_blocks);
+        m_payload.swap(other.m_payload);
+        m_tail.swap(other.m_tail);
+    }
+
+    friend void swap(PackedIntVector &lhs, PackedIntVector &rhs) noexcept { lhs.swap(rhs); }
+
+    /* Element access */
+    T operator[](size_t index) const noexcept
+    {
+        const size_t block = index / kBlockSize;
+        if (block == m_blocks.size())
+        {
+            return m_tail[index % kBlockSize];
+        }
+        const Block &header = m_blocks[block];
+        const U *payload = m_payload.data() + header.offset;
+        const size_t lane = index % packed_detail::kLanes<U>;
+        const size_t k = (index % kBlockSize) / packed_detail::kLanes<U>;
+        if (!header.delta)
+        {
+            return static_cast<T>(U(packed_detail::extract(payload, lane, k, header.bits) + header.reference));
+        }
+        U value = header.base;
+        for (size_t i = 0; i <= k; ++i)
+        {
+            value = U(value + packed_detail::extract(payload, lane, i, header.bits) + header.reference);
+        }
+        return static_cast<T>(value);
+    }
+
+    T at(size_t index) const
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("PackedIntVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    /* Decoding */
+    // Blocks, counting the uncompressed tail as the last one
+    size_t block_count() const noexcept { return m_blocks.size() + (m_tail.empty() ? 0 : 1); }
+
+    // Writes the values of one block to out (room for kBlockSize values),
+    // returns how many
+    size_t decode_block(size_t block, T *out) const noexcept
+    {
+        if (block == m_blocks.size())
+        {
+            std::copy(m_tail.begin(), m_tail.end(), out);
+            return m_tail.size();
+        }
+        const Block &header = m_blocks[block];
+        const auto &table = header.delta ? packed_detail::kUnpack<U, true> : packed_detail::kUnpack<U, false>;
+        table[header.bits](m_payload.data() + header.offset, reinterpret_cast<U *>(out), header.reference, header.base);
+        return kBlockSize;
+    }
+
+    // Decodes one block into buffer, reusing its capacity
+    std::span<const T> decode_block(size_t block, Vector<T> &buffer) const
+    {
+        buffer.resize_default_init(kBlockSize);
+        return {buffer.data(), decode_block(block, buffer.data())};
+    }
+
+    // Calls f(std::span<const T>) for every block in order, all decoded
+    // into the same buffer
+    template <typename F>
+    void for_each_block(Vector<T> &buffer, F &&f) const
+    {
+        for (size_t block = 0, n = block_count(); block < n; ++block)
+        {
+            f(decode_block(block, buffer));
+        }
+    }
+
+    // Replaces the contents of out with all values, decoded in place
+    void decode(Vector<T> &out) const
+    {
+        out.resize_default_init(size());
+        for (size_t block = 0, n = block_count(); block < n; ++block)
+        {
+            decode_block(block, out.data() + block * kBlockSize);
+        }
+    }
+
+    Vector<T> to_vector() const
+    {
+        Vector<T> out;
+        decode(out);
+        return out;
+    }
+
+    /* Capacity */
+    size_t size() const noexcept { return m_blocks.size() * kBlockSize + m_tail.size(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // Bytes of encoded data: payload, block headers and the tail
+    size_t compressed_bytes() const noexcept
+    {
+        return m_payload.size() * sizeof(U) + m_blocks.size() * sizeof(Block) + m_tail.size() * sizeof(T);
+    }
+
+    // Uncompressed size over compressed size
+    double compression_ratio() const noexcept
+    {
+        return empty() ? 1.0 : static_cast<double>(size() * sizeof(T)) / static_cast<double>(compressed_bytes());
+    }
+
+private:
+    // Smallest value, and the bits needed for value - smallest, with the
+    // values ordered as K (the signed or unsigned type of the same width)
+    template <typename K>
+    static std::pair<U, unsigned> frame(const U *values) noexcept
+    {
+        const K *keys = reinterpret_cast<const K *>(values);
+        K lo = keys[0];
+        K hi = keys[0];
+        for (size_t i = 1; i < kBlockSize; ++i)
+        {
+            lo = std::min(lo, keys[i]);
+            hi = std::max(hi, keys[i]);
+        }
+        return {U(lo), static_cast<unsigned>(std::bit_width(U(U(hi) - U(lo))))};
+    }
+
+    // Strong guarantee: on exception payload and blocks are unchanged
+    void encodeBlock(const T *input)
+    {
+        constexpr size_t L = packed_detail::kLanes<U>;
+        const U *values = reinterpret_cast<const U *>(input);
+
+        // Deltas to the value one vector earlier; may be negative
+        U deltas[kBlockSize];
+        for (size_t i = 0; i < kBlockSize; ++i)
+        {
+            deltas[i] = U(values[i] - (i < L ? values[0] : values[i - L]));
+        }
+        const auto [forReference, forBits] = frame<std::conditional_t<std::is_signed_v<T>, S, U>>(values);
+        const auto [deltaReference, deltaBits] = frame<S>(deltas);
+
+        const bool delta = deltaBits < forBits;
+        const U reference = delta ? deltaReference : forReference;
+        const unsigned bits = delta ? deltaBits : forBits;
+        const U *source = delta ? deltas : values;
+        U residuals[kBlockSize];
+        for (size_t i = 0; i < kBlockSize; ++i)
+        {
+            residuals[i] = U(source[i] - reference);
+        }
+
+        const size_t offset = m_payload.size();
+        m_payload.resize_default_init(offset + bits * L);
+        try
+        {
+            m_blocks.push_back(Block{offset, reference, values[0], static_cast<uint8_t>(bits), delta});
+        }
+        catch (...)
+        {
+            m_payload.resize_default_init(offset);
+            throw;
+        }
+        packed_detail::pack(residuals, m_payload.data() + offset, bits);
+    }
+
+    void flushTail()
+    {
+        encodeBlock(m_tail.data());
+        m_tail.clear();
+    }
+
+    Vector<Block, rebind<Block>> m_blocks;
+    Vector<U, rebind<U>> m_payload;
+    // Values of the block being filled, fewer than kBlockSize
+    Vector<T, Allocator> m_tail;
+};
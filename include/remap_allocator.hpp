@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "RemapAllocator requires POSIX mmap"
+#endif
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+    Allocator for very large vectors of trivially relocatable elements.
+
+        Vector<double, RemapAllocator<double>> samples;   // grows without copying
+
+    Blocks below ThresholdBytes come from std::allocator. Larger ones are
+    anonymous page-aligned mappings, and Vector grows them through
+    reallocate(), which on Linux calls mremap(MREMAP_MAYMOVE): the kernel
+    extends the mapping in place or moves its page table entries, so growth
+    costs O(pages) bookkeeping instead of an O(bytes) copy and the old and
+    new block never coexist in memory. Crossing the threshold (and every
+    resize on systems without mremap) falls back to allocate + memcpy.
+
+    Vector only calls reallocate() for trivially relocatable element types;
+    anything else still grows element by element through allocate().
+*/
+template <typename T, size_t ThresholdBytes = size_t(1) << 20>
+class RemapAllocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = RemapAllocator<U, ThresholdBytes>;
+    };
+
+    static constexpr size_t kThresholdBytes = ThresholdBytes;
+
+    /*
+        Constructors
+    */
+    RemapAllocator() noexcept = default;
+
+    template <typename U>
+    RemapAllocator(const RemapAllocator<U, ThresholdBytes> &) noexcept
+    {
+    }
+
+    [[nodiscard]] T *allocate(size_t n)
+    {
+        const size_t bytes = byteCount(n);
+        if (!isMapped(bytes))
+        {
+            return std::allocator<T>().allocate(n);
+        }
+
+        void *p = ::mmap(nullptr, pageRound(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, size_t n) noexcept
+    {
+        if (isMapped(n * sizeof(T)))
+        {
+            ::munmap(p, pageRound(n * sizeof(T)));
+        }
+        else
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    // Resizes a block of oldCapacity elements to newCapacity, keeping the
+    // bytes of the first used elements. May move the block; on failure
+    // throws and leaves it untouched
+    [[nodiscard]] T *reallocate(T *p, size_t oldCapacity, size_t newCapacity, size_t used)
+    {
+        const size_t oldBytes = oldCapacity * sizeof(T);
+        const size_t newBytes = byteCount(newCapacity);
+
+#ifdef __linux__
+        if (isMapped(oldBytes) && isMapped(newBytes))
+        {
+            void *q = ::mremap(p, pageRound(oldBytes), pageRound(newBytes), MREMAP_MAYMOVE);
+            if (q == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(q);
+        }
+#endif
+
+        T *q = allocate(newCapacity);
+        std::memcpy(static_cast<void *>(q), static_cast<const void *>(p), std::min(used, newCapacity) * sizeof(T));
+        deallocate(p, oldCapacity);
+        return q;
+    }
+
+    template <typename U>
+    bool operator==(const RemapAllocator<U, ThresholdBytes> &) const noexcept
+    {
+        return true;
+    }
+
+private:
+    static bool isMapped(size_t bytes) noexcept { return bytes > 0 && bytes >= ThresholdBytes; }
+
+    static size_t byteCount(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+    static size_t pageRound(size_t bytes) noexcept
+    {
+        static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+};
@@ -0,0 +1,595 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+
+/*
+    Vector whose elements never move.
+
+        SegmentedVector<Node> nodes;
+        Node &root = nodes.emplace_back();
+        for (...) nodes.push_back(...);   // root, &root and iterators stay valid
+
+    Storage is a table of segments of geometric size: segment k holds
+    kFirstSegmentSize << k elements, so growth allocates one new segment and
+    neither copies nor moves anything, and at most half of the capacity is
+    unused. The segment and offset of an index come from a bit scan, no
+    loop or lookup table: operator[] is a handful of instructions plus one
+    extra load compared to Vector.
+
+    Hot loops should go through chunks() (one std::span per segment, each
+    contiguous, so the compiler vectorizes the inner loop and the SIMD
+    kernels accept them directly) rather than the element iterator.
+
+    References, pointers and iterators are invalidated only by erasing the
+    element itself (pop_back, resize, clear) or by shrink_to_fit. Moving or
+    swapping the container keeps references valid but not iterators.
+*/
+
+namespace segmented_detail
+{
+    // Index math for segments of (1 << FirstShift) << k elements, shared by
+    // SegmentedVector and ConcurrentVector
+    template <size_t FirstShift>
+    struct SegmentIndex
+    {
+        static constexpr size_t kFirstSize = size_t(1) << FirstShift;
+        static constexpr size_t kMaxSegments = std::numeric_limits<size_t>::digits - FirstShift;
+
+        struct Location
+        {
+            size_t segment;
+            size_t offset;
+        };
+
+        static constexpr size_t size(size_t segment) noexcept { return kFirstSize << segment; }
+
+        // Index of the first element of a segment, also the number of
+        // elements in all segments before it
+        static constexpr size_t base(size_t segment) noexcept { return size(segment) - kFirstSize; }
+
+        static constexpr Location locate(size_t index) noexcept
+        {
+            // | 1 tells the compiler the bit scan input is non-zero
+            const size_t biased = index + kFirstSize;
+            const size_t segment = static_cast<size_t>(std::bit_width(biased | 1)) - 1 - FirstShift;
+            return Location{segment, biased - size(segment)};
+        }
+
+        // Whether index is the first slot of its segment. Spelled out since
+        // std::has_single_bit is a popcount libcall without -mpopcnt
+        static constexpr bool startsSegment(size_t index) noexcept
+        {
+            const size_t biased = index + kFirstSize;
+            return (biased & (biased - 1)) == 0;
+        }
+    };
+}
+
+template <typename T, typename Allocator = VectorDefaultAllocator<T>>
+class SegmentedVector
+{
+public:
+    static constexpr size_t kFirstSegmentShift = 4;
+
+private:
+    using Index = segmented_detail::SegmentIndex<kFirstSegmentShift>;
+
+public:
+    static constexpr size_t kFirstSegmentSize = Index::kFirstSize;
+    static constexpr size_t kMaxSegments = Index::kMaxSegments;
+
+    // Random access over the segment table; stepping within a segment is a
+    // pointer increment, crossing into the next one a bit scan
+    template <bool IsConst>
+    class IteratorImpl
+    {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const T &, T &>;
+        using pointer = std::conditional_t<IsConst, const T *, T *>;
+
+    private:
+        T *const *m_segments;
+        size_t m_index;
+        pointer m_ptr;
+
+        friend class SegmentedVector;
+        friend class IteratorImpl<!IsConst>;
+
+        IteratorImpl(T *const *segments, size_t index) noexcept
+            : m_segments(segments), m_index(index), m_ptr(resolve(segments, index))
+        {
+        }
+
+        // Slot of index, or nullptr past the allocated segments (end())
+        static pointer resolve(T *const *segments, size_t index) noexcept
+        {
+            const auto [segment, offset] = Index::locate(index);
+            T *elements = segment < kMaxSegments ? segments[segment] : nullptr;
+            return elements != nullptr ? elements + offset : nullptr;
+        }
+
+    public:
+        IteratorImpl() noexcept : m_segments(nullptr), m_index(0), m_ptr(nullptr) {}
+
+        // iterator converts to const_iterator
+        template <bool OtherConst>
+            requires(IsConst && !OtherConst)
+        IteratorImpl(const IteratorImpl<OtherConst> &other) noexcept
+            : m_segments(other.m_segments), m_index(other.m_index), m_ptr(other.m_ptr)
+        {
+        }
+
+        reference operator*() const noexcept { return *m_ptr; }
+        pointer operator->() const noexcept { return m_ptr; }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return *resolve(m_segments, m_index + static_cast<size_t>(n));
+        }
+
+        // Position in the container
+        [[nodiscard]] size_t index() const noexcept { return m_index; }
+
+        IteratorImpl &operator++() noexcept
+        {
+            ++m_index;
+            if (Index::startsSegment(m_index))
+            {
+                m_ptr = resolve(m_segments, m_index);
+            }
+            else
+            {
+                ++m_ptr;
+            }
+            return *this;
+        }
+
+        IteratorImpl operator++(int) noexcept
+        {
+            IteratorImpl old = *this;
+            ++*this;
+            return old;
+        }
+
+        IteratorImpl &operator--() noexcept
+        {
+            const bool crossing = Index::startsSegment(m_index);
+            --m_index;
+            m_ptr = crossing ? resolve(m_segments, m_index) : m_ptr - 1;
+            return *this;
+        }
+
+        IteratorImpl operator--(int) noexcept
+        {
+            IteratorImpl old = *this;
+            --*this;
+            return old;
+        }
+
+        IteratorImpl &operator+=(difference_type n) noexcept
+        {
+            m_index += static_cast<size_t>(n);
+            m_ptr = resolve(m_segments, m_index);
+            return *this;
+        }
+
+        IteratorImpl &operator-=(difference_type n) noexcept { return *this += -n; }
+
+        friend IteratorImpl operator+(IteratorImpl it, difference_type n) noexcept { return it += n; }
+        friend IteratorImpl operator+(difference_type n, IteratorImpl it) noexcept { return it += n; }
+        friend IteratorImpl operator-(IteratorImpl it, difference_type n) noexcept { return it -= n; }
+
+        friend difference_type operator-(const IteratorImpl &a, const IteratorImpl &b) noexcept
+        {
+            return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+        }
+
+        friend bool operator==(const IteratorImpl &a, const IteratorImpl &b) noexcept { return a.m_index == b.m_index; }
+        friend auto operator<=>(const IteratorImpl &a, const IteratorImpl &b) noexcept { return a.m_index <=> b.m_index; }
+    };
+
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    T *m_segments[kMaxSegments];
+    size_t m_segmentCount;
+    size_t m_size;
+    Allocator m_alloc;
+
+public:
+    /*
+        Constructors
+    */
+    SegmentedVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+        : SegmentedVector(Allocator())
+    {
+    }
+
+    explicit SegmentedVector(const Allocator &alloc) noexcept
+        : m_segments{}, m_segmentCount(0), m_size(0), m_alloc(alloc)
+    {
+    }
+
+    SegmentedVector(std::initializer_list<T> init)
+        : SegmentedVector()
+    {
+        reserve(init.size());
+        for (const T &element : init)
+        {
+            emplace_back(element);
+        }
+    }
+
+    // Segment layouts match, so each chunk is copied in one go. If a copy
+    // throws the delegating constructor has finished and the destructor
+    // releases what was built
+    SegmentedVector(const SegmentedVector &other)
+        : SegmentedVector(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+    }
+
+    SegmentedVector(const SegmentedVector &other, const Allocator &alloc)
+        : SegmentedVector(alloc)
+    {
+        reserve(other.m_size);
+        for (size_t segment = 0; segment < other.chunk_count(); ++segment)
+        {
+            const size_t count = other.chunkSize(segment);
+            vector_detail::copyElements(m_alloc, m_segments[segment], other.m_segments[segment], count);
+            m_size += count;
+        }
+    }
+
+    SegmentedVector(SegmentedVector &&other) noexcept
+        : SegmentedVector(other.m_alloc)
+    {
+        swapStorage(other);
+    }
+
+    // Steals the segments when allocators are equal, otherwise moves
+    // chunk by chunk into segments of alloc
+    SegmentedVector(SegmentedVector &&other, const Allocator &alloc)
+        : SegmentedVector(alloc)
+    {
+        if (m_alloc == other.m_alloc)
+        {
+            swapStorage(other);
+            return;
+        }
+        reserve(other.m_size);
+        for (size_t segment = 0; segment < other.chunk_count(); ++segment)
+        {
+            const size_t count = other.chunkSize(segment);
+            vector_detail::moveElements(m_alloc, m_segments[segment], other.m_segments[segment], count);
+            m_size += count;
+        }
+    }
+
+    ~SegmentedVector()
+    {
+        clear();
+        releaseSegments(0);
+    }
+
+    // Like Vector: the temporary is built with the allocator this ends up
+    // owning, so segments are always freed by the allocator that made them
+    SegmentedVector &operator=(const SegmentedVector &other)
+    {
+        if (this != &other)
+        {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                SegmentedVector tmp(other, other.m_alloc);
+                swapStorage(tmp);
+                // tmp must release our old segments with our old allocator
+                using std::swap;
+                swap(m_alloc, tmp.m_alloc);
+            }
+            else
+            {
+                SegmentedVector tmp(other, m_alloc);
+                swapStorage(tmp);
+            }
+        }
+        return *this;
+    }
+
+    SegmentedVector &operator=(SegmentedVector &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+        if (this != &other)
+        {
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                SegmentedVector tmp(std::move(other));
+                swapStorage(tmp);
+                using std::swap;
+                swap(m_alloc, tmp.m_alloc);
+            }
+            else
+            {
+                // Element-wise (and possibly throwing) if the allocators differ
+                SegmentedVector tmp(std::move(other), m_alloc);
+                swapStorage(tmp);
+            }
+        }
+        return *this;
+    }
+
+    void swap(SegmentedVector &other) noexcept
+    {
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+        }
+        else
+        {
+            assert(m_alloc == other.m_alloc);
+        }
+        swapStorage(other);
+    }
+
+    friend void swap(SegmentedVector &a, SegmentedVector &b) noexcept
+    {
+        a.swap(b);
+    }
+
+    /*
+        Modifiers
+    */
+    void push_back(const T &element)
+    {
+        emplace_back(element);
+    }
+
+    void push_back(T &&element)
+    {
+        emplace_back(std::move(element));
+    }
+
+    // Nothing moves on growth, so args may refer to elements of this
+    // container. Strong guarantee
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (m_size == capacity()) [[unlikely]]
+        {
+            addSegment();
+        }
+        T *slot = address(m_size);
+        alloc_traits::construct(m_alloc, slot, std::forward<Args>(args)...);
+        ++m_size;
+        return *slot;
+    }
+
+    void pop_back()
+    {
+        if (m_size == 0)
+        {
+            throw std::out_of_range("pop_back() called on empty SegmentedVector");
+        }
+        --m_size;
+        alloc_traits::destroy(m_alloc, address(m_size));
+    }
+
+    // Destroys the elements, keeps the segments
+    void clear() noexcept
+    {
+        for (size_t segment = chunk_count(); segment-- > 0;)
+        {
+            vector_detail::destroyElements(m_alloc, m_segments[segment], chunkSize(segment));
+        }
+        m_size = 0;
+    }
+
+    // New elements are value-initialized (or copies of value). Strong
+    // guarantee when growing
+    void resize(size_t newSize)
+    {
+        resizeWith(newSize, [this] { emplace_back(); });
+    }
+
+    void resize(size_t newSize, const T &value)
+    {
+        resizeWith(newSize, [this, &value] { emplace_back(value); });
+    }
+
+    /*
+        Capacity
+    */
+    void reserve(size_t newCapacity)
+    {
+        while (capacity() < newCapacity)
+        {
+            addSegment();
+        }
+    }
+
+    // Frees the segments past the last element
+    void shrink_to_fit() noexcept
+    {
+        releaseSegments(chunk_count());
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return Index::base(m_segmentCount); }
+
+    [[nodiscard]] size_t max_size() const noexcept
+    {
+        return std::min<size_t>(alloc_traits::max_size(m_alloc), std::numeric_limits<difference_type>::max());
+    }
+
+    allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    /*
+        Element access
+    */
+    T &operator[](size_t index) noexcept { return *address(index); }
+    const T &operator[](size_t index) const noexcept { return *address(index); }
+
+    T &at(size_t index)
+    {
+        checkIndex(index);
+        return *address(index);
+    }
+
+    const T &at(size_t index) const
+    {
+        checkIndex(index);
+        return *address(index);
+    }
+
+    T &front() { return at(0); }
+    const T &front() const { return at(0); }
+    T &back() { return at(m_size - 1); }
+    const T &back() const { return at(m_size - 1); }
+
+    /*
+        Chunks: the used part of each segment, in order
+    */
+    [[nodiscard]] size_t chunk_count() const noexcept
+    {
+        return m_size == 0 ? 0 : Index::locate(m_size - 1).segment + 1;
+    }
+
+    std::span<T> chunk(size_t segment) noexcept
+    {
+        return std::span<T>(m_segments[segment], chunkSize(segment));
+    }
+
+    std::span<const T> chunk(size_t segment) const noexcept
+    {
+        return std::span<const T>(m_segments[segment], chunkSize(segment));
+    }
+
+    // for (std::span<T> c : v.chunks()) for (T &x : c) ...
+    auto chunks() noexcept
+    {
+        return std::views::iota(size_t(0), chunk_count()) |
+               std::views::transform([this](size_t segment) { return chunk(segment); });
+    }
+
+    auto chunks() const noexcept
+    {
+        return std::views::iota(size_t(0), chunk_count()) |
+               std::views::transform([this](size_t segment) { return chunk(segment); });
+    }
+
+    /*
+        Iterators
+    */
+    iterator begin() noexcept { return iterator(m_segments, 0); }
+    iterator end() noexcept { return iterator(m_segments, m_size); }
+    const_iterator begin() const noexcept { return const_iterator(m_segments, 0); }
+    const_iterator end() const noexcept { return const_iterator(m_segments, m_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    T *address(size_t index) const noexcept
+    {
+        const auto [segment, offset] = Index::locate(index);
+        return m_segments[segment] + offset;
+    }
+
+    // Elements in use in a segment below chunk_count()
+    size_t chunkSize(size_t segment) const noexcept
+    {
+        return std::min(Index::size(segment), m_size - Index::base(segment));
+    }
+
+    void checkIndex(size_t index) const
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("SegmentedVector index out of range");
+        }
+    }
+
+    void addSegment()
+    {
+        if (m_segmentCount == kMaxSegments || Index::size(m_segmentCount) > max_size() - capacity())
+        {
+            throw std::length_error("SegmentedVector exceeds max_size()");
+        }
+        m_segments[m_segmentCount] = alloc_traits::allocate(m_alloc, Index::size(m_segmentCount));
+        ++m_segmentCount;
+    }
+
+    // Exchanges the segments but not the allocators
+    void swapStorage(SegmentedVector &other) noexcept
+    {
+        std::swap_ranges(std::begin(m_segments), std::end(m_segments), std::begin(other.m_segments));
+        std::swap(m_segmentCount, other.m_segmentCount);
+        std::swap(m_size, other.m_size);
+    }
+
+    // Frees segments [keep, m_segmentCount), which must hold no elements
+    void releaseSegments(size_t keep) noexcept
+    {
+        while (m_segmentCount > keep)
+        {
+            --m_segmentCount;
+            alloc_traits::deallocate(m_alloc, m_segments[m_segmentCount], Index::size(m_segmentCount));
+            m_segments[m_segmentCount] = nullptr;
+        }
+    }
+
+    template <typename Append>
+    void resizeWith(size_t newSize, Append append)
+    {
+        if (newSize <= m_size)
+        {
+            while (m_size > newSize)
+            {
+                pop_back();
+            }
+            return;
+        }
+
+        const size_t oldSize = m_size;
+        reserve(newSize);
+        try
+        {
+            while (m_size < newSize)
+            {
+                append();
+            }
+        }
+        catch (...)
+        {
+            while (m_size > oldSize)
+            {
+                pop_back();
+            }
+            throw;
+        }
+    }
+};
@@ -0,0 +1,434 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <cstddef>
+
+// Vector with room for N elements inside the object itself.
+// Up to N elements no heap allocation happens at all; beyond that the
+// elements spill to an allocator-owned block and growth continues
+// exactly like Vector, following GrowthPolicy.
+template <typename T, size_t N, typename Allocator = VectorDefaultAllocator<T>, typename GrowthPolicy = DoublingGrowth>
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector needs at least one inline slot, use Vector otherwise");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
+    // Same contiguous iterators as Vector
+    using iterator = typename Vector<T, Allocator>::iterator;
+    using const_iterator = typename Vector<T, Allocator>::const_iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_t inline_capacity = N;
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename alloc_traits::pointer, T *>,
+                  "Allocator::pointer must be T*");
+
+    static constexpr bool kTrivialDestroy = vector_detail::kTrivialDestroy<T, Allocator>;
+
+    T *m_data;
+    size_t m_size;
+    size_t m_capacity;
+    [[no_unique_address]] Allocator m_alloc;
+    alignas(T) std::byte m_inline[N * sizeof(T)];
+
+    T *inlineData() noexcept { return reinterpret_cast<T *>(m_inline); }
+    const T *inlineData() const noexcept { return reinterpret_cast<const T *>(m_inline); }
+
+public:
+    /*
+        Constructors
+    */
+    SmallVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+        : m_data(inlineData()), m_size(0), m_capacity(N), m_alloc()
+    {
+    }
+
+    explicit SmallVector(const Allocator &alloc) noexcept
+        : m_data(inlineData()), m_size(0), m_capacity(N), m_alloc(alloc)
+    {
+    }
+
+    SmallVector(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : SmallVector(alloc)
+    {
+        reserve(init.size());
+        vector_detail::copyElements(m_alloc, m_data, init.begin(), init.size());
+        m_size = init.size();
+    }
+
+    SmallVector(const SmallVector &other)
+        : SmallVector(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+    }
+
+    SmallVector(const SmallVector &other, const Allocator &alloc)
+        : SmallVector(alloc)
+    {
+        reserve(other.m_size);
+        vector_detail::copyElements(m_alloc, m_data, other.m_data, other.m_size);
+        m_size = other.m_size;
+    }
+
+    // Heap blocks are stolen, inline elements are relocated into our buffer
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : SmallVector(other.m_alloc)
+    {
+        takeFrom(other);
+    }
+
+    ~SmallVector()
+    {
+        vector_detail::destroyElements(m_alloc, m_data, m_size);
+        releaseHeap();
+    }
+
+    // Copy-and-swap, see Vector::operator=: the copy is made with the
+    // allocator *this ends up with
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+        {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                SmallVector tmp(other, other.m_alloc);
+                replaceWith<true>(tmp);
+            }
+            else
+            {
+                SmallVector tmp(other, m_alloc);
+                replaceWith<false>(tmp);
+            }
+        }
+        return *this;
+    }
+
+    // Allocates only when the allocator neither propagates nor compares
+    // equal, see Vector::operator=
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                         (alloc_traits::propagate_on_container_move_assignment::value ||
+                                                          alloc_traits::is_always_equal::value))
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if constexpr (!alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            if (!other.isInline() && m_alloc != other.m_alloc)
+            {
+                // Block belongs to another allocator, fall back to moving elements
+                clear();
+                reserve(other.m_size);
+                vector_detail::moveElements(m_alloc, m_data, other.m_data, other.m_size);
+                m_size = other.m_size;
+                other.clear();
+                return *this;
+            }
+        }
+        replaceWith<alloc_traits::propagate_on_container_move_assignment::value>(other);
+        return *this;
+    }
+
+    // Never allocates: heap blocks trade places, inline elements are
+    // relocated. Allocators must propagate or compare equal, as for Vector
+    void swap(SmallVector &other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this == &other)
+        {
+            return;
+        }
+
+        constexpr bool propagate = alloc_traits::propagate_on_container_swap::value;
+        if constexpr (!propagate)
+        {
+            assert(m_alloc == other.m_alloc);
+        }
+
+        if (!isInline() && !other.isInline())
+        {
+            if constexpr (propagate)
+            {
+                using std::swap;
+                swap(m_alloc, other.m_alloc);
+            }
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+            return;
+        }
+
+        // At least one side lives in its inline buffer, whose address
+        // cannot change hands. Elements go through relocateElements, so
+        // trivially relocatable types are swapped bytewise
+        SmallVector tmp(std::move(other));
+        if constexpr (propagate)
+        {
+            other.m_alloc = m_alloc;
+        }
+        other.takeFrom(*this);
+        if constexpr (propagate)
+        {
+            m_alloc = tmp.m_alloc;
+        }
+        takeFrom(tmp);
+    }
+
+    friend void swap(SmallVector &lhs, SmallVector &rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <typename U>
+    void push_back(U &&element)
+    {
+        emplace_back(std::forward<U>(element));
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (m_size < m_capacity) [[likely]]
+        {
+            alloc_traits::construct(m_alloc, m_data + m_size, std::forward<Args>(args)...);
+            return m_data[m_size++];
+        }
+        return growAndEmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void pop_back()
+    {
+        if (m_size == 0)
+        {
+            throw std::out_of_range("pop_back() called on empty vector");
+        }
+
+        m_size--;
+
+        if constexpr (!kTrivialDestroy)
+        {
+            alloc_traits::destroy(m_alloc, m_data + m_size);
+        }
+    }
+
+    T &at(size_t index)
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("Index out of range");
+        }
+
+        return m_data[index];
+    }
+
+    const T &at(const size_t index) const
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("Index out of range");
+        }
+
+        return m_data[index];
+    }
+
+    T &operator[](const size_t index)
+    {
+        assert(index < m_size);
+        return m_data[index];
+    }
+
+    const T &operator[](const size_t index) const
+    {
+        assert(index < m_size);
+        return m_data[index];
+    }
+
+    void clear()
+    {
+        vector_detail::destroyElements(m_alloc, m_data, m_size);
+        m_size = 0;
+    }
+
+    void reserve(const size_t newCapacity)
+    {
+        if (newCapacity > m_capacity)
+        {
+            grow(newCapacity);
+        }
+    }
+
+    // Returns to the inline buffer when the elements fit in it again
+    void shrink_to_fit()
+    {
+        if (isInline() || m_capacity == m_size)
+        {
+            return;
+        }
+
+        if (m_size <= N)
+        {
+            relocateTo(inlineData(), N);
+        }
+        else
+        {
+            relocateTo(alloc_traits::allocate(m_alloc, m_size), m_size);
+        }
+    }
+
+    // True while no heap block is in use
+    [[nodiscard]] bool isInline() const noexcept { return m_data == inlineData(); }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    [[nodiscard]] T *data() { return m_data; }
+    [[nodiscard]] const T *data() const { return m_data; }
+
+    bool empty() const { return m_size == 0; }
+
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    /*
+        Iterators access
+    */
+    iterator begin() noexcept { return iterator(m_data); }
+    iterator end() noexcept { return iterator(m_data + m_size); }
+
+    const_iterator begin() const noexcept { return const_iterator(m_data); }
+    const_iterator end() const noexcept { return const_iterator(m_data + m_size); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+private:
+    // Out-of-line growth path of emplace_back, see Vector::reallocateAndEmplace
+    template <typename... Args>
+    VECTOR_COLD_NOINLINE T &growAndEmplaceBack(Args &&...args)
+    {
+        // element may live in the current storage, build it in the new
+        // block before the old elements are relocated away
+        const size_t newCapacity = GrowthPolicy::grow(m_capacity, m_size + 1, sizeof(T));
+        T *newData = alloc_traits::allocate(m_alloc, newCapacity);
+        try
+        {
+            alloc_traits::construct(m_alloc, newData + m_size, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            alloc_traits::deallocate(m_alloc, newData, newCapacity);
+            throw;
+        }
+
+        try
+        {
+            vector_detail::relocateElements(m_alloc, newData, m_data, m_size);
+        }
+        catch (...)
+        {
+            if constexpr (!kTrivialDestroy)
+            {
+                alloc_traits::destroy(m_alloc, newData + m_size);
+            }
+            alloc_traits::deallocate(m_alloc, newData, newCapacity);
+            throw;
+        }
+
+        releaseHeap();
+        m_data = newData;
+        m_capacity = newCapacity;
+        return m_data[m_size++];
+    }
+
+    void grow(size_t newCapacity)
+    {
+        relocateTo(alloc_traits::allocate(m_alloc, newCapacity), newCapacity);
+    }
+
+    // Relocates all elements into newData (inline buffer or a fresh heap
+    // block of newCapacity) and releases the current heap block, if any.
+    // Strong guarantee: a throwing move leaves *this untouched
+    void relocateTo(T *newData, size_t newCapacity)
+    {
+        const bool toHeap = newData != inlineData();
+        try
+        {
+            vector_detail::relocateElements(m_alloc, newData, m_data, m_size);
+        }
+        catch (...)
+        {
+            if (toHeap)
+            {
+                alloc_traits::deallocate(m_alloc, newData, newCapacity);
+            }
+            throw;
+        }
+
+        releaseHeap();
+        m_data = newData;
+        m_capacity = newCapacity;
+    }
+
+    void releaseHeap() noexcept
+    {
+        if (!isInline())
+        {
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+            m_data = inlineData();
+            m_capacity = N;
+        }
+    }
+
+    // Drops the current elements and takes other's, adopting its
+    // allocator when Propagate. Allocators compatible otherwise
+    template <bool Propagate>
+    void replaceWith(SmallVector &other)
+    {
+        clear();
+        releaseHeap();
+        if constexpr (Propagate)
+        {
+            m_alloc = other.m_alloc;
+        }
+        takeFrom(other);
+    }
+
+    // Precondition: *this is empty and inline, allocators compatible
+    void takeFrom(SmallVector &other)
+    {
+        if (other.isInline())
+        {
+            vector_detail::relocateElements(m_alloc, m_data, other.m_data, other.m_size);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        else
+        {
+            m_data = std::exchange(other.m_data, other.inlineData());
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, N);
+        }
+    }
+};
@@ -0,0 +1,795 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+/*
+    Struct-of-arrays vector: one contiguous column per field.
+
+        SoAVector<float, float, int> particles;   // x, y, id
+        particles.push_back(1.0f, 2.0f, 7);
+        float sumX = vector_algorithms::reduce(particles.column<0>());
+
+    All columns live in one allocation, each starting on its own cache
+    line, and share a single size/capacity that grows through GrowthPolicy
+    exactly like Vector (with the whole row as element size). A pass that
+    reads two fields out of twelve only touches those two columns. Growth
+    keeps the strong guarantee, so every field has to be nothrow movable,
+    copyable or trivially relocatable.
+
+    Rows are accessed through proxy references: operator[] and the
+    iterators yield std::tuple<Field &...>, which reads and assigns like the
+    row itself and converts to value_type (std::tuple<Field...>). Const
+    access yields a tuple of const references (soa_detail::ConstRowRef).
+*/
+
+namespace soa_detail
+{
+    // What const SoAVector access yields. A plain std::tuple of const
+    // references and std::tuple<Fields...> convert both ways, so in C++20
+    // they have no common reference and the const iterator would not be
+    // indirectly_readable. This tuple names one, see basic_common_reference
+    // below
+    template <typename... Fields>
+    struct ConstRowRef : std::tuple<const Fields &...>
+    {
+        using std::tuple<const Fields &...>::tuple;
+    };
+}
+
+template <typename... Fields, typename... Us, template <typename> class TQual, template <typename> class UQual>
+    requires std::convertible_to<UQual<std::tuple<Us...>>, soa_detail::ConstRowRef<Fields...>>
+struct std::basic_common_reference<soa_detail::ConstRowRef<Fields...>, std::tuple<Us...>, TQual, UQual>
+{
+    using type = soa_detail::ConstRowRef<Fields...>;
+};
+
+template <typename... Us, typename... Fields, template <typename> class TQual, template <typename> class UQual>
+    requires std::convertible_to<TQual<std::tuple<Us...>>, soa_detail::ConstRowRef<Fields...>>
+struct std::basic_common_reference<std::tuple<Us...>, soa_detail::ConstRowRef<Fields...>, TQual, UQual>
+{
+    using type = soa_detail::ConstRowRef<Fields...>;
+};
+
+// Structured bindings see the tuple
+template <typename... Fields>
+struct std::tuple_size<soa_detail::ConstRowRef<Fields...>> : std::integral_constant<size_t, sizeof...(Fields)>
+{
+};
+
+template <size_t I, typename... Fields>
+struct std::tuple_element<I, soa_detail::ConstRowRef<Fields...>>
+    : std::tuple_element<I, std::tuple<const Fields &...>>
+{
+};
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+class BasicSoAVector
+{
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+    static_assert((std::is_object_v<Fields> && ...), "SoAVector fields must be object types");
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields &...>;
+    using const_reference = soa_detail::ConstRowRef<Fields...>;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    static constexpr size_t kFields = sizeof...(Fields);
+    static constexpr size_t kColumnAlignment = 64;
+    // Bytes of one row over all columns, the element size GrowthPolicy sees
+    static constexpr size_t kRowBytes = (sizeof(Fields) + ...);
+
+    // Random access over rows with proxy references
+    template <bool IsConst>
+    class IteratorImpl
+    {
+    public:
+        // Rows are yielded as tuples of references by value, which the
+        // C++17 categories above input do not allow
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = BasicSoAVector::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const_reference, BasicSoAVector::reference>;
+        using container = std::conditional_t<IsConst, const BasicSoAVector, BasicSoAVector>;
+
+        IteratorImpl() noexcept : m_owner(nullptr), m_index(0) {}
+        IteratorImpl(container *owner, size_t index) noexcept : m_owner(owner), m_index(index) {}
+
+        template <bool Other>
+            requires(!Other && IsConst)
+        IteratorImpl(const IteratorImpl<Other> &other) noexcept : m_owner(other.m_owner), m_index(other.m_index)
+        {
+        }
+
+        template <bool>
+        friend class IteratorImpl;
+
+        reference operator*() const noexcept { return (*m_owner)[m_index]; }
+        reference operator[](difference_type n) const noexcept { return (*m_owner)[m_index + n]; }
+
+        // Row index, handy to address other columns
+        size_t index() const noexcept { return m_index; }
+
+        IteratorImpl &operator++() noexcept
+        {
+            ++m_index;
+            return *this;
+        }
+        IteratorImpl operator++(int) noexcept
+        {
+            IteratorImpl it = *this;
+            ++m_index;
+            return it;
+        }
+        IteratorImpl &operator--() noexcept
+        {
+            --m_index;
+            return *this;
+        }
+        IteratorImpl operator--(int) noexcept
+        {
+            IteratorImpl it = *this;
+            --m_index;
+            return it;
+        }
+        IteratorImpl &operator+=(difference_type n) noexcept
+        {
+            m_index += n;
+            return *this;
+        }
+        IteratorImpl &operator-=(difference_type n) noexcept
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        friend IteratorImpl operator+(IteratorImpl it, difference_type n) noexcept { return it += n; }
+        friend IteratorImpl operator+(difference_type n, IteratorImpl it) noexcept { return it += n; }
+        friend IteratorImpl operator-(IteratorImpl it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const IteratorImpl &lhs, const IteratorImpl &rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        template <bool R>
+        bool operator==(const IteratorImpl<R> &other) const noexcept { return m_index == other.m_index; }
+        template <bool R>
+        auto operator<=>(const IteratorImpl<R> &other) const noexcept { return m_index <=> other.m_index; }
+
+    private:
+        container *m_owner;
+        size_t m_index;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+
+private:
+    // Blocks are allocated in whole cache lines so every column can start on one
+    struct alignas(kColumnAlignment) CacheLine
+    {
+        std::byte bytes[kColumnAlignment];
+    };
+
+    using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<CacheLine>;
+    using block_traits = std::allocator_traits<block_allocator>;
+
+    template <typename F>
+    using field_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<F>;
+
+    using Columns = std::tuple<Fields *...>;
+
+    static constexpr std::array<size_t, kFields> kFieldSizes = {sizeof(Fields)...};
+
+    // Moves of these fields may throw: they are copied during growth so a
+    // failure leaves the old columns untouched
+    template <typename F>
+    static constexpr bool kCopyOnGrowth = !vector_detail::kTrivialRelocate<F, field_allocator<F>> &&
+                                          !std::is_nothrow_move_constructible_v<F> &&
+                                          std::is_copy_constructible_v<F>;
+
+    // A move-only field whose move may throw could fail halfway through
+    // growth with no copy to fall back on
+    static_assert(((vector_detail::kTrivialRelocate<Fields, field_allocator<Fields>> ||
+                    std::is_nothrow_move_constructible_v<Fields> || std::is_copy_constructible_v<Fields>) &&
+                   ...),
+                  "SoAVector fields must be nothrow movable, copyable or trivially relocatable");
+
+    Columns m_columns;
+    CacheLine *m_block;
+    size_t m_size;
+    size_t m_capacity;
+    [[no_unique_address]] block_allocator m_alloc;
+
+public:
+    /*
+        Constructors
+    */
+    BasicSoAVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+        : BasicSoAVector(Allocator())
+    {
+    }
+
+    explicit BasicSoAVector(const Allocator &alloc) noexcept
+        : m_columns(), m_block(nullptr), m_size(0), m_capacity(0), m_alloc(alloc)
+    {
+    }
+
+    BasicSoAVector(const BasicSoAVector &other)
+        : BasicSoAVector(other, Allocator(block_traits::select_on_container_copy_construction(other.m_alloc)))
+    {
+    }
+
+    BasicSoAVector(const BasicSoAVector &other, const Allocator &alloc) : BasicSoAVector(alloc)
+    {
+        constructFrom(other);
+    }
+
+    BasicSoAVector(BasicSoAVector &&other) noexcept
+        : m_columns(std::exchange(other.m_columns, Columns())),
+          m_block(std::exchange(other.m_block, nullptr)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_capacity(std::exchange(other.m_capacity, 0)),
+          m_alloc(other.m_alloc)
+    {
+    }
+
+    // Steals the block if the allocators are equal, else moves the rows
+    // into a block of alloc and leaves other's rows moved-from
+    BasicSoAVector(BasicSoAVector &&other, const Allocator &alloc) : BasicSoAVector(alloc)
+    {
+        if (m_alloc == other.m_alloc)
+        {
+            swapStorage(other);
+        }
+        else
+        {
+            constructFrom(std::move(other));
+        }
+    }
+
+    ~BasicSoAVector()
+    {
+        clear();
+        releaseBlock();
+    }
+
+    // Copy-and-swap, see Vector::operator=
+    BasicSoAVector &operator=(const BasicSoAVector &other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if constexpr (block_traits::propagate_on_container_copy_assignment::value)
+        {
+            BasicSoAVector tmp(other, Allocator(other.m_alloc));
+            swapStorage(tmp);
+            using std::swap;
+            swap(m_alloc, tmp.m_alloc);
+        }
+        else
+        {
+            BasicSoAVector tmp(other, Allocator(m_alloc));
+            swapStorage(tmp);
+        }
+        return *this;
+    }
+
+    BasicSoAVector &operator=(BasicSoAVector &&other) noexcept(block_traits::propagate_on_container_move_assignment::value ||
+                                                               block_traits::is_always_equal::value)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if constexpr (block_traits::propagate_on_container_move_assignment::value)
+        {
+            BasicSoAVector tmp(std::move(other));
+            swapStorage(tmp);
+            using std::swap;
+            swap(m_alloc, tmp.m_alloc);
+        }
+        else
+        {
+            BasicSoAVector tmp(std::move(other), Allocator(m_alloc));
+            swapStorage(tmp);
+        }
+        return *this;
+    }
+
+    void swap(BasicSoAVector &other) noexcept
+    {
+        if constexpr (block_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+        }
+        else
+        {
+            assert(m_alloc == other.m_alloc);
+        }
+        swapStorage(other);
+    }
+
+    friend void swap(BasicSoAVector &lhs, BasicSoAVector &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    /*
+        Modifiers
+    */
+    // One argument per field, each constructs its field in place
+    template <typename... Args>
+        requires(sizeof...(Args) == kFields && (std::constructible_from<Fields, Args &&> && ...))
+    reference emplace_back(Args &&...args)
+    {
+        if (m_size == m_capacity) [[unlikely]]
+        {
+            growAndEmplaceBack(std::forward<Args>(args)...);
+        }
+        else
+        {
+            constructRow(m_columns, m_size, std::forward<Args>(args)...);
+        }
+        ++m_size;
+        return (*this)[m_size - 1];
+    }
+
+    template <typename... Args>
+        requires(sizeof...(Args) == kFields && (std::constructible_from<Fields, Args &&> && ...))
+    void push_back(Args &&...args)
+    {
+        emplace_back(std::forward<Args>(args)...);
+    }
+
+    void push_back(const value_type &row)
+    {
+        std::apply([this](const Fields &...fields)
+                   { emplace_back(fields...); }, row);
+    }
+
+    void push_back(value_type &&row)
+    {
+        std::apply([this](Fields &...fields)
+                   { emplace_back(std::move(fields)...); }, row);
+    }
+
+    void pop_back()
+    {
+        if (m_size == 0)
+        {
+            throw std::out_of_range("pop_back() called on empty SoAVector");
+        }
+        --m_size;
+        destroyRows(m_size, 1);
+    }
+
+    void clear() noexcept
+    {
+        destroyRows(0, m_size);
+        m_size = 0;
+    }
+
+    // New rows are value-initialized; strong guarantee
+    void resize(size_t newSize)
+    {
+        if (newSize <= m_size)
+        {
+            destroyRows(newSize, m_size - newSize);
+            m_size = newSize;
+            return;
+        }
+
+        if (newSize > m_capacity)
+        {
+            reallocate(GrowthPolicy::grow(m_capacity, newSize, kRowBytes));
+        }
+        size_t row = m_size;
+        try
+        {
+            for (; row < newSize; ++row)
+            {
+                constructRow(m_columns, row, Fields()...);
+            }
+        }
+        catch (...)
+        {
+            destroyRows(m_size, row - m_size);
+            throw;
+        }
+        m_size = newSize;
+    }
+
+    /*
+        Capacity
+    */
+    void reserve(size_t newCapacity)
+    {
+        if (newCapacity > m_capacity)
+        {
+            reallocate(newCapacity);
+        }
+    }
+
+    void shrink_to_fit()
+    {
+        if (m_size == m_capacity)
+        {
+            return;
+        }
+        if (m_size == 0)
+        {
+            releaseBlock();
+            return;
+        }
+        reallocate(m_size);
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] static constexpr size_t max_size() noexcept
+    {
+        return std::numeric_limits<size_t>::max() / 2 / (kRowBytes + kFields * kColumnAlignment);
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_type(m_alloc); }
+
+    /*
+        Element access
+    */
+    reference operator[](size_t index) noexcept { return row<reference>(m_columns, index); }
+    const_reference operator[](size_t index) const noexcept { return row<const_reference>(m_columns, index); }
+
+    reference at(size_t index)
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("SoAVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    const_reference at(size_t index) const
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("SoAVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+    const_reference front() const noexcept { return (*this)[0]; }
+    reference back() noexcept { return (*this)[m_size - 1]; }
+    const_reference back() const noexcept { return (*this)[m_size - 1]; }
+
+    // Contiguous view of one field; valid until the next reallocation.
+    // Directly usable with vector_algorithms
+    template <size_t I>
+    std::span<field_type<I>> column() noexcept
+    {
+        return std::span<field_type<I>>(std::get<I>(m_columns), m_size);
+    }
+
+    template <size_t I>
+    std::span<const field_type<I>> column() const noexcept
+    {
+        return std::span<const field_type<I>>(std::get<I>(m_columns), m_size);
+    }
+
+    template <size_t I>
+    field_type<I> *data() noexcept { return std::get<I>(m_columns); }
+
+    template <size_t I>
+    const field_type<I> *data() const noexcept { return std::get<I>(m_columns); }
+
+    /*
+        Iterators
+    */
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, m_size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    template <typename F>
+    static void forEachField(F &&f)
+    {
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (f(std::integral_constant<size_t, I>{}), ...);
+        }(std::index_sequence_for<Fields...>{});
+    }
+
+    template <typename Ref, typename Cols>
+    static Ref row(const Cols &columns, size_t index) noexcept
+    {
+        return std::apply([index](auto *...column)
+                          { return Ref(column[index]...); }, columns);
+    }
+
+    // Bytes taken by one column of capacity rows, padded to a cache line
+    static size_t columnBytes(size_t field, size_t capacity) noexcept
+    {
+        return (capacity * kFieldSizes[field] + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+    }
+
+    static size_t blockLines(size_t capacity) noexcept
+    {
+        size_t bytes = 0;
+        for (size_t field = 0; field < kFields; ++field)
+        {
+            bytes += columnBytes(field, capacity);
+        }
+        return bytes / kColumnAlignment;
+    }
+
+    static Columns carve(CacheLine *block, size_t capacity) noexcept
+    {
+        std::array<std::byte *, kFields> starts{};
+        std::byte *next = reinterpret_cast<std::byte *>(block);
+        for (size_t field = 0; field < kFields; ++field)
+        {
+            starts[field] = next;
+            next += columnBytes(field, capacity);
+        }
+        return [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            return Columns(reinterpret_cast<Fields *>(starts[I])...);
+        }(std::index_sequence_for<Fields...>{});
+    }
+
+    CacheLine *allocateBlock(size_t capacity)
+    {
+        if (capacity > max_size())
+        {
+            throw std::length_error("SoAVector capacity exceeds max_size()");
+        }
+        return block_traits::allocate(m_alloc, blockLines(capacity));
+    }
+
+    void deallocateBlock(CacheLine *block, size_t capacity) noexcept
+    {
+        block_traits::deallocate(m_alloc, block, blockLines(capacity));
+    }
+
+    // Copies the rows of other, or moves them from an rvalue, into a new
+    // block of this (empty) vector's allocator
+    template <typename Other>
+    void constructFrom(Other &&other)
+    {
+        if (other.m_size == 0)
+        {
+            return;
+        }
+
+        CacheLine *block = allocateBlock(other.m_size);
+        const Columns columns = carve(block, other.m_size);
+        std::array<bool, kFields> constructed{};
+        try
+        {
+            forEachField([&](auto I)
+                         {
+                using F = field_type<I>;
+                field_allocator<F> alloc(m_alloc);
+                if constexpr (std::is_rvalue_reference_v<Other &&>)
+                {
+                    vector_detail::moveElements(alloc, std::get<I>(columns), std::get<I>(other.m_columns), other.m_size);
+                }
+                else
+                {
+                    vector_detail::copyElements(alloc, std::get<I>(columns), std::get<I>(other.m_columns), other.m_size);
+                }
+                constructed[I] = true; });
+        }
+        catch (...)
+        {
+            forEachField([&](auto I)
+                         {
+                if (constructed[I])
+                {
+                    destroyColumn<I>(columns, 0, other.m_size);
+                } });
+            deallocateBlock(block, other.m_size);
+            throw;
+        }
+
+        adopt(block, columns, other.m_size);
+        m_size = other.m_size;
+    }
+
+    // Exchanges the rows but not the allocators
+    void swapStorage(BasicSoAVector &other) noexcept
+    {
+        std::swap(m_columns, other.m_columns);
+        std::swap(m_block, other.m_block);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+    void adopt(CacheLine *block, const Columns &columns, size_t capacity) noexcept
+    {
+        m_block = block;
+        m_columns = columns;
+        m_capacity = capacity;
+    }
+
+    void releaseBlock() noexcept
+    {
+        if (m_block != nullptr)
+        {
+            deallocateBlock(m_block, m_capacity);
+        }
+        adopt(nullptr, Columns(), 0);
+    }
+
+    template <size_t I>
+    void destroyColumn(const Columns &columns, size_t first, size_t count) noexcept
+    {
+        using F = field_type<I>;
+        field_allocator<F> alloc(m_alloc);
+        vector_detail::destroyElements(alloc, std::get<I>(columns) + first, count);
+    }
+
+    void destroyRows(size_t first, size_t count) noexcept
+    {
+        forEachField([&](auto I)
+                     { destroyColumn<I>(m_columns, first, count); });
+    }
+
+    // Constructs field I of the row from the I-th argument. On exception
+    // the fields built so far are destroyed again
+    template <typename... Args>
+    void constructRow(const Columns &columns, size_t index, Args &&...args)
+    {
+        auto values = std::forward_as_tuple(std::forward<Args>(args)...);
+        size_t built = 0;
+        try
+        {
+            forEachField([&](auto I)
+                         {
+                using F = field_type<I>;
+                field_allocator<F> alloc(m_alloc);
+                std::allocator_traits<field_allocator<F>>::construct(alloc, std::get<I>(columns) + index,
+                                                                     std::get<I>(std::move(values)));
+                ++built; });
+        }
+        catch (...)
+        {
+            forEachField([&](auto I)
+                         {
+                if (I < built)
+                {
+                    destroyColumn<I>(columns, index, 1);
+                } });
+            throw;
+        }
+    }
+
+    // Moves every column into the new columns. Strong
+    // guarantee: fields whose move may throw are copied first, the rest are
+    // relocated only once nothing can fail anymore
+    void transferTo(const Columns &columns)
+    {
+        std::array<bool, kFields> copied{};
+        try
+        {
+            forEachField([&](auto I)
+                         {
+                using F = field_type<I>;
+                if constexpr (kCopyOnGrowth<F>)
+                {
+                    field_allocator<F> alloc(m_alloc);
+                    vector_detail::copyElements(alloc, std::get<I>(columns), std::get<I>(m_columns), m_size);
+                    copied[I] = true;
+                } });
+        }
+        catch (...)
+        {
+            forEachField([&](auto I)
+                         {
+                if (copied[I])
+                {
+                    destroyColumn<I>(columns, 0, m_size);
+                } });
+            throw;
+        }
+
+        forEachField([&](auto I)
+                     {
+            using F = field_type<I>;
+            if constexpr (kCopyOnGrowth<F>)
+            {
+                destroyColumn<I>(m_columns, 0, m_size);
+            }
+            else
+            {
+                field_allocator<F> alloc(m_alloc);
+                vector_detail::relocateElements(alloc, std::get<I>(columns), std::get<I>(m_columns), m_size);
+            } });
+    }
+
+    void reallocate(size_t newCapacity)
+    {
+        CacheLine *block = allocateBlock(newCapacity);
+        const Columns columns = carve(block, newCapacity);
+        try
+        {
+            transferTo(columns);
+        }
+        catch (...)
+        {
+            deallocateBlock(block, newCapacity);
+            throw;
+        }
+        if (m_block != nullptr)
+        {
+            deallocateBlock(m_block, m_capacity);
+        }
+        adopt(block, columns, newCapacity);
+    }
+
+    // The new row is built before the old columns move, so arguments may
+    // refer to rows of this vector
+    template <typename... Args>
+    VECTOR_COLD_NOINLINE void growAndEmplaceBack(Args &&...args)
+    {
+        const size_t newCapacity = GrowthPolicy::grow(m_capacity, m_size + 1, kRowBytes);
+        CacheLine *block = allocateBlock(newCapacity);
+        const Columns columns = carve(block, newCapacity);
+
+        try
+        {
+            constructRow(columns, m_size, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocateBlock(block, newCapacity);
+            throw;
+        }
+
+        try
+        {
+            transferTo(columns);
+        }
+        catch (...)
+        {
+            forEachField([&](auto I)
+                         { destroyColumn<I>(columns, m_size, 1); });
+            deallocateBlock(block, newCapacity);
+            throw;
+        }
+
+        if (m_block != nullptr)
+        {
+            deallocateBlock(m_block, m_capacity);
+        }
+        adopt(block, columns, newCapacity);
+    }
+};
+
+template <typename... Fields>
+using SoAVector = BasicSoAVector<VectorDefaultAllocator<std::byte>, DoublingGrowth, Fields...>;
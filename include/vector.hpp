@@ -1,12 +1,31 @@
 #pragma once
 
-#include <iostream>
+#include <ostream>
 #include <stdexcept>
 #include <utility>
 #include <cassert>
 #include <type_traits>
 #include <concepts>
 #include <cstring>
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <iterator>
+#include <ranges>
+
+#include "growth_policy.hpp"
+
+// -DVECTOR_INSTRUMENTATION routes every Vector through the instrumented
+// allocator, see vector_instrumentation.hpp
+#ifdef VECTOR_INSTRUMENTATION
+#include "vector_instrumentation.hpp"
+template <typename T>
+using VectorDefaultAllocator = instrumented::Allocator<T>;
+#else
+template <typename T>
+using VectorDefaultAllocator = std::allocator<T>;
+#endif
 
 template <typename T>
 concept TriviallyCopyConstructible = std::is_trivially_copy_constructible_v<T>;
@@ -23,17 +42,466 @@ concept TriviallyMoveAssignable = std::is_trivially_move_assignable_v<T>;
 template <typename T>
 concept TriviallyDestructible = std::is_trivially_destructible_v<T>;
 
+// Marks slow paths (reallocation) so they are laid out away from the
+// hot code of the callers and never inlined into them
+#if defined(__GNUC__) || defined(__clang__)
+#define VECTOR_COLD_NOINLINE [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define VECTOR_COLD_NOINLINE __declspec(noinline)
+#else
+#define VECTOR_COLD_NOINLINE
+#endif
+
+// Opt-in trait in the spirit of P1144: a type is trivially relocatable if
+// moving it to a new address and destroying the source is equivalent to a
+// memcpy of its bytes (the source is then simply forgotten).
+// Specialize for own handle types that hold no pointers into themselves.
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+{
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::vector<T>> : std::true_type
+{
+};
+
+template <typename A, typename B>
+struct is_trivially_relocatable<std::pair<A, B>>
+    : std::bool_constant<is_trivially_relocatable<A>::value && is_trivially_relocatable<B>::value>
+{
+};
+
+// Note: std::string is deliberately left out. libstdc++ keeps a pointer to
+// its own small-string buffer, so its bytes cannot be moved around.
+
 template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+template <typename T>
+concept TriviallyRelocatable = is_trivially_relocatable_v<T>;
+
+// Allocators whose construct()/destroy() are plain placement new / ~T().
+// Only for those the memcpy/memmove and skip-destructor fast paths are valid
+template <typename Alloc>
+struct is_transparent_allocator : std::false_type
+{
+};
+
+template <typename U>
+struct is_transparent_allocator<std::allocator<U>> : std::true_type
+{
+};
+
+template <typename U>
+struct is_transparent_allocator<std::pmr::polymorphic_allocator<U>> : std::true_type
+{
+};
+
+template <typename Alloc, typename T>
+concept TransparentAllocator =
+    (is_transparent_allocator<Alloc>::value && !std::uses_allocator_v<T, Alloc>) ||
+    (!requires(Alloc &a, T *p, const T &v) { a.construct(p, v); } &&
+     !requires(Alloc &a, T *p) { a.destroy(p); });
+
+// Element-management helpers shared by every container built on raw
+// allocator storage (Vector, SmallVector). All of them work on
+// uninitialized destination memory and give the strong guarantee:
+// on exception every element constructed so far is destroyed again.
+namespace vector_detail
+{
+    // memcpy/memmove and skipping destructors are only valid if the allocator
+    // would have done plain placement new / ~T() anyway
+    template <typename T, typename Alloc>
+    inline constexpr bool kTrivialCopy = TriviallyCopyConstructible<T> && TransparentAllocator<Alloc, T>;
+
+    template <typename T, typename Alloc>
+    inline constexpr bool kTrivialMove = TriviallyMoveConstructible<T> && TransparentAllocator<Alloc, T>;
+
+    template <typename T, typename Alloc>
+    inline constexpr bool kTrivialDestroy = TriviallyDestructible<T> && TransparentAllocator<Alloc, T>;
+
+    template <typename T, typename Alloc>
+    inline constexpr bool kTrivialRelocate = TriviallyRelocatable<T> && TransparentAllocator<Alloc, T>;
+
+    // Instrumentation hooks (see vector_instrumentation.hpp). Only called if
+    // the allocator provides them, otherwise they compile to nothing
+    template <typename Alloc>
+    constexpr void noteCopied(Alloc &alloc, size_t count)
+    {
+        if constexpr (requires { alloc.on_elements_copied(count); })
+        {
+            alloc.on_elements_copied(count);
+        }
+    }
+
+    template <typename Alloc>
+    constexpr void noteMoved(Alloc &alloc, size_t count)
+    {
+        if constexpr (requires { alloc.on_elements_moved(count); })
+        {
+            alloc.on_elements_moved(count);
+        }
+    }
+
+    template <typename Alloc>
+    constexpr void noteReallocate(Alloc &alloc, size_t size, size_t oldCapacity, size_t newCapacity)
+    {
+        if constexpr (requires { alloc.on_reallocate(size, oldCapacity, newCapacity); })
+        {
+            alloc.on_reallocate(size, oldCapacity, newCapacity);
+        }
+    }
+
+    template <typename Alloc>
+    constexpr void noteRelease(Alloc &alloc, size_t size, size_t capacity)
+    {
+        if constexpr (requires { alloc.on_release(size, capacity); })
+        {
+            alloc.on_release(size, capacity);
+        }
+    }
+
+    template <typename Alloc, typename T>
+    constexpr void destroyElements(Alloc &alloc, T *data, size_t count)
+    {
+        if constexpr (!kTrivialDestroy<T, Alloc>)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::allocator_traits<Alloc>::destroy(alloc, data + i);
+            }
+        }
+    }
+
+    // Runs element construction on several threads. Installed per thread by
+    // vector_parallel::ParallelConstructionScope, null means serial
+    struct ParallelExecutor
+    {
+        using ChunkFn = void (*)(void *context, size_t chunk);
+
+        // Calls chunk(context, c) for every c in [0, chunks) and returns once
+        // all are done. Once a chunk throws, the rest may be skipped; the
+        // first exception is rethrown at the end
+        void (*run)(ParallelExecutor &self, size_t chunks, ChunkFn chunk, void *context);
+        // Smallest element count worth splitting
+        size_t threshold;
+        size_t concurrency;
+    };
+
+    inline ParallelExecutor *&currentParallelExecutor() noexcept
+    {
+        static thread_local ParallelExecutor *executor = nullptr;
+        return executor;
+    }
+
+    // Constructs dest[i] with construct(dest + i, i) for i in [0, count) on
+    // the current executor, if any and count is large enough. Same strong
+    // guarantee as the serial loops: a chunk that throws destroys what it
+    // built, then the elements of every finished chunk are destroyed and
+    // the first exception is rethrown.
+    // Only for transparent allocators, whose construct is placement new and
+    // therefore safe to call concurrently. Returns false if nothing was done
+    template <typename Alloc, typename T, typename Construct>
+    bool constructInParallel(Alloc &alloc, T *dest, size_t count, const Construct &construct)
+    {
+        ParallelExecutor *executor = currentParallelExecutor();
+        if constexpr (!TransparentAllocator<Alloc, T>)
+        {
+            return false;
+        }
+        else if (executor == nullptr || executor->concurrency < 2 || count < executor->threshold)
+        {
+            return false;
+        }
+        else
+        {
+            const size_t chunks = std::min(count, executor->concurrency * 4);
+            const auto chunkBegin = [&](size_t c) { return count / chunks * c + std::min(c, count % chunks); };
+
+            std::unique_ptr<bool[]> built(new bool[chunks]());
+            auto body = [&](size_t c)
+            {
+                const size_t begin = chunkBegin(c);
+                const size_t end = chunkBegin(c + 1);
+                size_t i = begin;
+                try
+                {
+                    for (; i < end; ++i)
+                    {
+                        construct(dest + i, i);
+                    }
+                }
+                catch (...)
+                {
+                    destroyElements(alloc, dest + begin, i - begin);
+                    throw;
+                }
+                built[c] = true;
+            };
+
+            try
+            {
+                executor->run(*executor, chunks, [](void *context, size_t c)
+                              { (*static_cast<decltype(body) *>(context))(c); }, &body);
+            }
+            catch (...)
+            {
+                for (size_t c = 0; c < chunks; ++c)
+                {
+                    if (built[c])
+                    {
+                        destroyElements(alloc, dest + chunkBegin(c), chunkBegin(c + 1) - chunkBegin(c));
+                    }
+                }
+                throw;
+            }
+            return true;
+        }
+    }
+
+    template <typename Alloc, typename T>
+    constexpr void copyElements(Alloc &alloc, T *dest, const T *src, size_t count)
+    {
+        noteCopied(alloc, count);
+        if constexpr (kTrivialCopy<T, Alloc>)
+        {
+            // memcpy for trivially copy constructible types, except in
+            // constant evaluation which only allows construct_at
+            if (!std::is_constant_evaluated())
+            {
+                if (count > 0)
+                {
+                    std::memcpy(dest, src, count * sizeof(T));
+                }
+                return;
+            }
+        }
+        else if (!std::is_constant_evaluated() &&
+                 constructInParallel(alloc, dest, count, [&](T *p, size_t i)
+                                     { std::allocator_traits<Alloc>::construct(alloc, p, src[i]); }))
+        {
+            return;
+        }
+
+        size_t i = 0;
+        try
+        {
+            for (; i < count; ++i)
+            {
+                std::allocator_traits<Alloc>::construct(alloc, dest + i, src[i]);
+            }
+        }
+        catch (...)
+        {
+            destroyElements(alloc, dest, i);
+            throw;
+        }
+    }
+
+    template <typename Alloc, typename T>
+    constexpr void moveElements(Alloc &alloc, T *dest, T *src, size_t count)
+    {
+        noteMoved(alloc, count);
+        if constexpr (kTrivialMove<T, Alloc>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                if (count > 0)
+                {
+                    std::memmove(dest, src, count * sizeof(T));
+                }
+                return;
+            }
+        }
+
+        size_t i = 0;
+        try
+        {
+            for (; i < count; ++i)
+            {
+                std::allocator_traits<Alloc>::construct(alloc, dest + i, std::move(src[i]));
+            }
+        }
+        catch (...)
+        {
+            destroyElements(alloc, dest, i);
+            throw;
+        }
+    }
+
+    // Endless sequence of one value, lets insert(pos, n, value) and
+    // assign(n, value) share the range code paths
+    template <typename T>
+    struct RepeatIterator
+    {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = const T &;
+        using pointer = const T *;
+
+        const T *value;
+
+        constexpr const T &operator*() const noexcept { return *value; }
+        constexpr const T &operator[](std::ptrdiff_t) const noexcept { return *value; }
+        constexpr RepeatIterator &operator++() noexcept { return *this; }
+        constexpr RepeatIterator operator++(int) noexcept { return *this; }
+        constexpr bool operator==(const RepeatIterator &) const noexcept = default;
+    };
+
+    template <typename It>
+    inline constexpr bool kIsRepeatIterator = false;
+
+    template <typename T>
+    inline constexpr bool kIsRepeatIterator<RepeatIterator<T>> = true;
+
+    // Copy-constructs count elements read from an iterator (any type with
+    // * and ++) into uninitialized dest. Contiguous sources of trivially
+    // copyable types become a single memcpy. Only contiguous sources and
+    // fill values may be read from several threads: other iterators (e.g.
+    // a transform view with a stateful functor) are always evaluated in
+    // order on the calling thread
+    template <typename Alloc, typename T, typename It>
+    constexpr void constructFromRange(Alloc &alloc, T *dest, It first, size_t count)
+    {
+        if constexpr (std::contiguous_iterator<It> && std::same_as<std::iter_value_t<It>, T>)
+        {
+            copyElements(alloc, dest, std::to_address(first), count);
+        }
+        else
+        {
+            noteCopied(alloc, count);
+            if constexpr (std::contiguous_iterator<It> || kIsRepeatIterator<It>)
+            {
+                if (!std::is_constant_evaluated() &&
+                    constructInParallel(alloc, dest, count, [&](T *p, size_t i)
+                                        { std::allocator_traits<Alloc>::construct(alloc, p, first[static_cast<std::ptrdiff_t>(i)]); }))
+                {
+                    return;
+                }
+            }
+
+            size_t i = 0;
+            try
+            {
+                for (; i < count; ++i, ++first)
+                {
+                    std::allocator_traits<Alloc>::construct(alloc, dest + i, *first);
+                }
+            }
+            catch (...)
+            {
+                destroyElements(alloc, dest, i);
+                throw;
+            }
+        }
+    }
+
+    // Legacy iterator categorisation, so iterators that only provide the
+    // classic member typedefs still count as multi-pass
+    template <typename It>
+    concept ForwardIterator = std::is_base_of_v<std::forward_iterator_tag,
+                                                typename std::iterator_traits<It>::iterator_category>;
+
+    template <typename It>
+    constexpr It advanceBy(It it, size_t n)
+    {
+        if constexpr (requires { it += std::ptrdiff_t{}; })
+        {
+            it += static_cast<std::ptrdiff_t>(n);
+        }
+        else
+        {
+            for (; n > 0; --n)
+            {
+                ++it;
+            }
+        }
+        return it;
+    }
+
+    // Copy-assigns count elements read from first onto live elements
+    template <typename T, typename It>
+    constexpr void assignFromRange(T *dest, It first, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i, ++first)
+        {
+            dest[i] = *first;
+        }
+    }
+
+    // Move-constructs count elements into dest and destroys the sources.
+    // Trivially relocatable types are transferred with a single memmove and
+    // no destructor runs on the old storage. On exception the sources are
+    // left untouched
+    template <typename Alloc, typename T>
+    constexpr void relocateElements(Alloc &alloc, T *dest, T *src, size_t count)
+    {
+        if constexpr (kTrivialRelocate<T, Alloc>)
+        {
+            noteMoved(alloc, count);
+            if (std::is_constant_evaluated())
+            {
+                // No memmove at compile time, and pointers into different
+                // blocks cannot be compared to pick a direction: go through
+                // a scratch block, which is correct for any overlap
+                using traits = std::allocator_traits<Alloc>;
+                T *scratch = traits::allocate(alloc, count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    traits::construct(alloc, scratch + i, std::move(src[i]));
+                    traits::destroy(alloc, src + i);
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    traits::construct(alloc, dest + i, std::move(scratch[i]));
+                    traits::destroy(alloc, scratch + i);
+                }
+                traits::deallocate(alloc, scratch, count);
+            }
+            else if (count > 0)
+            {
+                std::memmove(static_cast<void *>(dest), static_cast<const void *>(src), count * sizeof(T));
+            }
+        }
+        else
+        {
+            moveElements(alloc, dest, src, count);
+            destroyElements(alloc, src, count);
+        }
+    }
+}
+
+template <typename T, typename Allocator = VectorDefaultAllocator<T>, typename GrowthPolicy = DoublingGrowth>
 class Vector
 {
 public:
-    // Follows LegacyRandomAccessIterator style
+    // LegacyRandomAccessIterator for pre-C++20 code, std::contiguous_iterator
+    // for ranges, std::span and the memmove/memcmp paths of std algorithms
     template <bool IsConst>
     class VectorIteratorImpl
     {
     public:
         using iterator_category = typename std::random_access_iterator_tag;
-        using value_type = typename std::remove_cv<T>;
+        using iterator_concept = std::contiguous_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using element_type = std::conditional_t<IsConst, const T, T>;
         using difference_type = std::ptrdiff_t;
         using reference = typename std::conditional<IsConst, const T &, T &>::type;
         using pointer = typename std::conditional<IsConst, const T *, T *>::type;
@@ -45,9 +513,9 @@ public:
         /*
             Constructors
         */
-        VectorIteratorImpl() : m_ptr(nullptr) {}
+        constexpr VectorIteratorImpl() : m_ptr(nullptr) {}
 
-        explicit VectorIteratorImpl(pointer ptr) noexcept : m_ptr(ptr) {}
+        explicit constexpr VectorIteratorImpl(pointer ptr) noexcept : m_ptr(ptr) {}
 
         // Need to grant access to other for copy ctor
         template <bool OtherIsConst>
@@ -56,79 +524,79 @@ public:
         // Only available from non-const to const iterator
         template <bool Other>
             requires(!Other && IsConst)
-        VectorIteratorImpl(const VectorIteratorImpl<Other> &other) noexcept : m_ptr(other.m_ptr)
+        constexpr VectorIteratorImpl(const VectorIteratorImpl<Other> &other) noexcept : m_ptr(other.m_ptr)
         {
         }
 
-        VectorIteratorImpl &operator++() noexcept
+        constexpr VectorIteratorImpl &operator++() noexcept
         {
             m_ptr++;
             return *this;
         }
-        VectorIteratorImpl operator++(int) noexcept
+        constexpr VectorIteratorImpl operator++(int) noexcept
         {
             VectorIteratorImpl iterator = *this;
             ++(*this);
             return iterator;
         }
 
-        VectorIteratorImpl &operator--() noexcept
+        constexpr VectorIteratorImpl &operator--() noexcept
         {
             m_ptr--;
             return *this;
         }
 
-        VectorIteratorImpl operator--(int) noexcept
+        constexpr VectorIteratorImpl operator--(int) noexcept
         {
             VectorIteratorImpl iterator = *this;
             --(*this);
             return iterator;
         }
 
-        VectorIteratorImpl &operator+=(const difference_type offset) noexcept
+        constexpr VectorIteratorImpl &operator+=(const difference_type offset) noexcept
         {
             m_ptr += offset;
             return *this;
         }
 
-        VectorIteratorImpl &operator-=(const difference_type offset) noexcept
+        constexpr VectorIteratorImpl &operator-=(const difference_type offset) noexcept
         {
             m_ptr -= offset;
             return *this;
         }
 
-        friend VectorIteratorImpl operator+(VectorIteratorImpl it, difference_type n) noexcept
+        friend constexpr VectorIteratorImpl operator+(VectorIteratorImpl it, difference_type n) noexcept
         {
             return it += n;
         }
 
-        friend VectorIteratorImpl operator+(difference_type n, VectorIteratorImpl it) noexcept
+        friend constexpr VectorIteratorImpl operator+(difference_type n, VectorIteratorImpl it) noexcept
         {
             return it += n;
         }
 
-        friend VectorIteratorImpl operator-(VectorIteratorImpl it, difference_type n) noexcept
+        friend constexpr VectorIteratorImpl operator-(VectorIteratorImpl it, difference_type n) noexcept
         {
             return it -= n;
         }
 
         // Distance between two operators
-        friend difference_type operator-(const VectorIteratorImpl &lhs, const VectorIteratorImpl &rhs) noexcept
+        friend constexpr difference_type operator-(const VectorIteratorImpl &lhs, const VectorIteratorImpl &rhs) noexcept
         {
             return lhs.m_ptr - rhs.m_ptr;
         }
 
-        reference operator[](difference_type index) const noexcept
+        constexpr reference operator[](difference_type index) const noexcept
         {
             return *(m_ptr + index);
         }
 
-        reference operator*() const noexcept
+        constexpr reference operator*() const noexcept
         {
             return *m_ptr;
         }
 
-        pointer operator->() const noexcept
+        constexpr pointer operator->() const noexcept
         {
             return m_ptr;
         }
@@ -139,37 +607,37 @@ public:
             any combination of const it and it
         */
         template <bool R>
-        bool operator==(const VectorIteratorImpl<R> &other) const noexcept
+        constexpr bool operator==(const VectorIteratorImpl<R> &other) const noexcept
         {
             return m_ptr == other.m_ptr;
         }
 
         template <bool R>
-        bool operator!=(const VectorIteratorImpl<R> &other) const noexcept
+        constexpr bool operator!=(const VectorIteratorImpl<R> &other) const noexcept
         {
             return m_ptr != other.m_ptr;
         }
 
         template <bool R>
-        bool operator<(const VectorIteratorImpl<R> &other) const noexcept
+        constexpr bool operator<(const VectorIteratorImpl<R> &other) const noexcept
         {
             return m_ptr < other.m_ptr;
         }
 
         template <bool R>
-        bool operator<=(const VectorIteratorImpl<R> &other) const noexcept
+        constexpr bool operator<=(const VectorIteratorImpl<R> &other) const noexcept
         {
             return m_ptr <= other.m_ptr;
         }
 
         template <bool R>
-        bool operator>(const VectorIteratorImpl<R> &other) const noexcept
+        constexpr bool operator>(const VectorIteratorImpl<R> &other) const noexcept
         {
             return m_ptr > other.m_ptr;
         }
 
         template <bool R>
-        bool operator>=(const VectorIteratorImpl<R> &other) const noexcept
+        constexpr bool operator>=(const VectorIteratorImpl<R> &other) const noexcept
         {
             return m_ptr >= other.m_ptr;
         }
@@ -180,112 +648,104 @@ public:
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+    using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
 private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                  "Allocator::value_type must match Vector::value_type");
+    // Storage is handled through raw pointers, fancy pointers are not supported
+    static_assert(std::is_same_v<typename alloc_traits::pointer, T *>,
+                  "Allocator::pointer must be T*");
+
     size_t m_capacity;
     size_t m_size;
     T *m_data;
+    // Stateless allocators (std::allocator) take no space
+    [[no_unique_address]] Allocator m_alloc;
+
+    static constexpr bool kTrivialDestroy = vector_detail::kTrivialDestroy<T, Allocator>;
 
 public:
-    void destroyElements()
+    constexpr void destroyElements()
     {
-        if constexpr (!TriviallyDestructible<T>)
-        {
-            for (size_t i = 0; i < m_size; ++i)
-            {
-                m_data[i].~T();
-            }
-        }
+        vector_detail::destroyElements(m_alloc, m_data, m_size);
     }
 
-    void copyElements(T *dest, const T *src, size_t count)
+    constexpr void copyElements(T *dest, const T *src, size_t count)
     {
-        if constexpr (TriviallyCopyConstructible<T>)
-        {
-            // memcpy for trivially copy constructible types
-            std::memcpy(dest, src, count * sizeof(T));
-        }
-        else
-        {
-            size_t i = 0;
-            try
-            {
-                for (; i < count; ++i)
-                {
-                    new (dest + i) T(src[i]);
-                }
-            }
-            catch (...)
-            {
-                for (size_t j = 0; j < i; ++j)
-                {
-                    dest[j].~T();
-                }
-                throw;
-            }
-        }
+        vector_detail::copyElements(m_alloc, dest, src, count);
     }
 
-    void moveElements(T *dest, T *src, size_t count)
+    constexpr void moveElements(T *dest, T *src, size_t count)
     {
-        if constexpr (TriviallyMoveConstructible<T>)
-        {
-            std::memmove(dest, src, count * sizeof(T));
-        }
-        else
-        {
-            size_t i = 0;
+        vector_detail::moveElements(m_alloc, dest, src, count);
+    }
 
-            try
-            {
-                for (; i < count; ++i)
-                {
-                    new (dest + i) T(std::move(src[i]));
-                }
-            }
-            catch (...)
-            {
-                for (size_t j = 0; j < i; ++j)
-                {
-                    dest[j].~T();
-                }
-                throw;
-            }
-        }
+    // Moves and destroys in one step, see vector_detail::relocateElements
+    constexpr void relocateElements(T *dest, T *src, size_t count)
+    {
+        vector_detail::relocateElements(m_alloc, dest, src, count);
     }
 
-    void deallocate()
+    constexpr void deallocate()
     {
         if (m_data)
         {
-            operator delete(m_data);
+            vector_detail::noteRelease(m_alloc, m_size, m_capacity);
         }
+        deallocate(m_data, m_capacity);
+        m_data = nullptr;
         m_size = 0;
         m_capacity = 0;
     }
 
-    T *allocate(size_t n) noexcept(std::is_nothrow_constructible_v<T>)
+    // Releases a block previously obtained from allocate(n)
+    constexpr void deallocate(T *ptr, size_t n)
+    {
+        if (ptr)
+        {
+            alloc_traits::deallocate(m_alloc, ptr, n);
+        }
+    }
+
+    constexpr T *allocate(size_t n)
     {
-        return static_cast<T *>(operator new(sizeof(T) * n));
+        return alloc_traits::allocate(m_alloc, n);
     }
 
-    void shrink_to_fit() noexcept(std::is_nothrow_move_constructible_v<T>)
+    constexpr void shrink_to_fit()
     {
         if (m_capacity > m_size)
         {
-            T *newData = allocate(m_size);
+            vector_detail::noteReallocate(m_alloc, m_size, m_capacity, m_size);
+            if (m_size > 0 && tryReallocate(m_size))
+            {
+                return;
+            }
+
+            T *newData = m_size > 0 ? allocate(m_size) : nullptr;
             try
             {
-                moveElements(newData, m_data, m_size);
+                relocateElements(newData, m_data, m_size);
             }
             catch (...)
             {
-                operator delete(newData);
+                deallocate(newData, m_size);
                 throw;
             }
 
-            // Clean up remainings of initial block
-            destroyElements();
-            operator delete(m_data);
+            // Elements were relocated, only the initial block remains
+            deallocate(m_data, m_capacity);
 
             m_capacity = m_size;
             m_data = newData;
@@ -301,12 +761,19 @@ public:
     // and then assigned the initial value. Thus initializer list avoids
     // default construction + assignment and instead construct with
     // initial value straightaway
-    Vector() : m_capacity(0), m_size(0), m_data(nullptr)
+    constexpr Vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+        : m_capacity(0), m_size(0), m_data(nullptr), m_alloc()
     {
     }
 
-    // Support for initializer list
-    Vector(std::initializer_list<T> init) noexcept(std::is_nothrow_copy_constructible_v<T>) : m_capacity(init.size()), m_size(0), m_data(nullptr)
+    explicit constexpr Vector(const Allocator &alloc) noexcept
+        : m_capacity(0), m_size(0), m_data(nullptr), m_alloc(alloc)
+    {
+    }
+
+    // Support for initializer list
+    constexpr Vector(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : m_capacity(0), m_size(0), m_data(nullptr), m_alloc(alloc)
     {
         if (init.size() == 0)
         {
@@ -314,42 +781,82 @@ public:
         }
 
         T *newData = allocate(init.size());
-        size_t i = 0;
 
         try
         {
-            // Initializer list does not provide [] operator. Need to use iterator
-            for (auto it = init.begin(); it != init.end(); ++it)
-            {
-                new (newData + i) T(*it);
-                ++i;
-            }
+            // Initializer list elements are contiguous
+            copyElements(newData, init.begin(), init.size());
         }
         catch (...)
         {
-            for (size_t j = 0; j < i; ++j)
-            {
-                newData[j].~T();
-            }
-            operator delete(newData);
+            deallocate(newData, init.size());
             throw;
         }
 
+        m_capacity = init.size();
         m_size = init.size();
         m_data = newData;
     }
 
+    // Builds from any input range (Vector(std::from_range, r) in C++23
+    // terms). Sized and forward ranges are constructed straight into one
+    // exactly-sized allocation; contiguous ones of trivial types with one
+    // memcpy. Delegates so the destructor cleans up if construction throws
+    template <std::ranges::input_range R>
+        requires(!std::same_as<std::remove_cvref_t<R>, Vector> &&
+                 std::constructible_from<T, std::ranges::range_reference_t<R>>)
+    explicit constexpr Vector(R &&range, const Allocator &alloc = Allocator())
+        : Vector(alloc)
+    {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>)
+        {
+            const size_t count = static_cast<size_t>(std::ranges::distance(range));
+            if (count == 0)
+            {
+                return;
+            }
+
+            T *newData = allocate(count);
+            try
+            {
+                vector_detail::constructFromRange(m_alloc, newData, std::ranges::begin(range), count);
+            }
+            catch (...)
+            {
+                deallocate(newData, count);
+                throw;
+            }
+
+            m_capacity = count;
+            m_size = count;
+            m_data = newData;
+        }
+        else
+        {
+            append_range(std::forward<R>(range));
+        }
+    }
+
     /*
         Destructors
     */
-    ~Vector()
+    constexpr ~Vector()
     {
         destroyElements();
         deallocate();
     }
 
     // Copy constructor
-    Vector(const Vector &other) noexcept(std::is_nothrow_copy_constructible_v<T>) : m_capacity(other.m_size), m_size(0), m_data(nullptr)
+    // The allocator to use is chosen by the allocator itself (e.g. pmr
+    // allocators do not propagate and fall back to the default resource)
+    constexpr Vector(const Vector &other)
+        : Vector(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+    }
+
+    // Allocator-extended copy constructor
+    constexpr Vector(const Vector &other, const Allocator &alloc)
+        : m_capacity(0), m_size(0), m_data(nullptr), m_alloc(alloc)
     {
         if (other.m_size == 0)
         {
@@ -364,108 +871,346 @@ public:
         }
         catch (...)
         {
-            operator delete(newData);
+            deallocate(newData, other.m_size);
             throw;
         }
 
+        m_capacity = other.m_size;
         m_size = other.m_size;
         m_data = newData;
     }
 
     // Swap should be noexcept
-    void swap(Vector &other) noexcept
+    // Allocators are exchanged only if they propagate on swap, otherwise
+    // they must compare equal (same requirement as std::vector)
+    constexpr void swap(Vector &other) noexcept
     {
-        std::swap(m_capacity, other.m_capacity);
-        std::swap(m_size, other.m_size);
-        std::swap(m_data, other.m_data);
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+        }
+        else
+        {
+            assert(m_alloc == other.m_alloc);
+        }
+        swapStorage(other);
+    }
+
+    friend constexpr void swap(Vector &lhs, Vector &rhs) noexcept
+    {
+        lhs.swap(rhs);
     }
 
     // Copy assignment operator
-    // 1. Pass by value is on purpose
-    // If exception is thrown during copying this will
+    // 1. Copy-and-swap: if exception is thrown during copying this will
     // leave current object intact and not in unknown state
-    // 2. Note this does no longer require self-assignment check
-    // since other is a NEW object
-    // 3. Last but not least, allows for move or copy elision
-    Vector &operator=(const Vector &other)
+    // 2. The temporary is built with the allocator we end up owning, so
+    // the swap below never mixes blocks of different allocators
+    constexpr Vector &operator=(const Vector &other)
     {
         if (this != &other)
         {
-            Vector tmp(other);
-            swap(tmp);
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                Vector tmp(other, other.m_alloc);
+                swapStorage(tmp);
+                // tmp must release our old block with our old allocator
+                using std::swap;
+                swap(m_alloc, tmp.m_alloc);
+            }
+            else
+            {
+                Vector tmp(other, m_alloc);
+                swapStorage(tmp);
+            }
         }
         return *this;
     }
 
-    Vector(Vector &&other) noexcept
-        : m_size(std::exchange(other.m_size, 0)),
-          m_capacity(std::exchange(other.m_capacity, 0)),
-          m_data(std::exchange(other.m_data, nullptr)) {}
+    constexpr Vector(Vector &&other) noexcept
+        : m_capacity(std::exchange(other.m_capacity, 0)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_data(std::exchange(other.m_data, nullptr)),
+          m_alloc(std::move(other.m_alloc)) {}
 
-    Vector &operator=(Vector &&other) noexcept
+    // Allocator-extended move constructor
+    // Steals the buffer when allocators are equal, otherwise moves element-wise
+    constexpr Vector(Vector &&other, const Allocator &alloc)
+        : m_capacity(0), m_size(0), m_data(nullptr), m_alloc(alloc)
     {
-        if (this != &other)
+        if (m_alloc == other.m_alloc)
+        {
+            swapStorage(other);
+            return;
+        }
+
+        if (other.m_size == 0)
+        {
+            return;
+        }
+
+        T *newData = allocate(other.m_size);
+        try
+        {
+            moveElements(newData, other.m_data, other.m_size);
+        }
+        catch (...)
+        {
+            deallocate(newData, other.m_size);
+            throw;
+        }
+
+        m_capacity = other.m_size;
+        m_size = other.m_size;
+        m_data = newData;
+    }
+
+    constexpr Vector &operator=(Vector &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                               alloc_traits::is_always_equal::value)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
         {
             destroyElements();
             deallocate();
-
-            m_size = std::exchange(other.m_size, 0);
-            m_capacity = std::exchange(other.m_capacity, 0);
-            m_data = std::exchange(other.m_data, nullptr);
+            m_alloc = std::move(other.m_alloc);
+            swapStorage(other);
+        }
+        else
+        {
+            if (m_alloc == other.m_alloc)
+            {
+                destroyElements();
+                deallocate();
+                swapStorage(other);
+            }
+            else
+            {
+                // Cannot adopt a block owned by a different allocator
+                Vector tmp(std::move(other), m_alloc);
+                swapStorage(tmp);
+            }
         }
         return *this;
     }
 
     template <typename U>
-    void push_back(U &&element) noexcept(std::is_nothrow_copy_constructible_v<T> &&
-                                         std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    constexpr void push_back(U &&element)
     {
-        if (m_size >= m_capacity)
+        emplace_back(std::forward<U>(element));
+    }
+
+    // Fast path is a compare, a construction in place and an increment.
+    // Everything else lives in the out-of-line reallocateAndEmplace
+    template <typename... Args>
+    constexpr T &emplace_back(Args &&...args)
+    {
+        if (m_size < m_capacity) [[likely]]
         {
-            // Need to delete memory and allocate bigger space
-            size_t newCapacity = (m_capacity == 0) ? 1 : 2 * m_capacity;
+            alloc_traits::construct(m_alloc, m_data + m_size, std::forward<Args>(args)...);
+            return m_data[m_size++];
+        }
+        return *reallocateAndEmplace(m_size, std::forward<Args>(args)...);
+    }
 
-            // Just allocate memory without default construction
-            T *newData = allocate(newCapacity);
-            try
+    template <typename... Args>
+    constexpr iterator emplace(const_iterator pos, Args &&...args)
+    {
+        const size_t index = indexOf(pos);
+        assert(index <= m_size);
+
+        if (m_size == m_capacity)
+        {
+            return iterator(reallocateAndEmplace(index, std::forward<Args>(args)...));
+        }
+
+        if (index == m_size)
+        {
+            alloc_traits::construct(m_alloc, m_data + m_size, std::forward<Args>(args)...);
+            ++m_size;
+            return iterator(m_data + index);
+        }
+
+        // args may refer to an element that is about to be shifted
+        T value(std::forward<Args>(args)...);
+        T *slot = m_data + index;
+
+        if constexpr (vector_detail::kTrivialRelocate<T, Allocator>)
+        {
+            if (std::is_constant_evaluated())
             {
-                moveElements(newData, m_data, m_size);
-                new (newData + m_size) T(std::forward<U>(element));
+                relocateElements(slot + 1, slot, m_size - index);
+                alloc_traits::construct(m_alloc, slot, std::move(value));
             }
-            catch (...)
+            else
             {
-                if constexpr (!TriviallyDestructible<T>)
+                std::memmove(static_cast<void *>(slot + 1), static_cast<const void *>(slot), (m_size - index) * sizeof(T));
+                try
                 {
-                    for (size_t j = 0; j <= m_size; ++j)
-                    {
-                        newData[j].~T();
-                    }
+                    alloc_traits::construct(m_alloc, slot, std::move(value));
+                }
+                catch (...)
+                {
+                    std::memmove(static_cast<void *>(slot), static_cast<const void *>(slot + 1), (m_size - index) * sizeof(T));
+                    throw;
                 }
-                operator delete(newData);
-                throw;
             }
+        }
+        else
+        {
+            // Basic guarantee, as std::vector: a throwing move assignment
+            // leaves the shifted elements in a valid but unspecified state
+            alloc_traits::construct(m_alloc, m_data + m_size, std::move(m_data[m_size - 1]));
+            ++m_size;
+            std::move_backward(slot, m_data + m_size - 2, m_data + m_size - 1);
+            *slot = std::move(value);
+            return iterator(slot);
+        }
+
+        ++m_size;
+        return iterator(slot);
+    }
+
+    constexpr iterator insert(const_iterator pos, const T &value)
+    {
+        return emplace(pos, value);
+    }
+
+    constexpr iterator insert(const_iterator pos, T &&value)
+    {
+        return emplace(pos, std::move(value));
+    }
 
-            // Only after we haven't thrown destroy old elements
-            if constexpr (!TriviallyDestructible<T>)
+    constexpr iterator insert(const_iterator pos, size_t count, const T &value)
+    {
+        // value may alias an element that is shifted or reallocated away
+        const T copy(value);
+        return iterator(insertCounted(indexOf(pos), vector_detail::RepeatIterator<T>{&copy}, count));
+    }
+
+    // Forward ranges are measured first so at most one reallocation happens.
+    // [first, last) must not point into this vector
+    template <typename InputIt>
+        requires(!std::is_integral_v<InputIt>)
+    constexpr iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const size_t index = indexOf(pos);
+        if constexpr (vector_detail::ForwardIterator<InputIt>)
+        {
+            return iterator(insertCounted(index, first, static_cast<size_t>(std::distance(first, last))));
+        }
+        else
+        {
+            // Single pass input: buffer it, then insert in one go
+            Vector tmp(m_alloc);
+            for (; first != last; ++first)
             {
-                destroyElements();
+                tmp.emplace_back(*first);
             }
-            operator delete(m_data);
+            return iterator(insertCounted(index, std::make_move_iterator(tmp.m_data), tmp.m_size));
+        }
+    }
 
-            // After having ensured that allocation has succeeded
-            // then can assign new capacity to member
-            m_data = newData;
-            m_capacity = newCapacity;
-            m_size++;
+    constexpr iterator insert(const_iterator pos, std::initializer_list<T> init)
+    {
+        return iterator(insertCounted(indexOf(pos), init.begin(), init.size()));
+    }
+
+    // Appends a whole range. Sized and forward ranges reserve once and
+    // construct straight into the tail
+    template <std::ranges::range R>
+    constexpr void append_range(R &&range)
+    {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>)
+        {
+            const size_t count = static_cast<size_t>(std::ranges::distance(range));
+            insertCounted(m_size, std::ranges::begin(range), count);
+        }
+        else
+        {
+            for (auto &&element : range)
+            {
+                emplace_back(std::forward<decltype(element)>(element));
+            }
+        }
+    }
+
+    constexpr iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        const size_t index = indexOf(first);
+        const size_t count = static_cast<size_t>(last - first);
+        assert(index + count <= m_size);
+
+        T *pos = m_data + index;
+        if (count == 0)
+        {
+            return iterator(pos);
+        }
+
+        const size_t tail = m_size - index - count;
+        if (tail == 0)
+        {
+            // Erasing up to end() (erase_if): nothing to close
+            truncate(index);
+            return iterator(pos);
+        }
+
+        if constexpr (vector_detail::kTrivialRelocate<T, Allocator>)
+        {
+            // Close the gap with a single memmove
+            vector_detail::destroyElements(m_alloc, pos, count);
+            relocateElements(pos, pos + count, tail);
         }
         else
         {
-            new (m_data + m_size) T(std::forward<U>(element));
-            m_size++;
+            std::move(pos + count, m_data + m_size, pos);
+            vector_detail::destroyElements(m_alloc, m_data + m_size - count, count);
         }
+        m_size -= count;
+        return iterator(pos);
     }
 
-    void pop_back()
+    // [first, last) must not point into this vector
+    template <typename InputIt>
+        requires(!std::is_integral_v<InputIt>)
+    constexpr void assign(InputIt first, InputIt last)
+    {
+        if constexpr (vector_detail::ForwardIterator<InputIt>)
+        {
+            assignCounted(first, static_cast<size_t>(std::distance(first, last)));
+        }
+        else
+        {
+            clear();
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    constexpr void assign(size_t count, const T &value)
+    {
+        const T copy(value);
+        assignCounted(vector_detail::RepeatIterator<T>{&copy}, count);
+    }
+
+    constexpr void assign(std::initializer_list<T> init)
+    {
+        assignCounted(init.begin(), init.size());
+    }
+
+    constexpr void pop_back()
     {
         if (m_size == 0)
         {
@@ -474,13 +1219,13 @@ public:
 
         m_size--;
 
-        if constexpr (!TriviallyDestructible<T>)
+        if constexpr (!kTrivialDestroy)
         {
-            m_data[m_size].~T();
+            alloc_traits::destroy(m_alloc, m_data + m_size);
         }
     }
 
-    T &at(size_t index)
+    constexpr T &at(size_t index)
     {
         if (index >= m_size)
         {
@@ -491,7 +1236,7 @@ public:
     }
 
     // Need to return const &
-    const T &at(const size_t index) const
+    constexpr const T &at(const size_t index) const
     {
         if (index >= m_size)
         {
@@ -501,72 +1246,161 @@ public:
         return m_data[index];
     }
 
-    T &operator[](const size_t index)
+    constexpr T &operator[](const size_t index)
     {
         assert(index < m_size);
         return m_data[index];
     }
 
-    const T &operator[](const size_t index) const
+    constexpr const T &operator[](const size_t index) const
     {
         assert(index < m_size);
         return m_data[index];
     }
 
-    void clear()
+    constexpr void clear()
     {
         destroyElements();
         m_size = 0;
     }
 
-    void reserve(const size_t newCapacity) noexcept(std::is_nothrow_move_constructible_v<T>)
+    constexpr void reserve(const size_t newCapacity)
     {
         if (newCapacity <= m_capacity)
         {
             return;
         }
 
+        vector_detail::noteReallocate(m_alloc, m_size, m_capacity, newCapacity);
+        if (tryReallocate(newCapacity))
+        {
+            return;
+        }
+
         T *newData = allocate(newCapacity);
 
         try
         {
-            moveElements(newData, m_data, m_size);
+            relocateElements(newData, m_data, m_size);
         }
         catch (...)
         {
-            operator delete(newData);
+            deallocate(newData, newCapacity);
             throw;
         }
 
-        destroyElements();
-        operator delete(m_data);
+        deallocate(m_data, m_capacity);
         m_data = newData;
         m_capacity = newCapacity;
     }
 
+    // New elements are value-initialized (zeroed for arithmetic types)
+    constexpr void resize(const size_t newSize)
+    {
+        if (newSize <= m_size)
+        {
+            truncate(newSize);
+            return;
+        }
+
+        growTo(newSize);
+        size_t i = m_size;
+        try
+        {
+            for (; i < newSize; ++i)
+            {
+                alloc_traits::construct(m_alloc, m_data + i);
+            }
+        }
+        catch (...)
+        {
+            vector_detail::destroyElements(m_alloc, m_data + m_size, i - m_size);
+            throw;
+        }
+        m_size = newSize;
+    }
+
+    constexpr void resize(const size_t newSize, const T &value)
+    {
+        if (newSize <= m_size)
+        {
+            truncate(newSize);
+            return;
+        }
+
+        // value may alias an element that is reallocated away
+        const T copy(value);
+        insertCounted(m_size, vector_detail::RepeatIterator<T>{&copy}, newSize - m_size);
+    }
+
+    // Like resize(n) but new elements are default-initialized: trivial
+    // types are left uninitialized instead of being zeroed, for buffers a
+    // producer is about to overwrite anyway
+    constexpr void resize_default_init(const size_t newSize)
+    {
+        if (newSize <= m_size)
+        {
+            truncate(newSize);
+            return;
+        }
+
+        if constexpr (std::is_trivially_default_constructible_v<T> && TransparentAllocator<Allocator, T>)
+        {
+            growTo(newSize);
+            m_size = newSize;
+        }
+        else
+        {
+            resize(newSize);
+        }
+    }
+
+    // Grows the size by count and returns a pointer to the new, uninitialized
+    // tail, e.g. as destination of read() or a decoder. Only for types that
+    // need no construction or destruction
+    [[nodiscard]] constexpr T *append_uninitialized(const size_t count)
+        requires(std::is_trivially_default_constructible_v<T> && TriviallyDestructible<T>)
+    {
+        growTo(m_size + count);
+        T *tail = m_data + m_size;
+        m_size += count;
+        return tail;
+    }
+
+    [[nodiscard]] constexpr allocator_type get_allocator() const noexcept { return m_alloc; }
+
     // For STL-compliance data() accessor
-    [[nodiscard]] T *data() { return m_data; }
-    [[nodiscard]] const T *data() const { return m_data; }
+    [[nodiscard]] constexpr T *data() { return m_data; }
+    [[nodiscard]] constexpr const T *data() const { return m_data; }
 
-    bool empty() const { return m_size == 0; }
+    constexpr bool empty() const { return m_size == 0; }
 
-    [[nodiscard]] size_t size() const
+    [[nodiscard]] constexpr size_t size() const
     {
         return m_size;
     }
-    [[nodiscard]] size_t capacity() const { return m_capacity; }
+    [[nodiscard]] constexpr size_t capacity() const { return m_capacity; }
 
     /*
         Iterators access
     */
-    iterator begin() noexcept { return iterator(m_data); }
-    iterator end() noexcept { return iterator(m_data + m_size); }
+    constexpr iterator begin() noexcept { return iterator(m_data); }
+    constexpr iterator end() noexcept { return iterator(m_data + m_size); }
+
+    constexpr const_iterator begin() const noexcept { return const_iterator(m_data); }
+    constexpr const_iterator end() const noexcept { return const_iterator(m_data + m_size); }
+
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend() const noexcept { return end(); }
 
-    const_iterator begin() const noexcept { return const_iterator(m_data); }
-    const_iterator end() const noexcept { return const_iterator(m_data + m_size); }
+    constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
 
-    const_iterator cbegin() const noexcept { return begin(); }
-    const_iterator cend() const noexcept { return end(); }
+    constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    constexpr const_reverse_iterator crend() const noexcept { return rend(); }
 
     friend std::ostream &operator<<(std::ostream &os, const Vector &v)
     {
@@ -580,4 +1414,316 @@ public:
         os << "]";
         return os;
     }
-};
\ No newline at end of file
+
+private:
+    // Growth slow path shared by emplace_back and emplace. Kept out of line
+    // and marked cold so callers only inline the capacity check.
+    // The new element is constructed before anything is relocated, so args
+    // may safely refer to an element of this vector. Strong guarantee
+    template <typename... Args>
+    VECTOR_COLD_NOINLINE constexpr T *reallocateAndEmplace(size_t index, Args &&...args)
+    {
+        const size_t newCapacity = GrowthPolicy::grow(m_capacity, m_size + 1, sizeof(T));
+
+        // Just allocate memory without default construction
+        vector_detail::noteReallocate(m_alloc, m_size, m_capacity, newCapacity);
+
+        if constexpr (kCanReallocate && std::is_nothrow_move_constructible_v<T>)
+        {
+            if (m_data)
+            {
+                // Built first since the block may move; if anything throws
+                // the vector is untouched
+                T element(std::forward<Args>(args)...);
+                reallocateBlock(newCapacity);
+                relocateElements(m_data + index + 1, m_data + index, m_size - index);
+                alloc_traits::construct(m_alloc, m_data + index, std::move(element));
+                m_size++;
+                return m_data + index;
+            }
+        }
+
+        T *newData = allocate(newCapacity);
+
+        try
+        {
+            alloc_traits::construct(m_alloc, newData + index, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(newData, newCapacity);
+            throw;
+        }
+
+        try
+        {
+            relocateAround(newData, index);
+        }
+        catch (...)
+        {
+            if constexpr (!kTrivialDestroy)
+            {
+                alloc_traits::destroy(m_alloc, newData + index);
+            }
+            deallocate(newData, newCapacity);
+            throw;
+        }
+
+        // Old elements are gone, only the block is left to release
+        deallocate(m_data, m_capacity);
+
+        m_data = newData;
+        m_capacity = newCapacity;
+        m_size++;
+        return newData + index;
+    }
+
+    // Relocates [0, gap) to newData and [gap, size) to newData + gap + gapSize,
+    // leaving gapSize uninitialized slots. Old elements are destroyed only
+    // once everything has been moved
+    constexpr void relocateAround(T *newData, size_t gap, size_t gapSize = 1)
+    {
+        if constexpr (vector_detail::kTrivialRelocate<T, Allocator>)
+        {
+            relocateElements(newData, m_data, gap);
+            relocateElements(newData + gap + gapSize, m_data + gap, m_size - gap);
+        }
+        else
+        {
+            moveElements(newData, m_data, gap);
+            try
+            {
+                moveElements(newData + gap + gapSize, m_data + gap, m_size - gap);
+            }
+            catch (...)
+            {
+                vector_detail::destroyElements(m_alloc, newData, gap);
+                throw;
+            }
+            destroyElements();
+        }
+    }
+
+    // Allocators may offer reallocate(p, oldCapacity, newCapacity, used),
+    // which resizes a block keeping its first used elements bytewise (e.g.
+    // RemapAllocator moves pages with mremap instead of copying). Only valid
+    // when elements can be relocated by copying bytes
+    static constexpr bool kCanReallocate =
+        vector_detail::kTrivialRelocate<T, Allocator> &&
+        requires(Allocator &a, T *p, size_t n) { { a.reallocate(p, n, n, n) } -> std::same_as<T *>; };
+
+    constexpr void reallocateBlock(size_t newCapacity)
+    {
+        vector_detail::noteMoved(m_alloc, m_size);
+        m_data = m_alloc.reallocate(m_data, m_capacity, newCapacity, m_size);
+        m_capacity = newCapacity;
+    }
+
+    // Resizes the current block through Allocator::reallocate if possible.
+    // Returns false if the caller has to allocate and relocate itself
+    constexpr bool tryReallocate(size_t newCapacity)
+    {
+        if constexpr (kCanReallocate)
+        {
+            if (m_data && newCapacity > 0)
+            {
+                reallocateBlock(newCapacity);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Makes room for required elements, growing by the policy so repeated
+    // resizes stay amortized
+    constexpr void growTo(size_t required)
+    {
+        if (required > m_capacity)
+        {
+            reserve(GrowthPolicy::grow(m_capacity, required, sizeof(T)));
+        }
+    }
+
+    // Destroys the elements past newSize
+    constexpr void truncate(size_t newSize) noexcept
+    {
+        vector_detail::destroyElements(m_alloc, m_data + newSize, m_size - newSize);
+        m_size = newSize;
+    }
+
+    constexpr size_t indexOf(const_iterator pos) const noexcept
+    {
+        return static_cast<size_t>(pos - cbegin());
+    }
+
+    // Inserts count elements read from first at index, returns a pointer to
+    // the first inserted element. Reallocates at most once; in place, the
+    // tail of trivially relocatable types is shifted with one memmove
+    template <typename It>
+    constexpr T *insertCounted(size_t index, It first, size_t count)
+    {
+        assert(index <= m_size);
+        if (count == 0)
+        {
+            return m_data + index;
+        }
+
+        if (count > m_capacity - m_size)
+        {
+            const size_t newCapacity = GrowthPolicy::grow(m_capacity, m_size + count, sizeof(T));
+            vector_detail::noteReallocate(m_alloc, m_size, m_capacity, newCapacity);
+            T *newData = allocate(newCapacity);
+
+            try
+            {
+                vector_detail::constructFromRange(m_alloc, newData + index, first, count);
+            }
+            catch (...)
+            {
+                deallocate(newData, newCapacity);
+                throw;
+            }
+
+            try
+            {
+                relocateAround(newData, index, count);
+            }
+            catch (...)
+            {
+                vector_detail::destroyElements(m_alloc, newData + index, count);
+                deallocate(newData, newCapacity);
+                throw;
+            }
+
+            deallocate(m_data, m_capacity);
+            m_data = newData;
+            m_capacity = newCapacity;
+            m_size += count;
+            return newData + index;
+        }
+
+        T *pos = m_data + index;
+        T *end = m_data + m_size;
+        const size_t tail = m_size - index;
+
+        if constexpr (vector_detail::kTrivialRelocate<T, Allocator>)
+        {
+            relocateElements(pos + count, pos, tail);
+            try
+            {
+                vector_detail::constructFromRange(m_alloc, pos, first, count);
+            }
+            catch (...)
+            {
+                relocateElements(pos, pos + count, tail);
+                throw;
+            }
+            m_size += count;
+        }
+        else
+        {
+            // Basic guarantee once live elements start being assigned
+            if (tail > count)
+            {
+                moveElements(end, end - count, count);
+                m_size += count;
+                std::move_backward(pos, end - count, end);
+                vector_detail::assignFromRange(pos, first, count);
+            }
+            else
+            {
+                It mid = vector_detail::advanceBy(first, tail);
+                vector_detail::constructFromRange(m_alloc, end, mid, count - tail);
+                try
+                {
+                    moveElements(end + count - tail, pos, tail);
+                }
+                catch (...)
+                {
+                    vector_detail::destroyElements(m_alloc, end, count - tail);
+                    throw;
+                }
+                m_size += count;
+                vector_detail::assignFromRange(pos, first, tail);
+            }
+        }
+        return pos;
+    }
+
+    // Replaces the contents with count elements read from first
+    template <typename It>
+    constexpr void assignCounted(It first, size_t count)
+    {
+        if (count > m_capacity)
+        {
+            vector_detail::noteReallocate(m_alloc, m_size, m_capacity, count);
+            T *newData = allocate(count);
+            try
+            {
+                vector_detail::constructFromRange(m_alloc, newData, first, count);
+            }
+            catch (...)
+            {
+                deallocate(newData, count);
+                throw;
+            }
+
+            destroyElements();
+            deallocate(m_data, m_capacity);
+            m_data = newData;
+            m_capacity = count;
+            m_size = count;
+            return;
+        }
+
+        clear();
+        vector_detail::constructFromRange(m_alloc, m_data, first, count);
+        m_size = count;
+    }
+
+    // Exchanges buffers only, allocators stay where they are
+    constexpr void swapStorage(Vector &other) noexcept
+    {
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_data, other.m_data);
+    }
+};
+
+// Removes every element matching pred with a single compaction pass,
+// returns how many were removed
+template <typename T, typename Allocator, typename GrowthPolicy, typename Pred>
+constexpr size_t erase_if(Vector<T, Allocator, GrowthPolicy> &v, Pred pred)
+{
+    T *data = v.data();
+    const size_t size = v.size();
+    size_t kept = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (!pred(data[i]))
+        {
+            if (kept != i)
+            {
+                data[kept] = std::move(data[i]);
+            }
+            ++kept;
+        }
+    }
+    v.erase(v.begin() + kept, v.end());
+    return size - kept;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename U>
+constexpr size_t erase(Vector<T, Allocator, GrowthPolicy> &v, const U &value)
+{
+    return erase_if(v, [&value](const T &element)
+                    { return element == value; });
+}
+
+namespace pmr
+{
+    // Vector drawing its memory from a std::pmr::memory_resource, e.g. a
+    // std::pmr::monotonic_buffer_resource arena released all at once
+    template <typename T>
+    using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>>;
+}
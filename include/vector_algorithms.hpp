@@ -0,0 +1,715 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+/*
+    SIMD kernels over contiguous arithmetic storage (Vector, SmallVector,
+    std::vector, raw arrays, ...).
+
+    Every kernel exists once as a generic body written with GCC/Clang
+    vector extensions and is stamped out per instruction set with
+    [[gnu::target]]: SSE2 (16 byte lanes), AVX2 (32) and AVX-512 (64).
+    The widest set the CPU supports is picked at runtime on first use;
+    a plain scalar loop is used on other compilers/architectures.
+
+    Supported element types: int32_t, int64_t, float, double.
+    Floating point reductions are reassociated (several accumulators), so
+    sums may differ from a left-to-right loop in the last bits. min/max
+    results are unspecified if the data contains NaN.
+*/
+
+// Private to this header, undefined at its end
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_SIMD_X86 1
+#endif
+
+namespace vector_algorithms
+{
+    template <typename T>
+    concept SimdArithmetic = std::same_as<T, int32_t> || std::same_as<T, int64_t> ||
+                             std::same_as<T, float> || std::same_as<T, double>;
+
+    // Anything exposing contiguous storage through data()/size()
+    template <typename C>
+    concept ContiguousContainer = requires(C &c) {
+        { c.data() } -> std::convertible_to<const typename C::value_type *>;
+        { c.size() } -> std::convertible_to<size_t>;
+    } && SimdArithmetic<typename C::value_type>;
+
+    enum class Isa
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    // Best instruction set of the running CPU
+    inline Isa detectIsa() noexcept
+    {
+#ifdef VECTOR_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+            __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+        {
+            return Isa::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            return Isa::AVX2;
+        }
+        return Isa::SSE2;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    namespace simd_detail
+    {
+        inline std::atomic<Isa> &isaSlot() noexcept
+        {
+            static std::atomic<Isa> isa{detectIsa()};
+            return isa;
+        }
+    }
+
+    [[nodiscard]] inline Isa activeIsa() noexcept
+    {
+        return simd_detail::isaSlot().load(std::memory_order_relaxed);
+    }
+
+    // Restricts dispatch to a narrower instruction set, e.g. to compare
+    // kernels in benchmarks. Requests above what the CPU supports are clamped
+    inline Isa setIsa(Isa isa) noexcept
+    {
+        const Isa best = detectIsa();
+        const Isa chosen = static_cast<int>(isa) > static_cast<int>(best) ? best : isa;
+        simd_detail::isaSlot().store(chosen, std::memory_order_relaxed);
+        return chosen;
+    }
+
+    namespace simd_detail
+    {
+        /*
+            Scalar kernels: the fallback and the reference for the tests
+        */
+        struct Scalar
+        {
+            template <typename T>
+            static T reduce(const T *p, size_t n)
+            {
+                T sum{};
+                for (size_t i = 0; i < n; ++i)
+                {
+                    sum += p[i];
+                }
+                return sum;
+            }
+
+            template <typename T>
+            static T dot(const T *a, const T *b, size_t n)
+            {
+                T sum{};
+                for (size_t i = 0; i < n; ++i)
+                {
+                    sum += a[i] * b[i];
+                }
+                return sum;
+            }
+
+            template <typename T>
+            static T min(const T *p, size_t n)
+            {
+                T m = p[0];
+                for (size_t i = 1; i < n; ++i)
+                {
+                    m = p[i] < m ? p[i] : m;
+                }
+                return m;
+            }
+
+            template <typename T>
+            static T max(const T *p, size_t n)
+            {
+                T m = p[0];
+                for (size_t i = 1; i < n; ++i)
+                {
+                    m = p[i] > m ? p[i] : m;
+                }
+                return m;
+            }
+
+            template <typename T>
+            static size_t find(const T *p, size_t n, T value)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (p[i] == value)
+                    {
+                        return i;
+                    }
+                }
+                return n;
+            }
+
+            template <typename T>
+            static size_t count(const T *p, size_t n, T value)
+            {
+                size_t c = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    c += p[i] == value;
+                }
+                return c;
+            }
+
+            template <typename T>
+            static bool equal(const T *a, const T *b, size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (!(a[i] == b[i]))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            template <typename T>
+            static void fill(T *p, size_t n, T value)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    p[i] = value;
+                }
+            }
+
+            template <typename T>
+            static void add(const T *a, const T *b, T *out, size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            template <typename T>
+            static void multiply(const T *a, const T *b, T *out, size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    out[i] = a[i] * b[i];
+                }
+            }
+
+            template <typename T>
+            static void scale(const T *a, T factor, T *out, size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    out[i] = a[i] * factor;
+                }
+            }
+        };
+
+#ifdef VECTOR_SIMD_X86
+#define VECTOR_SIMD_INLINE [[gnu::always_inline]] inline
+
+// The bodies pass vectors by value but are always inlined, so the ABI
+// change -Wpsabi warns about never applies
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+        template <typename T, size_t Bytes>
+        struct VecOf
+        {
+            typedef T type __attribute__((vector_size(Bytes)));
+        };
+
+        /*
+            Generic SIMD bodies for Bytes wide registers. Always inlined into
+            the per-ISA wrappers below, which decide the instructions used.
+            Vectors never cross a non-inlined call, so no ABI issues arise
+        */
+        template <typename T, size_t Bytes>
+        struct Body
+        {
+            using V = typename VecOf<T, Bytes>::type;
+            using Mask = decltype(V{} == V{});
+            using Bits = typename VecOf<uint64_t, Bytes>::type;
+
+            static constexpr size_t L = Bytes / sizeof(T);
+
+            VECTOR_SIMD_INLINE static V load(const T *p)
+            {
+                V v;
+                std::memcpy(&v, p, sizeof(V));
+                return v;
+            }
+
+            VECTOR_SIMD_INLINE static void store(T *p, V v)
+            {
+                std::memcpy(p, &v, sizeof(V));
+            }
+
+            VECTOR_SIMD_INLINE static bool any(Mask m)
+            {
+                Bits bits;
+                std::memcpy(&bits, &m, sizeof(Bits));
+                uint64_t folded = 0;
+                for (size_t i = 0; i < Bytes / sizeof(uint64_t); ++i)
+                {
+                    folded |= bits[i];
+                }
+                return folded != 0;
+            }
+
+            template <typename Vec>
+            VECTOR_SIMD_INLINE static auto horizontalSum(Vec v)
+            {
+                auto sum = v[0];
+                for (size_t i = 1; i < sizeof(Vec) / sizeof(v[0]); ++i)
+                {
+                    sum += v[i];
+                }
+                return sum;
+            }
+
+            VECTOR_SIMD_INLINE static T reduce(const T *p, size_t n)
+            {
+                V a0{}, a1{}, a2{}, a3{};
+                size_t i = 0;
+                for (; i + 4 * L <= n; i += 4 * L)
+                {
+                    a0 += load(p + i);
+                    a1 += load(p + i + L);
+                    a2 += load(p + i + 2 * L);
+                    a3 += load(p + i + 3 * L);
+                }
+                for (; i + L <= n; i += L)
+                {
+                    a0 += load(p + i);
+                }
+                T sum = horizontalSum((a0 + a1) + (a2 + a3));
+                for (; i < n; ++i)
+                {
+                    sum += p[i];
+                }
+                return sum;
+            }
+
+            VECTOR_SIMD_INLINE static T dot(const T *a, const T *b, size_t n)
+            {
+                V a0{}, a1{}, a2{}, a3{};
+                size_t i = 0;
+                for (; i + 4 * L <= n; i += 4 * L)
+                {
+                    a0 += load(a + i) * load(b + i);
+                    a1 += load(a + i + L) * load(b + i + L);
+                    a2 += load(a + i + 2 * L) * load(b + i + 2 * L);
+                    a3 += load(a + i + 3 * L) * load(b + i + 3 * L);
+                }
+                for (; i + L <= n; i += L)
+                {
+                    a0 += load(a + i) * load(b + i);
+                }
+                T sum = horizontalSum((a0 + a1) + (a2 + a3));
+                for (; i < n; ++i)
+                {
+                    sum += a[i] * b[i];
+                }
+                return sum;
+            }
+
+            VECTOR_SIMD_INLINE static T min(const T *p, size_t n)
+            {
+                if (n < L)
+                {
+                    return Scalar::min(p, n);
+                }
+                V m = load(p);
+                size_t i = L;
+                for (; i + L <= n; i += L)
+                {
+                    const V x = load(p + i);
+                    m = x < m ? x : m;
+                }
+                T result = m[0];
+                for (size_t l = 1; l < L; ++l)
+                {
+                    result = m[l] < result ? m[l] : result;
+                }
+                for (; i < n; ++i)
+                {
+                    result = p[i] < result ? p[i] : result;
+                }
+                return result;
+            }
+
+            VECTOR_SIMD_INLINE static T max(const T *p, size_t n)
+            {
+                if (n < L)
+                {
+                    return Scalar::max(p, n);
+                }
+                V m = load(p);
+                size_t i = L;
+                for (; i + L <= n; i += L)
+                {
+                    const V x = load(p + i);
+                    m = x > m ? x : m;
+                }
+                T result = m[0];
+                for (size_t l = 1; l < L; ++l)
+                {
+                    result = m[l] > result ? m[l] : result;
+                }
+                for (; i < n; ++i)
+                {
+                    result = p[i] > result ? p[i] : result;
+                }
+                return result;
+            }
+
+            VECTOR_SIMD_INLINE static size_t find(const T *p, size_t n, T value)
+            {
+                const V needle = V{} + value;
+                size_t i = 0;
+                for (; i + 4 * L <= n; i += 4 * L)
+                {
+                    const Mask m = (load(p + i) == needle) | (load(p + i + L) == needle) |
+                                   (load(p + i + 2 * L) == needle) | (load(p + i + 3 * L) == needle);
+                    if (any(m))
+                    {
+                        return i + Scalar::find(p + i, 4 * L, value);
+                    }
+                }
+                for (; i + L <= n; i += L)
+                {
+                    if (any(load(p + i) == needle))
+                    {
+                        return i + Scalar::find(p + i, L, value);
+                    }
+                }
+                return i + Scalar::find(p + i, n - i, value);
+            }
+
+            VECTOR_SIMD_INLINE static size_t count(const T *p, size_t n, T value)
+            {
+                // Matching lanes are -1: subtracting masks counts them. Lane
+                // counters are flushed regularly so 32-bit lanes cannot overflow
+                constexpr size_t kFlushBlocks = size_t(1) << 24;
+                const V needle = V{} + value;
+                size_t total = 0;
+                size_t i = 0;
+                while (i + L <= n)
+                {
+                    Mask counts{};
+                    const size_t blocks = std::min((n - i) / L, kFlushBlocks);
+                    for (size_t b = 0; b < blocks; ++b, i += L)
+                    {
+                        counts -= load(p + i) == needle;
+                    }
+                    total += static_cast<size_t>(horizontalSum(counts));
+                }
+                return total + Scalar::count(p + i, n - i, value);
+            }
+
+            VECTOR_SIMD_INLINE static bool equal(const T *a, const T *b, size_t n)
+            {
+                size_t i = 0;
+                for (; i + L <= n; i += L)
+                {
+                    if (any(load(a + i) != load(b + i)))
+                    {
+                        return false;
+                    }
+                }
+                return Scalar::equal(a + i, b + i, n - i);
+            }
+
+            VECTOR_SIMD_INLINE static void fill(T *p, size_t n, T value)
+            {
+                const V v = V{} + value;
+                size_t i = 0;
+                for (; i + L <= n; i += L)
+                {
+                    store(p + i, v);
+                }
+                Scalar::fill(p + i, n - i, value);
+            }
+
+            VECTOR_SIMD_INLINE static void add(const T *a, const T *b, T *out, size_t n)
+            {
+                size_t i = 0;
+                for (; i + L <= n; i += L)
+                {
+                    store(out + i, load(a + i) + load(b + i));
+                }
+                Scalar::add(a + i, b + i, out + i, n - i);
+            }
+
+            VECTOR_SIMD_INLINE static void multiply(const T *a, const T *b, T *out, size_t n)
+            {
+                size_t i = 0;
+                for (; i + L <= n; i += L)
+                {
+                    store(out + i, load(a + i) * load(b + i));
+                }
+                Scalar::multiply(a + i, b + i, out + i, n - i);
+            }
+
+            VECTOR_SIMD_INLINE static void scale(const T *a, T factor, T *out, size_t n)
+            {
+                const V f = V{} + factor;
+                size_t i = 0;
+                for (; i + L <= n; i += L)
+                {
+                    store(out + i, load(a + i) * f);
+                }
+                Scalar::scale(a + i, factor, out + i, n - i);
+            }
+        };
+
+// One set of out-of-line kernels per instruction set
+#define VECTOR_SIMD_DEFINE_ISA(NAME, TARGET, BYTES)                                                               \
+    struct NAME                                                                                                   \
+    {                                                                                                             \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static T reduce(const T *p, size_t n) { return Body<T, BYTES>::reduce(p, n); }     \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static T dot(const T *a, const T *b, size_t n)                                     \
+        {                                                                                                         \
+            return Body<T, BYTES>::dot(a, b, n);                                                                  \
+        }                                                                                                         \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static T min(const T *p, size_t n) { return Body<T, BYTES>::min(p, n); }           \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static T max(const T *p, size_t n) { return Body<T, BYTES>::max(p, n); }           \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static size_t find(const T *p, size_t n, T value)                                  \
+        {                                                                                                         \
+            return Body<T, BYTES>::find(p, n, value);                                                             \
+        }                                                                                                         \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static size_t count(const T *p, size_t n, T value)                                 \
+        {                                                                                                         \
+            return Body<T, BYTES>::count(p, n, value);                                                            \
+        }                                                                                                         \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static bool equal(const T *a, const T *b, size_t n)                                \
+        {                                                                                                         \
+            return Body<T, BYTES>::equal(a, b, n);                                                                \
+        }                                                                                                         \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static void fill(T *p, size_t n, T value) { Body<T, BYTES>::fill(p, n, value); }   \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static void add(const T *a, const T *b, T *out, size_t n)                          \
+        {                                                                                                         \
+            Body<T, BYTES>::add(a, b, out, n);                                                                    \
+        }                                                                                                         \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static void multiply(const T *a, const T *b, T *out, size_t n)                     \
+        {                                                                                                         \
+            Body<T, BYTES>::multiply(a, b, out, n);                                                               \
+        }                                                                                                         \
+        template <typename T>                                                                                     \
+        [[gnu::target(TARGET)]] static void scale(const T *a, T factor, T *out, size_t n)                          \
+        {                                                                                                         \
+            Body<T, BYTES>::scale(a, factor, out, n);                                                             \
+        }                                                                                                         \
+    };
+
+        VECTOR_SIMD_DEFINE_ISA(SSE2, "sse2", 16)
+        VECTOR_SIMD_DEFINE_ISA(AVX2, "avx2,fma", 32)
+        VECTOR_SIMD_DEFINE_ISA(AVX512, "avx512f,avx512dq,avx512bw,avx512vl", 64)
+
+#pragma GCC diagnostic pop
+
+#undef VECTOR_SIMD_DEFINE_ISA
+#undef VECTOR_SIMD_INLINE
+#endif
+
+        template <typename T>
+        struct Kernels
+        {
+            T (*reduce)(const T *, size_t);
+            T (*dot)(const T *, const T *, size_t);
+            T (*min)(const T *, size_t);
+            T (*max)(const T *, size_t);
+            size_t (*find)(const T *, size_t, T);
+            size_t (*count)(const T *, size_t, T);
+            bool (*equal)(const T *, const T *, size_t);
+            void (*fill)(T *, size_t, T);
+            void (*add)(const T *, const T *, T *, size_t);
+            void (*multiply)(const T *, const T *, T *, size_t);
+            void (*scale)(const T *, T, T *, size_t);
+        };
+
+        template <typename T, typename Impl>
+        constexpr Kernels<T> kernelsOf()
+        {
+            return Kernels<T>{&Impl::template reduce<T>, &Impl::template dot<T>, &Impl::template min<T>,
+                              &Impl::template max<T>, &Impl::template find<T>, &Impl::template count<T>,
+                              &Impl::template equal<T>, &Impl::template fill<T>, &Impl::template add<T>,
+                              &Impl::template multiply<T>, &Impl::template scale<T>};
+        }
+
+        // Kernel table of the active instruction set, indexed by Isa
+        template <typename T>
+        const Kernels<T> &kernels() noexcept
+        {
+#ifdef VECTOR_SIMD_X86
+            static constexpr Kernels<T> table[] = {kernelsOf<T, Scalar>(), kernelsOf<T, SSE2>(),
+                                                   kernelsOf<T, AVX2>(), kernelsOf<T, AVX512>()};
+            return table[static_cast<int>(activeIsa())];
+#else
+            static constexpr Kernels<T> table = kernelsOf<T, Scalar>();
+            return table;
+#endif
+        }
+    }
+
+    /*
+        Pointer interface
+    */
+    template <SimdArithmetic T>
+    T reduce(const T *data, size_t n) { return simd_detail::kernels<T>().reduce(data, n); }
+
+    template <SimdArithmetic T>
+    T dot(const T *a, const T *b, size_t n) { return simd_detail::kernels<T>().dot(a, b, n); }
+
+    // Precondition: n > 0
+    template <SimdArithmetic T>
+    T min(const T *data, size_t n) { return simd_detail::kernels<T>().min(data, n); }
+
+    // Precondition: n > 0
+    template <SimdArithmetic T>
+    T max(const T *data, size_t n) { return simd_detail::kernels<T>().max(data, n); }
+
+    // Index of the first occurrence of value, n if absent
+    template <SimdArithmetic T>
+    size_t find(const T *data, size_t n, T value) { return simd_detail::kernels<T>().find(data, n, value); }
+
+    template <SimdArithmetic T>
+    size_t count(const T *data, size_t n, T value) { return simd_detail::kernels<T>().count(data, n, value); }
+
+    // Index of the first minimum, n if empty
+    template <SimdArithmetic T>
+    size_t argmin(const T *data, size_t n) { return n == 0 ? 0 : find(data, n, min(data, n)); }
+
+    // Index of the first maximum, n if empty
+    template <SimdArithmetic T>
+    size_t argmax(const T *data, size_t n) { return n == 0 ? 0 : find(data, n, max(data, n)); }
+
+    template <SimdArithmetic T>
+    bool equal(const T *a, const T *b, size_t n) { return simd_detail::kernels<T>().equal(a, b, n); }
+
+    template <SimdArithmetic T>
+    void fill(T *data, size_t n, T value) { simd_detail::kernels<T>().fill(data, n, value); }
+
+    // out[i] = a[i] + b[i]; out may alias a or b
+    template <SimdArithmetic T>
+    void add(const T *a, const T *b, T *out, size_t n) { simd_detail::kernels<T>().add(a, b, out, n); }
+
+    // out[i] = a[i] * b[i]; out may alias a or b
+    template <SimdArithmetic T>
+    void multiply(const T *a, const T *b, T *out, size_t n) { simd_detail::kernels<T>().multiply(a, b, out, n); }
+
+    // out[i] = a[i] * factor; out may alias a
+    template <SimdArithmetic T>
+    void scale(const T *a, T factor, T *out, size_t n) { simd_detail::kernels<T>().scale(a, factor, out, n); }
+
+    /*
+        Container interface
+    */
+    template <ContiguousContainer C>
+    auto reduce(const C &c) { return reduce(c.data(), c.size()); }
+
+    template <ContiguousContainer A, ContiguousContainer B>
+    auto dot(const A &a, const B &b)
+    {
+        if (a.size() != b.size())
+        {
+            throw std::invalid_argument("dot(): size mismatch");
+        }
+        return dot(a.data(), b.data(), a.size());
+    }
+
+    template <ContiguousContainer C>
+    auto min(const C &c)
+    {
+        if (c.size() == 0)
+        {
+            throw std::out_of_range("min() called on empty vector");
+        }
+        return min(c.data(), c.size());
+    }
+
+    template <ContiguousContainer C>
+    auto max(const C &c)
+    {
+        if (c.size() == 0)
+        {
+            throw std::out_of_range("max() called on empty vector");
+        }
+        return max(c.data(), c.size());
+    }
+
+    template <ContiguousContainer C>
+    size_t find(const C &c, typename C::value_type value) { return find(c.data(), c.size(), value); }
+
+    template <ContiguousContainer C>
+    size_t count(const C &c, typename C::value_type value) { return count(c.data(), c.size(), value); }
+
+    template <ContiguousContainer C>
+    size_t argmin(const C &c) { return argmin(c.data(), c.size()); }
+
+    template <ContiguousContainer C>
+    size_t argmax(const C &c) { return argmax(c.data(), c.size()); }
+
+    template <ContiguousContainer A, ContiguousContainer B>
+    bool equal(const A &a, const B &b)
+    {
+        return a.size() == b.size() && equal(a.data(), b.data(), a.size());
+    }
+
+    template <ContiguousContainer C>
+    void fill(C &c, typename C::value_type value) { fill(c.data(), c.size(), value); }
+
+    // In place: c[i] += other[i]
+    template <ContiguousContainer C, ContiguousContainer O>
+    void add(C &c, const O &other)
+    {
+        if (c.size() != other.size())
+        {
+            throw std::invalid_argument("add(): size mismatch");
+        }
+        add(c.data(), other.data(), c.data(), c.size());
+    }
+
+    // In place: c[i] *= other[i]
+    template <ContiguousContainer C, ContiguousContainer O>
+    void multiply(C &c, const O &other)
+    {
+        if (c.size() != other.size())
+        {
+            throw std::invalid_argument("multiply(): size mismatch");
+        }
+        multiply(c.data(), other.data(), c.data(), c.size());
+    }
+
+    // In place: c[i] *= factor
+    template <ContiguousContainer C>
+    void scale(C &c, typename C::value_type factor) { scale(c.data(), factor, c.data(), c.size()); }
+}
+
+#undef VECTOR_SIMD_X86
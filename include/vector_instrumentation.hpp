@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "growth_policy.hpp"
+
+/*
+    Opt-in allocation/relocation instrumentation.
+
+    instrumented::Allocator<T> is an allocator adaptor that attributes every
+    event to a call site in a process-wide registry. The containers report
+    copies, moves and reallocations through optional allocator hooks
+    (on_elements_copied, on_elements_moved, on_reallocate, on_release) that
+    are only called if the allocator has them, so ordinary allocators pay
+    nothing.
+
+    Two ways to turn it on:
+      - per vector:  instrumented::Vector<int> v(instrumented::here());
+      - globally:    compile everything with -DVECTOR_INSTRUMENTATION, which
+                     makes instrumented::Allocator the default allocator of
+                     Vector (sites are then attributed per element type).
+                     Must be defined consistently for the whole program.
+
+    instrumented::Registry::instance().dump(std::cerr) prints per-site totals.
+*/
+
+namespace instrumented
+{
+    // Counters of one call site. Relaxed atomics: totals only, no ordering
+    struct SiteStats
+    {
+        std::string name;
+
+        std::atomic<size_t> allocations{0};
+        std::atomic<size_t> deallocations{0};
+        std::atomic<size_t> bytesAllocated{0};
+        std::atomic<size_t> liveBytes{0};
+        std::atomic<size_t> peakLiveBytes{0};
+        std::atomic<size_t> reallocations{0};
+        std::atomic<size_t> elementsCopied{0};
+        std::atomic<size_t> elementsMoved{0};
+        std::atomic<size_t> peakCapacity{0};
+        std::atomic<size_t> peakSize{0};
+        // Capacity minus size summed over every released block, i.e. memory
+        // that was reserved but never used
+        std::atomic<size_t> slackBytes{0};
+
+        explicit SiteStats(std::string siteName) : name(std::move(siteName)) {}
+
+        void reset() noexcept
+        {
+            for (auto *counter : {&allocations, &deallocations, &bytesAllocated, &liveBytes, &peakLiveBytes,
+                                  &reallocations, &elementsCopied, &elementsMoved, &peakCapacity, &peakSize,
+                                  &slackBytes})
+            {
+                counter->store(0, std::memory_order_relaxed);
+            }
+        }
+
+        static void raise(std::atomic<size_t> &peak, size_t value) noexcept
+        {
+            size_t current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+    };
+
+    class Registry
+    {
+    public:
+        static Registry &instance()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        // Stats of a site, created on first use. Returned references stay
+        // valid for the lifetime of the process
+        SiteStats &site(const std::string &name)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto &slot = m_sites[name];
+            if (!slot)
+            {
+                slot = std::make_unique<SiteStats>(name);
+            }
+            return *slot;
+        }
+
+        // Zeroes all counters. Sites stay registered since allocators keep
+        // pointers to them
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto &entry : m_sites)
+            {
+                entry.second->reset();
+            }
+        }
+
+        // One line per site, biggest allocators first
+        void dump(std::ostream &os) const
+        {
+            std::vector<const SiteStats *> sites;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (const auto &entry : m_sites)
+                {
+                    sites.push_back(entry.second.get());
+                }
+            }
+            std::sort(sites.begin(), sites.end(), [](const SiteStats *a, const SiteStats *b)
+                      { return a->bytesAllocated.load() > b->bytesAllocated.load(); });
+
+            os << "site | allocs | bytes | peak live bytes | reallocs | copied | moved | peak cap | peak size | slack bytes\n";
+            for (const SiteStats *s : sites)
+            {
+                os << s->name << " | " << s->allocations << " | " << s->bytesAllocated << " | "
+                   << s->peakLiveBytes << " | " << s->reallocations << " | " << s->elementsCopied << " | "
+                   << s->elementsMoved << " | " << s->peakCapacity << " | " << s->peakSize << " | "
+                   << s->slackBytes << "\n";
+            }
+        }
+
+    private:
+        Registry() = default;
+
+        mutable std::mutex m_mutex;
+        std::map<std::string, std::unique_ptr<SiteStats>> m_sites;
+    };
+
+    // Handle to a site, convertible to any instrumented::Allocator<T>
+    struct CallSite
+    {
+        SiteStats *stats;
+    };
+
+    // Names the site after the caller's file and line
+    inline CallSite here(std::source_location loc = std::source_location::current())
+    {
+        return CallSite{&Registry::instance().site(std::string(loc.file_name()) + ":" + std::to_string(loc.line()))};
+    }
+
+    inline CallSite named(const std::string &name)
+    {
+        return CallSite{&Registry::instance().site(name)};
+    }
+
+    template <typename T, typename Base = std::allocator<T>>
+    class Allocator
+    {
+        using base_traits = std::allocator_traits<Base>;
+
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        // Sites only label statistics, memory itself comes from Base
+        using is_always_equal = typename base_traits::is_always_equal;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = Allocator<U, typename base_traits::template rebind_alloc<U>>;
+        };
+
+        // Unattributed vectors are grouped by element type
+        Allocator() : m_site(&unnamedSite()) {}
+
+        Allocator(CallSite site, const Base &base = Base()) : m_base(base), m_site(site.stats) {}
+
+        template <typename U, typename B>
+        Allocator(const Allocator<U, B> &other) : m_base(other.base()), m_site(other.site()) {}
+
+        T *allocate(size_t n)
+        {
+            T *p = base_traits::allocate(m_base, n);
+            const size_t bytes = n * sizeof(T);
+            m_site->allocations.fetch_add(1, std::memory_order_relaxed);
+            m_site->bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+            const size_t live = m_site->liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            SiteStats::raise(m_site->peakLiveBytes, live);
+            SiteStats::raise(m_site->peakCapacity, n);
+            return p;
+        }
+
+        void deallocate(T *p, size_t n) noexcept
+        {
+            m_site->deallocations.fetch_add(1, std::memory_order_relaxed);
+            m_site->liveBytes.fetch_sub(n * sizeof(T), std::memory_order_relaxed);
+            base_traits::deallocate(m_base, p, n);
+        }
+
+        /*
+            Container hooks
+        */
+        void on_elements_copied(size_t count) noexcept
+        {
+            m_site->elementsCopied.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        void on_elements_moved(size_t count) noexcept
+        {
+            m_site->elementsMoved.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        void on_reallocate(size_t size, size_t oldCapacity, size_t newCapacity) noexcept
+        {
+            if (oldCapacity > 0)
+            {
+                m_site->reallocations.fetch_add(1, std::memory_order_relaxed);
+            }
+            SiteStats::raise(m_site->peakSize, size);
+            SiteStats::raise(m_site->peakCapacity, newCapacity);
+        }
+
+        // A block holding size live elements out of capacity is given back
+        void on_release(size_t size, size_t capacity) noexcept
+        {
+            SiteStats::raise(m_site->peakSize, size);
+            m_site->slackBytes.fetch_add((capacity - size) * sizeof(T), std::memory_order_relaxed);
+        }
+
+        const Base &base() const noexcept { return m_base; }
+        SiteStats *site() const noexcept { return m_site; }
+
+        template <typename U, typename B>
+        bool operator==(const Allocator<U, B> &other) const noexcept
+        {
+            return m_base == other.base();
+        }
+
+    private:
+        static SiteStats &unnamedSite()
+        {
+            static SiteStats &site = Registry::instance().site(std::string("<unnamed> ") + typeid(T).name());
+            return site;
+        }
+
+        [[no_unique_address]] Base m_base;
+        SiteStats *m_site;
+    };
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+class Vector;
+
+namespace instrumented
+{
+    // Vector whose events are attributed to the site given at construction
+    template <typename T, typename GrowthPolicy = DoublingGrowth>
+    using Vector = ::Vector<T, Allocator<T>, GrowthPolicy>;
+}
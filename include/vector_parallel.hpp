@@ -0,0 +1,515 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "vector.hpp"
+
+/*
+    Parallel algorithms over Vector on a work-stealing thread pool.
+
+    A range is cut into chunks of `grain` elements whose boundaries fall on
+    cache lines, so no two threads write to the same line. Chunk indices are
+    split recursively: a task keeps the left half and pushes the right half
+    onto its own deque, where idle threads steal it from the other end. The
+    calling thread takes part in the work while it waits, which also makes
+    nested parallel calls safe.
+
+    ParallelConstructionScope additionally lets Vector's own copy/fill
+    paths use the pool.
+
+    ThreadPool::global() is shared by every call that is not handed a pool.
+*/
+
+namespace vector_parallel
+{
+    // Chosen per call: about eight chunks per thread, never below kMinGrainBytes
+    inline constexpr size_t kAutoGrain = 0;
+    inline constexpr size_t kMinGrainBytes = 16 * 1024;
+    inline constexpr size_t kCacheLine = 64;
+
+    class ThreadPool
+    {
+    public:
+        // threads counts the caller, which helps while it waits: a pool of
+        // one thread runs everything inline
+        explicit ThreadPool(size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
+        {
+            const size_t workers = threads > 1 ? threads - 1 : 0;
+            m_queues.reserve(workers);
+            for (size_t i = 0; i < workers; ++i)
+            {
+                m_queues.push_back(std::make_unique<Queue>());
+            }
+            m_threads.reserve(workers);
+            for (size_t i = 0; i < workers; ++i)
+            {
+                m_threads.emplace_back([this, i]
+                                       { workerLoop(i); });
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (std::thread &t : m_threads)
+            {
+                t.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        static ThreadPool &global()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        // Threads working on a call, the caller included
+        [[nodiscard]] size_t size() const noexcept { return m_threads.size() + 1; }
+
+        // Calls body(i) for every i in [0, count) and returns once all are
+        // done. The first exception thrown by body is rethrown here, chunks
+        // not started yet are skipped
+        template <typename F>
+        void parallelFor(size_t count, const F &body)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            if (count == 1 || m_threads.empty())
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    body(i);
+                }
+                return;
+            }
+
+            Job<F> job(body, count);
+            split(job, 0, count);
+            while (job.remaining.load(std::memory_order_acquire) != 0)
+            {
+                if (!runOne())
+                {
+                    std::this_thread::yield();
+                }
+            }
+            if (job.error)
+            {
+                std::rethrow_exception(job.error);
+            }
+        }
+
+    private:
+        using Task = std::function<void()>;
+
+        // One per worker, on its own cache line. The owner pushes and pops
+        // at the back, thieves take from the front
+        struct alignas(kCacheLine) Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        template <typename F>
+        struct Job
+        {
+            Job(const F &f, size_t count) : body(f), remaining(count) {}
+
+            const F &body;
+            std::atomic<size_t> remaining;
+            std::atomic<bool> failed{false};
+            std::mutex errorMutex;
+            std::exception_ptr error;
+        };
+
+        // Pushes right halves until [lo, hi) is a single chunk, then runs it
+        template <typename F>
+        void split(Job<F> &job, size_t lo, size_t hi)
+        {
+            while (hi - lo > 1)
+            {
+                const size_t mid = lo + (hi - lo) / 2;
+                submit([this, &job, mid, hi]
+                       { split(job, mid, hi); });
+                hi = mid;
+            }
+
+            if (!job.failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    job.body(lo);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(job.errorMutex);
+                    if (!job.error)
+                    {
+                        job.error = std::current_exception();
+                    }
+                    job.failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            job.remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        void submit(Task task)
+        {
+            // Workers keep their own splits local; other threads spread work
+            const size_t index = t_pool == this ? t_index : m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+            {
+                std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+                m_queues[index]->tasks.push_back(std::move(task));
+            }
+            m_queued.fetch_add(1, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_wake.notify_one();
+        }
+
+        // Runs one task: the newest local one, else the oldest of a victim
+        bool runOne()
+        {
+            Task task;
+            const bool isWorker = t_pool == this;
+            if (isWorker && popBack(*m_queues[t_index], task))
+            {
+                run(task);
+                return true;
+            }
+
+            const size_t start = isWorker ? t_index + 1 : m_next.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < m_queues.size(); ++i)
+            {
+                if (popFront(*m_queues[(start + i) % m_queues.size()], task))
+                {
+                    run(task);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void run(Task &task)
+        {
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            task();
+        }
+
+        static bool popBack(Queue &queue, Task &task)
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                return false;
+            }
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return true;
+        }
+
+        static bool popFront(Queue &queue, Task &task)
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                return false;
+            }
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+
+        void workerLoop(size_t index)
+        {
+            t_pool = this;
+            t_index = index;
+            while (true)
+            {
+                if (runOne())
+                {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_sleepMutex);
+                m_wake.wait(lock, [this]
+                            { return m_stop || m_queued.load(std::memory_order_acquire) > 0; });
+                if (m_stop && m_queued.load(std::memory_order_acquire) == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        inline static thread_local ThreadPool *t_pool = nullptr;
+        inline static thread_local size_t t_index = 0;
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread> m_threads;
+        std::atomic<size_t> m_queued{0};
+        std::atomic<size_t> m_next{0};
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wake;
+        bool m_stop = false;
+    };
+
+    // Elements built at once before ParallelConstructionScope splits the work
+    inline constexpr size_t kParallelConstructionThreshold = 64 * 1024;
+
+    /*
+        While alive, Vector copy construction, assign and resize(n, value) on
+        this thread construct their elements on pool once at least threshold
+        of them are built in one go. Only copies out of contiguous memory and
+        fills are split (which includes insert and append_range from
+        contiguous ranges); any other iterator or view is still evaluated in
+        order on this thread. Elements keep the strong guarantee: if
+        any thread throws, everything constructed so far is destroyed and the
+        exception reaches the caller. Allocators with a custom construct
+        (e.g. pmr containers of pmr strings) stay serial. Scopes nest; the
+        previous mode is restored on destruction.
+
+            vector_parallel::ParallelConstructionScope parallel;
+            Vector<std::string> snapshot(table);
+    */
+    class ParallelConstructionScope : public vector_detail::ParallelExecutor
+    {
+    public:
+        explicit ParallelConstructionScope(size_t threshold = kParallelConstructionThreshold,
+                                           ThreadPool &pool = ThreadPool::global())
+            : vector_detail::ParallelExecutor{&runOnPool, threshold, pool.size()},
+              m_pool(pool), m_previous(vector_detail::currentParallelExecutor())
+        {
+            vector_detail::currentParallelExecutor() = this;
+        }
+
+        ~ParallelConstructionScope()
+        {
+            vector_detail::currentParallelExecutor() = m_previous;
+        }
+
+        ParallelConstructionScope(const ParallelConstructionScope &) = delete;
+        ParallelConstructionScope &operator=(const ParallelConstructionScope &) = delete;
+
+    private:
+        // The pool rethrows the first exception of any chunk
+        static void runOnPool(vector_detail::ParallelExecutor &self, size_t chunks, ChunkFn chunk, void *context)
+        {
+            static_cast<ParallelConstructionScope &>(self).m_pool.parallelFor(chunks, [&](size_t c)
+                                                                              { chunk(context, c); });
+        }
+
+        ThreadPool &m_pool;
+        vector_detail::ParallelExecutor *m_previous;
+    };
+
+    namespace parallel_detail
+    {
+        /*
+            Cuts n elements starting at data into chunks of about grain
+            elements. Every boundary but the ends lies on a cache line when
+            sizeof(T) divides the line size
+        */
+        template <typename T>
+        struct Chunking
+        {
+            Chunking(const T *data, size_t n, size_t grain, size_t threads) : size(n)
+            {
+                size_t perLine = 1;
+                if (kCacheLine % sizeof(T) == 0 && reinterpret_cast<uintptr_t>(data) % sizeof(T) == 0)
+                {
+                    perLine = kCacheLine / sizeof(T);
+                    const size_t misalignment = reinterpret_cast<uintptr_t>(data) % kCacheLine;
+                    offset = (kCacheLine - misalignment) % kCacheLine / sizeof(T);
+                }
+
+                if (grain == kAutoGrain)
+                {
+                    grain = std::max(n / (threads * 8), std::max<size_t>(1, kMinGrainBytes / sizeof(T)));
+                }
+                step = (std::max<size_t>(grain, 1) + perLine - 1) / perLine * perLine;
+
+                if (n == 0)
+                {
+                    chunks = 0;
+                }
+                else if (n <= offset + step)
+                {
+                    chunks = 1;
+                }
+                else
+                {
+                    chunks = (n - offset + step - 1) / step;
+                }
+            }
+
+            // First element of chunk i, i in [0, chunks]
+            size_t begin(size_t i) const noexcept
+            {
+                return i == 0 ? 0 : std::min(size, offset + i * step);
+            }
+
+            size_t end(size_t i) const noexcept { return begin(i + 1); }
+
+            size_t size;
+            size_t offset = 0;
+            size_t step = 1;
+            size_t chunks = 0;
+        };
+
+        template <typename T, typename F>
+        void forEachChunk(T *data, size_t n, size_t grain, ThreadPool &pool, const F &body)
+        {
+            const Chunking<T> chunking(data, n, grain, pool.size());
+            pool.parallelFor(chunking.chunks, [&](size_t i)
+                             { body(chunking.begin(i), chunking.end(i)); });
+        }
+    }
+
+    // f(element) for every element, in no particular order
+    template <typename T, typename A, typename G, typename F>
+    void parallel_for_each(Vector<T, A, G> &v, F f, size_t grain = kAutoGrain,
+                           ThreadPool &pool = ThreadPool::global())
+    {
+        T *data = v.data();
+        parallel_detail::forEachChunk(data, v.size(), grain, pool, [&](size_t begin, size_t end)
+                                      {
+            for (size_t i = begin; i < end; ++i)
+            {
+                f(data[i]);
+            } });
+    }
+
+    // op must be associative; chunks are combined left to right, each
+    // starting from its first element, and the result is op(init, ...).
+    // So elements must convert to U and op also has to combine two Us
+    template <typename T, typename A, typename G, typename U, typename BinaryOp>
+        requires std::convertible_to<const T &, U> &&
+                 std::invocable<BinaryOp &, U, const T &> &&
+                 std::invocable<BinaryOp &, U, U>
+    U parallel_reduce(const Vector<T, A, G> &v, U init, BinaryOp op, size_t grain = kAutoGrain,
+                      ThreadPool &pool = ThreadPool::global())
+    {
+        const T *data = v.data();
+        const parallel_detail::Chunking<T> chunking(data, v.size(), grain, pool.size());
+        std::vector<std::optional<U>> partials(chunking.chunks);
+
+        pool.parallelFor(chunking.chunks, [&](size_t c)
+                         {
+            const size_t end = chunking.end(c);
+            size_t i = chunking.begin(c);
+            U acc = data[i];
+            for (++i; i < end; ++i)
+            {
+                acc = op(std::move(acc), data[i]);
+            }
+            partials[c].emplace(std::move(acc)); });
+
+        for (std::optional<U> &partial : partials)
+        {
+            init = op(std::move(init), std::move(*partial));
+        }
+        return init;
+    }
+
+    template <typename T, typename A, typename G>
+    T parallel_reduce(const Vector<T, A, G> &v, size_t grain = kAutoGrain, ThreadPool &pool = ThreadPool::global())
+    {
+        return parallel_reduce(v, T{}, std::plus<>{}, grain, pool);
+    }
+
+    // out[i] = f(in[i]). out must already hold in.size() elements and may
+    // be the same vector as in
+    template <typename T, typename A, typename G, typename U, typename A2, typename G2, typename F>
+    void parallel_transform(const Vector<T, A, G> &in, Vector<U, A2, G2> &out, F f, size_t grain = kAutoGrain,
+                            ThreadPool &pool = ThreadPool::global())
+    {
+        if (in.size() != out.size())
+        {
+            throw std::invalid_argument("parallel_transform(): size mismatch");
+        }
+        const T *source = in.data();
+        U *target = out.data();
+        parallel_detail::forEachChunk(target, out.size(), grain, pool, [&](size_t begin, size_t end)
+                                      {
+            for (size_t i = begin; i < end; ++i)
+            {
+                target[i] = f(source[i]);
+            } });
+    }
+
+    // Copy-assigns src into dst, which must hold src.size() elements
+    template <typename T, typename A, typename G, typename A2, typename G2>
+    void parallel_copy(const Vector<T, A, G> &src, Vector<T, A2, G2> &dst, size_t grain = kAutoGrain,
+                       ThreadPool &pool = ThreadPool::global())
+    {
+        if (src.size() != dst.size())
+        {
+            throw std::invalid_argument("parallel_copy(): size mismatch");
+        }
+        const T *source = src.data();
+        T *target = dst.data();
+        parallel_detail::forEachChunk(target, dst.size(), grain, pool, [&](size_t begin, size_t end)
+                                      {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                std::memcpy(target + begin, source + begin, (end - begin) * sizeof(T));
+            }
+            else
+            {
+                std::copy(source + begin, source + end, target + begin);
+            } });
+    }
+
+    // Sorts chunks in parallel, then merges neighbouring runs pairwise,
+    // doubling the run length each round. Not stable
+    template <typename T, typename A, typename G, typename Compare = std::less<>>
+    void parallel_sort(Vector<T, A, G> &v, Compare comp = Compare(), size_t grain = kAutoGrain,
+                       ThreadPool &pool = ThreadPool::global())
+    {
+        T *data = v.data();
+        const parallel_detail::Chunking<T> chunking(data, v.size(), grain, pool.size());
+        const size_t chunks = chunking.chunks;
+
+        pool.parallelFor(chunks, [&](size_t c)
+                         { std::sort(data + chunking.begin(c), data + chunking.end(c), comp); });
+
+        for (size_t width = 1; width < chunks; width *= 2)
+        {
+            const size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+            pool.parallelFor(pairs, [&](size_t p)
+                             {
+                const size_t first = p * 2 * width;
+                const size_t middle = std::min(first + width, chunks);
+                const size_t last = std::min(first + 2 * width, chunks);
+                if (middle < last)
+                {
+                    std::inplace_merge(data + chunking.begin(first), data + chunking.begin(middle),
+                                       data + chunking.begin(last), comp);
+                } });
+        }
+    }
+}
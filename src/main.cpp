@@ -1,6 +1,5 @@
 #include <iostream>
 #include <list>
-#include <chrono>
 #include <cstdlib>
 #include <cstdint>
 #include <vector>
@@ -61,44 +60,12 @@ void compareAddresses()
     }
 }
 
-void benchmarkIteration()
-{
-    std::cout << "\n--- Iteration Benchmark ---\n";
-
-    Vector<int> vec;
-    std::list<int> lst;
-
-    for (int i = 0; i < 1000000; ++i)
-    {
-        vec.push_back(i);
-        lst.push_back(i);
-    }
-
-    volatile long long sum = 0;
-
-    auto start = std::chrono::high_resolution_clock::now();
-    for (auto v : vec)
-    {
-        sum += v;
-    }
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "Vector iteration time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " µs\n";
-
-    start = std::chrono::high_resolution_clock::now();
-    for (int v : lst)
-    {
-        sum += v;
-    }
-    end = std::chrono::high_resolution_clock::now();
-    std::cout << "List iteration time:   " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " µs\n";
-}
-
 int main()
 {
-    // Compare performance of list and vector
+    // Compare memory layout of list and vector
+    // (performance comparisons live in benchmarks/, see vector_bench)
     {
         compareAddresses();
-        benchmarkIteration();
     }
 
     // Construct from initializer list
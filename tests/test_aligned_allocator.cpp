@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "aligned_allocator.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+    bool alignedTo(const void *p, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+    }
+
+    // Pages of [p, p + bytes) currently backed by memory
+    size_t residentPages(const void *p, size_t bytes) {
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        std::vector<unsigned char> state((bytes + page - 1) / page);
+        if (::mincore(const_cast<void *>(p), bytes, state.data()) != 0) {
+            return 0;
+        }
+        return static_cast<size_t>(std::count_if(state.begin(), state.end(), [](unsigned char s) { return s & 1; }));
+    }
+}
+
+TEST(AlignedAllocatorTest, DataIsAlignedThroughGrowth) {
+    AlignedVector<double, 128> v;
+    for (int i = 0; i < 10000; ++i) {
+        v.push_back(i * 0.5);
+        ASSERT_TRUE(alignedTo(v.data(), 128));
+    }
+    v.shrink_to_fit();
+    EXPECT_TRUE(alignedTo(v.data(), 128));
+    EXPECT_EQ(v[9999], 9999 * 0.5);
+
+    AlignedVector<std::string> strings;
+    strings.push_back("aligned");
+    EXPECT_TRUE(alignedTo(strings.data(), 64));
+}
+
+TEST(AlignedAllocatorTest, RebindKeepsAtLeastTypeAlignment) {
+    struct alignas(256) Wide {
+        char bytes[256];
+    };
+    using Rebound = std::allocator_traits<AlignedAllocator<char, 64>>::rebind_alloc<Wide>;
+    EXPECT_EQ(Rebound::kAlignment, 256u);
+    EXPECT_TRUE((AlignedAllocator<int, 64>() == AlignedAllocator<char, 64>()));
+    EXPECT_FALSE((AlignedAllocator<int, 64>() == AlignedAllocator<int, 128>()));
+}
+
+TEST(HugePageAllocatorTest, LargeBlocksAreHugePageAligned) {
+    Vector<uint64_t, HugePageAllocator<uint64_t>> v;
+    for (uint64_t i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    // Small blocks are still cache-line aligned
+    EXPECT_TRUE(alignedTo(v.data(), 64));
+
+    v.reserve(1 << 20);
+    EXPECT_TRUE(alignedTo(v.data(), HugePageAllocator<uint64_t>::kHugePageSize));
+    EXPECT_EQ(v[99], 99u);
+
+    for (uint64_t i = 100; i < (1 << 21); ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), uint64_t(0)), (uint64_t(1) << 21) * ((uint64_t(1) << 21) - 1) / 2);
+
+    v.resize(10);
+    v.shrink_to_fit();
+    EXPECT_EQ(v[9], 9u);
+}
+
+TEST(HugePageAllocatorTest, ExplicitFallsBackWhenPoolIsEmpty) {
+    Vector<int, HugePageAllocator<int, HugePages::Explicit>> v;
+    v.resize(3 << 20, 7);
+    EXPECT_EQ(v[(3 << 20) - 1], 7);
+    EXPECT_TRUE(alignedTo(v.data(), HugePageAllocator<int>::kHugePageSize));
+}
+
+TEST(HugePageAllocatorTest, PrefaultPopulatesOnReserve) {
+    constexpr size_t kBytes = size_t(8) << 20;
+    Vector<char, HugePageAllocator<char, HugePages::None, true>> v;
+    v.reserve(kBytes);
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    EXPECT_EQ(residentPages(v.data(), kBytes), kBytes / page);
+    EXPECT_TRUE(v.empty());
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include "bit_vector.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#if defined(BIT_VECTOR_X86)
+#error "bit_vector.hpp leaks BIT_VECTOR_X86"
+#endif
+
+namespace {
+    std::vector<bool> randomBits(size_t n, double density, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution coin(density);
+        std::vector<bool> bits(n);
+        for (size_t i = 0; i < n; ++i) {
+            bits[i] = coin(rng);
+        }
+        return bits;
+    }
+
+    BitVector toBitVector(const std::vector<bool> &bits) {
+        BitVector result;
+        for (const bool bit : bits) {
+            result.push_back(bit);
+        }
+        return result;
+    }
+
+    void expectSameBits(const BitVector &actual, const std::vector<bool> &expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(actual[i], expected[i]) << "bit " << i;
+        }
+        EXPECT_EQ(actual.count(), static_cast<size_t>(std::count(expected.begin(), expected.end(), true)));
+    }
+}
+
+static_assert(std::ranges::random_access_range<BitVector>);
+static_assert(std::ranges::random_access_range<const BitVector>);
+static_assert(std::indirectly_writable<BitVector::iterator, bool>);
+
+TEST(BitVectorTest, ProxyReferencesAndAccess) {
+    BitVector bits{true, false, true};
+    EXPECT_EQ(bits.size(), 3u);
+    EXPECT_TRUE(bits[0]);
+    EXPECT_FALSE(bits[1]);
+
+    bits[1] = true;
+    bits[0] = bits[1];
+    bits[2].flip();
+    EXPECT_TRUE(bits.test(0));
+    EXPECT_TRUE(bits.test(1));
+    EXPECT_FALSE(bits.test(2));
+    EXPECT_FALSE(~bits[0]);
+
+    swap(bits[0], bits[2]);
+    EXPECT_FALSE(bits[0]);
+    EXPECT_TRUE(bits[2]);
+
+    bits.set(0);
+    bits.reset(1);
+    bits.flip(2);
+    EXPECT_EQ(bits, (BitVector{true, false, false}));
+    EXPECT_THROW(bits.at(3), std::out_of_range);
+    EXPECT_THROW(std::as_const(bits).at(3), std::out_of_range);
+
+    bits.pop_back();
+    EXPECT_EQ(bits.size(), 2u);
+    bits.clear();
+    EXPECT_THROW(bits.pop_back(), std::out_of_range);
+}
+
+TEST(BitVectorTest, GrowsAWordAtATime) {
+    const std::vector<bool> expected = randomBits(1000, 0.5, 1);
+    BitVector pushed = toBitVector(expected);
+    expectSameBits(pushed, expected);
+    EXPECT_EQ(pushed.words().size(), 16u);
+
+    // append_bits in chunks of every width matches push_back
+    BitVector appended;
+    size_t width = 1;
+    for (size_t i = 0; i < expected.size(); i += width, width = width % 64 + 1) {
+        uint64_t chunk = ~uint64_t(0) << 63; // junk above the width is ignored
+        const size_t n = std::min(width, expected.size() - i);
+        for (size_t j = 0; j < n; ++j) {
+            chunk = expected[i + j] ? chunk | (uint64_t(1) << j) : chunk & ~(uint64_t(1) << j);
+        }
+        appended.append_bits(chunk, n);
+    }
+    EXPECT_EQ(appended, pushed);
+
+    // Growing with ones, then shrinking, keeps the tail of the last word clear
+    BitVector filled(70, true);
+    EXPECT_EQ(filled.count(), 70u);
+    filled.resize(130, true);
+    filled.resize(200);
+    EXPECT_EQ(filled.count(), 130u);
+    filled.resize(65);
+    EXPECT_EQ(filled.count(), 65u);
+    EXPECT_EQ(filled.words()[1], 1u);
+    filled.resize(66, false);
+    EXPECT_FALSE(filled[65]);
+    EXPECT_FALSE(filled.all());
+    filled.pop_back();
+    EXPECT_TRUE(filled.all());
+
+    filled.flip();
+    EXPECT_TRUE(filled.none());
+    filled.set();
+    EXPECT_EQ(filled.count(), 65u);
+    filled.reset();
+    EXPECT_FALSE(filled.any());
+}
+
+TEST(BitVectorTest, BulkOperationsMatchBitwiseLoop) {
+    for (size_t n : {0, 1, 63, 64, 65, 1000}) {
+        const std::vector<bool> a = randomBits(n, 0.5, 2);
+        const std::vector<bool> b = randomBits(n, 0.3, 3);
+        std::vector<bool> andBits(n), orBits(n), xorBits(n), notBits(n);
+        for (size_t i = 0; i < n; ++i) {
+            andBits[i] = a[i] && b[i];
+            orBits[i] = a[i] || b[i];
+            xorBits[i] = a[i] != b[i];
+            notBits[i] = !a[i];
+        }
+        const BitVector x = toBitVector(a);
+        const BitVector y = toBitVector(b);
+        expectSameBits(x & y, andBits);
+        expectSameBits(x | y, orBits);
+        expectSameBits(x ^ y, xorBits);
+        expectSameBits(~x, notBits);
+    }
+
+    BitVector shorter(10);
+    EXPECT_THROW(shorter |= BitVector(11), std::invalid_argument);
+}
+
+TEST(BitVectorTest, CountCoversEveryKernelTail) {
+    std::mt19937_64 rng(4);
+    for (size_t n = 0; n < 300; ++n) {
+        BitVector bits;
+        size_t expected = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t word = rng();
+            bits.append_bits(word, 64);
+            expected += static_cast<size_t>(std::popcount(word));
+        }
+        ASSERT_EQ(bits.count(), expected) << n << " words";
+    }
+}
+
+TEST(BitVectorTest, WorksWithStandardAlgorithms) {
+    BitVector bits(100);
+    std::ranges::fill(bits.begin() + 10, bits.begin() + 20, true);
+    EXPECT_EQ(bits.count(), 10u);
+    EXPECT_EQ(std::count(bits.cbegin(), bits.cend(), true), 10);
+    EXPECT_EQ(std::ranges::find(bits, true).index(), 10u);
+
+    std::ranges::reverse(bits);
+    EXPECT_EQ(std::ranges::find(bits, true) - bits.begin(), 80);
+}
+
+TEST(BitVectorTest, MoveAcrossUnequalAllocatorsLeavesSourceEmpty) {
+    using PmrBitVector = BasicBitVector<std::pmr::polymorphic_allocator<uint64_t>>;
+    std::pmr::monotonic_buffer_resource first;
+    std::pmr::monotonic_buffer_resource second;
+    PmrBitVector source(130, true, &first);
+    PmrBitVector target(&second);
+
+    // The allocator does not propagate, so the words are copied over
+    target = std::move(source);
+    EXPECT_EQ(target.get_allocator().resource(), &second);
+    EXPECT_EQ(target.count(), 130u);
+    EXPECT_TRUE(source.empty());
+    EXPECT_TRUE(source.words().empty());
+
+    // Regrowing the moved-from vector starts from clear words
+    source.resize(130);
+    EXPECT_TRUE(source.none());
+}
+
+TEST(RankSelectTest, SelectInWordMatchesLoop) {
+    std::mt19937_64 rng(5);
+    for (int trial = 0; trial < 2000; ++trial) {
+        uint64_t word = rng() & rng();
+        if (trial % 3 == 0) {
+            word |= rng();
+        }
+        unsigned k = 0;
+        for (unsigned bit = 0; bit < 64; ++bit) {
+            if ((word >> bit) & 1) {
+                ASSERT_EQ(bit_detail::selectInWord(word, k), bit) << std::hex << word << " k=" << std::dec << k;
+                ++k;
+            }
+        }
+        ASSERT_EQ(bit_detail::popcount(word), k);
+    }
+}
+
+TEST(RankSelectTest, MatchesNaiveScan) {
+    for (double density : {0.0, 0.002, 0.1, 0.5, 0.95, 1.0}) {
+        for (size_t n : {0, 1, 63, 511, 512, 513, 5000}) {
+            const std::vector<bool> expected = randomBits(n, density, static_cast<uint32_t>(n));
+            const BitVector bits = toBitVector(expected);
+            const RankSelect index(bits);
+
+            size_t ones = 0;
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(index.rank1(i), ones) << "n=" << n << " i=" << i;
+                ASSERT_EQ(index.rank0(i), i - ones);
+                if (expected[i]) {
+                    ASSERT_EQ(index.select1(ones), i) << "n=" << n << " density=" << density;
+                    ++ones;
+                } else {
+                    ASSERT_EQ(index.select0(i - ones), i) << "n=" << n << " density=" << density;
+                }
+            }
+            EXPECT_EQ(index.ones(), ones);
+            EXPECT_EQ(index.zeros(), n - ones);
+            EXPECT_EQ(index.rank1(n), ones);
+            EXPECT_EQ(index.select1(ones), n);
+            EXPECT_EQ(index.select0(n - ones), n);
+        }
+    }
+}
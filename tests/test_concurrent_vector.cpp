@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "concurrent_vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Counted {
+        static inline std::atomic<int> live = 0;
+
+        int value;
+
+        Counted(int v) : value(v) {
+            if (v < 0) {
+                throw std::invalid_argument("negative");
+            }
+            ++live;
+        }
+        Counted(const Counted &other) : value(other.value) {
+            if (value == 13) {
+                throw std::runtime_error("unlucky copy");
+            }
+            ++live;
+        }
+        Counted &operator=(const Counted &) = default;
+        ~Counted() { --live; }
+    };
+}
+
+TEST(ConcurrentVectorTest, PushBackAndIndexAcrossSegments) {
+    ConcurrentVector<int> v;
+    EXPECT_TRUE(v.empty());
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(v.push_back(i), static_cast<size_t>(i));
+    }
+    EXPECT_EQ(v.size(), 10000u);
+    EXPECT_GE(v.capacity(), 10000u);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(v[i], i);
+    }
+    EXPECT_EQ(v.at(9999), 9999);
+    EXPECT_TRUE(v.ready(9999));
+    EXPECT_FALSE(v.ready(10000));
+    EXPECT_THROW(v.at(10000), std::out_of_range);
+}
+
+TEST(ConcurrentVectorTest, ReferencesStayValidAcrossGrowth) {
+    ConcurrentVector<std::string> v;
+    v.push_back("first");
+    const std::string *first = &v[0];
+    for (int i = 0; i < 5000; ++i) {
+        v.emplace_back(20, 'x');
+    }
+    EXPECT_EQ(&v[0], first);
+    EXPECT_EQ(*first, "first");
+}
+
+TEST(ConcurrentVectorTest, ConcurrentPushBackKeepsEveryElement) {
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 20000;
+    ConcurrentVector<int> v;
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&v, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                const size_t index = v.push_back(t * kPerThread + i);
+                ASSERT_EQ(v[index], t * kPerThread + i);
+            }
+        });
+    }
+    for (std::thread &writer : writers) {
+        writer.join();
+    }
+
+    ASSERT_EQ(v.size(), static_cast<size_t>(kThreads * kPerThread));
+    Vector<int> flat = v.to_vector();
+    std::sort(flat.begin(), flat.end());
+    for (int i = 0; i < kThreads * kPerThread; ++i) {
+        ASSERT_EQ(flat[i], i);
+    }
+}
+
+TEST(ConcurrentVectorTest, GrowByClaimsConsecutiveSlots) {
+    ConcurrentVector<int> v;
+    v.push_back(1);
+    const size_t first = v.grow_by(100, 7);
+    EXPECT_EQ(first, 1u);
+    EXPECT_EQ(v.size(), 101u);
+    EXPECT_EQ(v[100], 7);
+
+    const size_t zeros = v.grow_by(50);
+    EXPECT_EQ(v[zeros + 49], 0);
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&v, t] {
+            for (int i = 0; i < 100; ++i) {
+                const size_t base = v.grow_by(10, t);
+                for (size_t j = base; j < base + 10; ++j) {
+                    ASSERT_EQ(v[j], t);
+                }
+            }
+        });
+    }
+    for (std::thread &writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(v.size(), 151u + 4000u);
+}
+
+TEST(ConcurrentVectorTest, ToVectorMovesOutAndClears) {
+    ConcurrentVector<std::unique_ptr<int>> v;
+    v.reserve(100);
+    EXPECT_GE(v.capacity(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(std::make_unique<int>(i));
+    }
+
+    Vector<std::unique_ptr<int>> flat = std::move(v).to_vector();
+    EXPECT_EQ(flat.size(), 100u);
+    EXPECT_EQ(*flat[42], 42);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 0u);
+
+    v.push_back(std::make_unique<int>(5));
+    EXPECT_EQ(*v[0], 5);
+}
+
+TEST(ConcurrentVectorTest, ThrowingConstructionLeavesEmptySlot) {
+    {
+        ConcurrentVector<Counted> v;
+        v.emplace_back(1);
+        EXPECT_THROW(v.emplace_back(-1), std::invalid_argument);
+        v.emplace_back(3);
+
+        EXPECT_EQ(v.size(), 3u);
+        EXPECT_TRUE(v.ready(0));
+        EXPECT_FALSE(v.ready(1));
+        EXPECT_THROW(v.at(1), std::out_of_range);
+        EXPECT_EQ(v.at(2).value, 3);
+
+        Vector<Counted> flat = v.to_vector();
+        ASSERT_EQ(flat.size(), 2u);
+        EXPECT_EQ(flat[0].value, 1);
+        EXPECT_EQ(flat[1].value, 3);
+        EXPECT_EQ(Counted::live, 4);
+    }
+    EXPECT_EQ(Counted::live, 0);
+
+    {
+        ConcurrentVector<Counted> v;
+        v.emplace_back(1);
+        EXPECT_THROW(v.grow_by(5, Counted(13)), std::runtime_error);
+        EXPECT_EQ(v.size(), 6u);
+        EXPECT_FALSE(v.ready(3));
+        EXPECT_EQ(v.to_vector().size(), 1u);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
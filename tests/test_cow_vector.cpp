@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "cow_vector.hpp"
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct CopyCounted {
+        static inline int copies = 0;
+
+        int value;
+
+        CopyCounted(int v) : value(v) {}
+        CopyCounted(const CopyCounted &other) : value(other.value) { ++copies; }
+        CopyCounted(CopyCounted &&other) noexcept : value(other.value) {}
+        CopyCounted &operator=(const CopyCounted &) = default;
+    };
+}
+
+TEST(CowVectorTest, CopiesShareUntilFirstWrite) {
+    CowVector<std::string> a{"x", "y", "z"};
+    CowVector<std::string> b = a;
+    EXPECT_TRUE(a.shares_with(b));
+    EXPECT_EQ(a.use_count(), 2u);
+    EXPECT_EQ(a.data(), b.data());
+
+    b.push_back("w");
+    EXPECT_FALSE(a.shares_with(b));
+    EXPECT_TRUE(a.unique());
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(b.size(), 4u);
+    EXPECT_EQ(b[3], "w");
+
+    // Unshared writes modify in place
+    const std::string *before = b.data();
+    b.set(0, "first");
+    EXPECT_EQ(b.data(), before);
+    EXPECT_EQ(a[0], "x");
+    EXPECT_EQ(b.at(0), "first");
+    EXPECT_THROW(b.at(4), std::out_of_range);
+    EXPECT_THROW(b.set(4, ""), std::out_of_range);
+}
+
+TEST(CowVectorTest, FreezeAndThawMoveTheBuffer) {
+    Vector<CopyCounted> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i);
+    }
+    const CopyCounted *buffer = v.data();
+    CopyCounted::copies = 0;
+
+    CowVector<CopyCounted> snapshot = freeze(std::move(v));
+    EXPECT_EQ(snapshot.data(), buffer);
+
+    std::vector<CowVector<CopyCounted>> readers(10, snapshot);
+    EXPECT_EQ(snapshot.use_count(), 11u);
+    EXPECT_EQ(readers[7][42].value, 42);
+    EXPECT_EQ(CopyCounted::copies, 0);
+
+    // Shared: thaw has to copy
+    Vector<CopyCounted> copied = std::move(readers[0]).thaw();
+    EXPECT_EQ(CopyCounted::copies, 100);
+    EXPECT_NE(copied.data(), buffer);
+    EXPECT_EQ(snapshot.use_count(), 10u);
+
+    readers.clear();
+    Vector<CopyCounted> back = std::move(snapshot).thaw();
+    EXPECT_EQ(back.data(), buffer);
+    EXPECT_EQ(CopyCounted::copies, 100);
+    EXPECT_TRUE(snapshot.empty());
+}
+
+TEST(CowVectorTest, EditAndModifiers) {
+    CowVector<int> a;
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(a.use_count(), 0u);
+    EXPECT_EQ(a.begin(), a.end());
+
+    a.resize(5);
+    a.edit()[2] = 7;
+    a.emplace_back(9);
+    CowVector<int> b = a;
+
+    b.pop_back();
+    b.reserve(100);
+    EXPECT_EQ(a.size(), 6u);
+    EXPECT_EQ(b.size(), 5u);
+    EXPECT_GE(b.capacity(), 100u);
+    EXPECT_EQ(std::accumulate(a.begin(), a.end(), 0), 16);
+    EXPECT_EQ(b.view()[2], 7);
+
+    b.clear();
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.size(), 6u);
+    EXPECT_THROW(b.pop_back(), std::out_of_range);
+
+    b = a;
+    EXPECT_TRUE(b.shares_with(a));
+    CowVector<int> c = std::move(b);
+    EXPECT_TRUE(c.shares_with(a));
+    EXPECT_EQ(a.use_count(), 2u);
+}
+
+TEST(CowVectorTest, ReadersOnManyThreads) {
+    Vector<int> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+    }
+    const CowVector<int> snapshot = freeze(std::move(v));
+
+    std::atomic<long> total = 0;
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 8; ++t) {
+        readers.emplace_back([&snapshot, &total, t] {
+            for (int round = 0; round < 50; ++round) {
+                CowVector<int> mine = snapshot;
+                total += std::accumulate(mine.begin(), mine.end(), 0L);
+                if (round % 10 == t) {
+                    // Private copy, the others keep sharing
+                    mine.push_back(1);
+                }
+            }
+        });
+    }
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(total, 8L * 50 * 999 * 1000 / 2);
+    EXPECT_EQ(snapshot.use_count(), 1u);
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include "flat_map.hpp"
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    // Throws when constructed from the value 13
+    struct Picky {
+        int value;
+
+        Picky(int v) : value(v) {
+            if (v == 13) {
+                throw std::runtime_error("unlucky");
+            }
+        }
+    };
+
+    // Copies throw while failCopies is set; the move may throw too, so
+    // containers have to copy it to stay unchanged on exception
+    struct FragileCopy {
+        static inline bool failCopies = false;
+        int value;
+
+        FragileCopy(int v) : value(v) {}
+        FragileCopy(const FragileCopy &other) : value(other.value) {
+            if (failCopies) {
+                throw std::runtime_error("copy");
+            }
+        }
+        FragileCopy(FragileCopy &&other) noexcept(false) : value(other.value) {}
+        FragileCopy &operator=(const FragileCopy &) = default;
+        FragileCopy &operator=(FragileCopy &&) = default;
+    };
+
+    // Compares lookups of FlatMap<Search> against std::map on random data,
+    // for sizes around the Eytzinger tree's level boundaries
+    template <typename Search>
+    void expectSameAsStdMap() {
+        std::mt19937 rng(42);
+        for (int n : {0, 1, 2, 3, 7, 8, 15, 16, 17, 100, 1000}) {
+            std::vector<std::pair<int, int>> pairs;
+            for (int i = 0; i < n; ++i) {
+                pairs.emplace_back(static_cast<int>(rng() % 3000), i);
+            }
+            const FlatMap<int, int, std::less<int>, Search> flat(pairs);
+            std::map<int, int> reference;
+            reference.insert(pairs.begin(), pairs.end());
+
+            ASSERT_EQ(flat.size(), reference.size());
+            for (int key = -5; key < 3005; ++key) {
+                const auto it = flat.lower_bound(key);
+                const auto expected = reference.lower_bound(key);
+                ASSERT_EQ(it == flat.end(), expected == reference.end()) << "n=" << n << " key=" << key;
+                if (expected != reference.end()) {
+                    EXPECT_EQ(it->first, expected->first);
+                    EXPECT_EQ(it->second, expected->second);
+                }
+                EXPECT_EQ(flat.contains(key), reference.contains(key));
+                EXPECT_EQ(flat.upper_bound(key) == flat.end(), reference.upper_bound(key) == reference.end());
+            }
+        }
+    }
+}
+
+TEST(FlatSetTest, KeepsKeysSortedAndUnique) {
+    FlatSet<int> set{5, 1, 3, 1, 4};
+    EXPECT_EQ(set.size(), 4u);
+    EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+
+    const auto [it, inserted] = set.insert(2);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*it, 2);
+    EXPECT_FALSE(set.insert(4).second);
+    EXPECT_EQ(set.emplace(0).first, set.begin());
+
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_FALSE(set.contains(6));
+    EXPECT_EQ(set.count(5), 1u);
+    EXPECT_EQ(*set.lower_bound(3), 3);
+    EXPECT_EQ(*set.upper_bound(3), 4);
+    EXPECT_EQ(set.upper_bound(5), set.end());
+    const auto range = set.equal_range(4);
+    EXPECT_EQ(range.second - range.first, 1);
+
+    EXPECT_EQ(set.erase(3), 1u);
+    EXPECT_EQ(set.erase(3), 0u);
+    EXPECT_EQ(*set.erase(set.begin()), 1);
+    EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{1, 2, 4, 5}));
+}
+
+TEST(FlatSetTest, ExtractAndAdoptDoNotCopy) {
+    Vector<std::string> keys{"pear", "apple", "fig", "apple"};
+    FlatSet<std::string> set(std::move(keys));
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_EQ(*set.begin(), "apple");
+
+    const std::string *storage = set.keys().data();
+    Vector<std::string> out = std::move(set).extract();
+    EXPECT_EQ(out.data(), storage);
+    EXPECT_TRUE(set.empty());
+
+    // Already sorted: taken over as is
+    FlatSet<std::string, std::less<>, EytzingerSearch> other;
+    other.adopt(std::move(out));
+    EXPECT_EQ(other.keys().data(), storage);
+    EXPECT_TRUE(other.contains("fig"));
+
+    // An lvalue container is copied, then sorted
+    const Vector<std::string> unsorted{"kiwi", "fig", "kiwi"};
+    FlatSet<std::string> copied(unsorted);
+    EXPECT_EQ(std::vector<std::string>(copied.begin(), copied.end()), (std::vector<std::string>{"fig", "kiwi"}));
+    EXPECT_EQ(unsorted.size(), 3u);
+}
+
+// Ranges only construct a map from elements that make a value_type
+static_assert(std::constructible_from<FlatMap<int, int>, std::vector<std::pair<int, int>>>);
+static_assert(!std::constructible_from<FlatMap<int, int>, Vector<int>>);
+static_assert(!std::constructible_from<FlatMap<int, int>, std::vector<std::string>>);
+
+static_assert(std::ranges::random_access_range<FlatMap<int, int>>);
+static_assert(std::ranges::random_access_range<const FlatMap<int, int>>);
+static_assert(std::ranges::random_access_range<const FlatMap<std::string, int, std::less<>, EytzingerSearch>>);
+
+TEST(FlatMapTest, LookupAndModifiers) {
+    FlatMap<std::string, int> map{{"b", 2}, {"a", 1}};
+    map["c"] = 3;
+    EXPECT_EQ(map["a"], 1);
+    EXPECT_EQ(map.at("b"), 2);
+    EXPECT_THROW(map.at("z"), std::out_of_range);
+
+    EXPECT_FALSE(map.try_emplace("a", 100).second);
+    EXPECT_EQ(map.at("a"), 1);
+    EXPECT_FALSE(map.insert_or_assign("a", 10).second);
+    EXPECT_EQ(map.at("a"), 10);
+    EXPECT_TRUE(map.insert({"d", 4}).second);
+    EXPECT_TRUE(map.emplace("e", 5).second);
+
+    const auto it = map.find("c");
+    ASSERT_NE(it, map.end());
+    it->second = 30;
+    EXPECT_EQ((*it).first, "c");
+    EXPECT_EQ(map.values()[2], 30);
+
+    EXPECT_EQ(map.erase("b"), 1u);
+    EXPECT_EQ(map.erase(map.find("d"))->first, "e");
+    EXPECT_EQ(map.size(), 3u);
+
+    std::vector<std::string> keys;
+    int sum = 0;
+    for (const auto [key, value] : map) {
+        keys.push_back(key);
+        sum += value;
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"a", "c", "e"}));
+    EXPECT_EQ(sum, 45);
+}
+
+TEST(FlatMapTest, InsertRangeMergesKeepingExistingValues) {
+    FlatMap<int, std::string> map{{10, "ten"}, {30, "thirty"}};
+    std::vector<std::pair<int, std::string>> more{{40, "forty"}, {10, "TEN"}, {20, "twenty"}, {20, "TWENTY"}, {0, "zero"}};
+    map.insert_range(more);
+
+    EXPECT_EQ(map.size(), 5u);
+    EXPECT_EQ(map.at(10), "ten");
+    EXPECT_EQ(map.at(20), "twenty");
+    EXPECT_EQ(map.begin()->first, 0);
+    EXPECT_TRUE(std::is_sorted(map.keys().begin(), map.keys().end()));
+
+    // Moved from an rvalue range
+    std::vector<std::pair<int, std::string>> moved{{50, std::string(40, 'x')}};
+    map.insert_range(std::ranges::subrange(std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end())));
+    EXPECT_EQ(map.at(50).size(), 40u);
+    EXPECT_TRUE(moved[0].second.empty());
+
+    // Ranges algorithms and views take a const map too
+    const auto &constMap = map;
+    const auto forty = std::ranges::find_if(constMap, [](const auto &entry) { return entry.second == "forty"; });
+    EXPECT_EQ(forty->first, 40);
+    const auto [key, value] = *(constMap | std::views::reverse).begin();
+    EXPECT_EQ(key, 50);
+    EXPECT_EQ(value.size(), 40u);
+}
+
+TEST(FlatMapTest, ExtractAndAdoptColumns) {
+    FlatMap<uint64_t, double> map;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        map.try_emplace(i * 7 % 1000, i * 0.5);
+    }
+    const double *values = map.values().data();
+    auto columns = std::move(map).extract();
+    EXPECT_EQ(columns.values.data(), values);
+    EXPECT_TRUE(map.empty());
+
+    FlatMap<uint64_t, double, std::less<uint64_t>, EytzingerSearch> other;
+    other.adopt(std::move(columns));
+    EXPECT_EQ(other.values().data(), values);
+    EXPECT_EQ(other.at(7), 0.5);
+
+    // Unsorted columns are sorted together
+    Vector<int> keys{3, 1, 2};
+    Vector<std::string> names{"three", "one", "two"};
+    const FlatMap<int, std::string> sorted(std::move(keys), std::move(names));
+    EXPECT_EQ(sorted.begin()->second, "one");
+    EXPECT_EQ((sorted.begin() + 2)->second, "three");
+
+    FlatMap<int, int> mismatched;
+    EXPECT_THROW(mismatched.adopt(Vector<int>{1, 2}, Vector<int>{1}), std::invalid_argument);
+}
+
+TEST(FlatMapTest, ThrowingValueLeavesMapUnchanged) {
+    FlatMap<int, Picky> map;
+    map.try_emplace(1, 1);
+    map.try_emplace(3, 3);
+    EXPECT_THROW(map.try_emplace(2, 13), std::runtime_error);
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.keys().size(), map.values().size());
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(map.at(3).value, 3);
+}
+
+TEST(FlatMapTest, ThrowingValueCopyDuringMergeLeavesMapUnchanged) {
+    FlatMap<std::string, FragileCopy> map;
+    map.try_emplace("alpha", 1);
+    map.try_emplace("gamma", 3);
+
+    FragileCopy::failCopies = true;
+    EXPECT_THROW(map.insert_range(std::vector<std::pair<std::string, int>>{{"beta", 2}}), std::runtime_error);
+    FragileCopy::failCopies = false;
+
+    ASSERT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.keys()[0], "alpha");
+    EXPECT_EQ(map.keys()[1], "gamma");
+    EXPECT_EQ(map.at("alpha").value, 1);
+    EXPECT_EQ(map.at("gamma").value, 3);
+}
+
+TEST(FlatMapTest, BinarySearchMatchesStdMap) {
+    expectSameAsStdMap<BinarySearch>();
+}
+
+TEST(FlatMapTest, EytzingerSearchMatchesStdMap) {
+    expectSameAsStdMap<EytzingerSearch>();
+}
+
+TEST(FlatMapTest, EytzingerIndexFollowsModifications) {
+    FlatMap<int, int, std::less<int>, EytzingerSearch> map;
+    for (int i = 0; i < 100; ++i) {
+        map[i * 2] = i;
+    }
+    map.erase(50);
+    map.erase(map.find(0), map.find(10));
+    EXPECT_FALSE(map.contains(50));
+    EXPECT_FALSE(map.contains(4));
+    EXPECT_EQ(map.lower_bound(49)->first, 52);
+    EXPECT_EQ(map.find(10)->second, 5);
+
+    map.clear();
+    EXPECT_EQ(map.find(10), map.end());
+    map.insert_range(std::vector<std::pair<int, int>>{{5, 1}, {6, 2}});
+    EXPECT_EQ(map.at(6), 2);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "vector.hpp"
+#include "small_vector.hpp"
+#include "growth_policy.hpp"
+#include <cstdint>
+
+// Collects the capacities a vector goes through while pushing count elements
+template <typename V>
+std::vector<size_t> capacitySteps(size_t count) {
+    V v;
+    std::vector<size_t> steps;
+    for (size_t i = 0; i < count; ++i) {
+        v.push_back(static_cast<typename V::value_type>(i));
+        if (steps.empty() || steps.back() != v.capacity()) {
+            steps.push_back(v.capacity());
+        }
+    }
+    return steps;
+}
+
+// POLICIES
+
+TEST(GrowthPolicyTest, DoublingIsDefault) {
+    EXPECT_EQ(capacitySteps<Vector<int>>(9), (std::vector<size_t>{1, 2, 4, 8, 16}));
+}
+
+TEST(GrowthPolicyTest, OneAndHalf) {
+    using V = Vector<int, std::allocator<int>, OneAndHalfGrowth>;
+    EXPECT_EQ(capacitySteps<V>(10), (std::vector<size_t>{1, 2, 3, 4, 6, 9, 13}));
+}
+
+TEST(GrowthPolicyTest, FixedIncrement) {
+    using V = Vector<int, std::allocator<int>, FixedIncrementGrowth<100>>;
+    EXPECT_EQ(capacitySteps<V>(250), (std::vector<size_t>{100, 200, 300}));
+}
+
+TEST(GrowthPolicyTest, AlwaysReachesRequired) {
+    EXPECT_EQ(DoublingGrowth::grow(4, 100, 4), 100);
+    EXPECT_EQ(OneAndHalfGrowth::grow(4, 100, 4), 100);
+    EXPECT_EQ(FixedIncrementGrowth<8>::grow(4, 100, 4), 100);
+}
+
+TEST(GrowthPolicyTest, SaturatesInsteadOfOverflowing) {
+    const size_t limit = SIZE_MAX / 8;
+    EXPECT_EQ(DoublingGrowth::grow(limit - 1, limit, 8), limit);
+    EXPECT_EQ(OneAndHalfGrowth::grow(limit - 1, limit, 8), limit);
+    EXPECT_EQ(FixedIncrementGrowth<16>::grow(limit - 1, limit, 8), limit);
+}
+
+// SIZE CLASSES
+
+TEST(GrowthPolicyTest, MallocSizeClass) {
+    EXPECT_EQ(MallocSizeClass::round(1), 24);
+    EXPECT_EQ(MallocSizeClass::round(24), 24);
+    EXPECT_EQ(MallocSizeClass::round(25), 40);
+    EXPECT_EQ(MallocSizeClass::round(40), 40);
+
+    // 1 int would waste the rest of the 24 byte chunk
+    using Policy = SizeClassGrowth<MallocSizeClass>;
+    EXPECT_EQ(Policy::grow(0, 1, sizeof(int)), 6);
+}
+
+TEST(GrowthPolicyTest, PageSizeClass) {
+    using Policy = SizeClassGrowth<PageSizeClass>;
+    EXPECT_EQ(Policy::grow(0, 1, sizeof(int)), 1024);
+    EXPECT_EQ(Policy::grow(1024, 1025, sizeof(int)), 2048);
+    EXPECT_EQ(Policy::grow(0, 1, 3000), 1);
+}
+
+TEST(GrowthPolicyTest, HugePageSizeClass) {
+    EXPECT_EQ(HugePageSizeClass::round(100), 4096);
+    EXPECT_EQ(HugePageSizeClass::round((2u << 20) + 1), 4u << 20);
+
+    using Policy = SizeClassGrowth<HugePageSizeClass, OneAndHalfGrowth>;
+    const size_t doubles = (3u << 20) / sizeof(double);
+    EXPECT_EQ(Policy::grow(doubles, doubles + 1, sizeof(double)), (6u << 20) / sizeof(double));
+}
+
+// CONTAINERS
+
+TEST(GrowthPolicyTest, VectorUsesSizeClass) {
+    Vector<char, std::allocator<char>, SizeClassGrowth<PageSizeClass>> v;
+    v.push_back('a');
+    EXPECT_EQ(v.capacity(), 4096);
+}
+
+TEST(GrowthPolicyTest, SmallVectorSpillsWithPolicy) {
+    SmallVector<int, 4, std::allocator<int>, FixedIncrementGrowth<10>> v{1, 2, 3, 4};
+    v.push_back(5);
+    EXPECT_EQ(v.capacity(), 14);
+    EXPECT_EQ(v[4], 5);
+}
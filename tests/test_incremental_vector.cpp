@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "incremental_vector.hpp"
+#include "tracking_resource.hpp"
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <stdexcept>
+
+TEST(IncrementalVectorTest, PushBackAndIndexDuringMigration) {
+    IncrementalVector<int, std::allocator<int>, DoublingGrowth, 4> v;
+    bool sawMigration = false;
+
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+        sawMigration |= v.migrating();
+        // Every element stays reachable whichever block it lives in
+        for (int j : {0, i / 2, i}) {
+            ASSERT_EQ(v[j], j);
+        }
+    }
+    EXPECT_TRUE(sawMigration);
+    EXPECT_EQ(v.size(), 1000);
+
+    int expected = 0;
+    for (int x : v) {
+        EXPECT_EQ(x, expected++);
+    }
+}
+
+TEST(IncrementalVectorTest, MigrationIsBounded) {
+    IncrementalVector<int, std::allocator<int>, DoublingGrowth, 8> v;
+    for (int i = 0; i < 1024; ++i) {
+        v.push_back(i);
+    }
+    ASSERT_FALSE(v.migrating());
+    ASSERT_EQ(v.capacity(), 1024);
+
+    // Growth itself moves nothing, each later push moves at most 8
+    v.push_back(1024);
+    EXPECT_TRUE(v.migrating());
+    for (int i = 0; i < 127; ++i) {
+        v.push_back(1025 + i);
+        EXPECT_TRUE(v.migrating());
+    }
+    v.push_back(2000);
+    EXPECT_FALSE(v.migrating());
+    EXPECT_EQ(v[1023], 1023);
+}
+
+TEST(IncrementalVectorTest, BatchWidensForSlowGrowth) {
+    // Only 4 free slots per growth, batch must cover the whole old block
+    IncrementalVector<int, std::allocator<int>, FixedIncrementGrowth<5>, 1> v;
+    for (int i = 0; i < 200; ++i) {
+        v.push_back(i);
+    }
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(v[i], i);
+    }
+}
+
+TEST(IncrementalVectorTest, NonTrivialElements) {
+    IncrementalVector<std::string, std::allocator<std::string>, DoublingGrowth, 2> v;
+    for (int i = 0; i < 300; ++i) {
+        v.push_back(std::string(40, static_cast<char>('a' + i % 26)));
+    }
+    EXPECT_EQ(v[299], std::string(40, static_cast<char>('a' + 299 % 26)));
+
+    IncrementalVector<std::string, std::allocator<std::string>, DoublingGrowth, 2> copy(v);
+    EXPECT_FALSE(copy.migrating());
+    EXPECT_EQ(copy.size(), 300);
+    EXPECT_EQ(copy[5], v[5]);
+}
+
+TEST(IncrementalVectorTest, SelfReferencingPushBackDuringMigration) {
+    IncrementalVector<std::string, std::allocator<std::string>, DoublingGrowth, 1> v;
+    for (int i = 0; i < 5; ++i) {
+        v.push_back(std::string(40, static_cast<char>('a' + i)));
+    }
+    ASSERT_TRUE(v.migrating());
+
+    // v[1] still lives in the old block that this push migrates
+    v.push_back(v[1]);
+    EXPECT_EQ(v[5], std::string(40, 'b'));
+
+    // Growth with an element of the full block as argument
+    while (v.size() < v.capacity()) {
+        v.push_back(v[v.size() - 1]);
+    }
+    v.push_back(v[0]);
+    EXPECT_TRUE(v.migrating());
+    EXPECT_EQ(v.back(), std::string(40, 'a'));
+}
+
+TEST(IncrementalVectorTest, PopBackDuringMigration) {
+    IncrementalVector<std::unique_ptr<int>, std::allocator<std::unique_ptr<int>>, DoublingGrowth, 1> v;
+    for (int i = 0; i < 9; ++i) {
+        v.push_back(std::make_unique<int>(i));
+    }
+    ASSERT_TRUE(v.migrating());
+
+    while (v.size() > 3) {
+        v.pop_back();
+    }
+    EXPECT_EQ(*v.back(), 2);
+    v.push_back(std::make_unique<int>(42));
+    EXPECT_EQ(*v[3], 42);
+    EXPECT_EQ(*v[0], 0);
+}
+
+TEST(IncrementalVectorTest, SettleMakesContiguous) {
+    IncrementalVector<int> v;
+    for (int i = 0; i < 129; ++i) {
+        v.push_back(i);
+    }
+    int* data = v.data();
+    EXPECT_FALSE(v.migrating());
+    for (int i = 0; i < 129; ++i) {
+        EXPECT_EQ(data[i], i);
+    }
+
+    v.reserve(1000);
+    EXPECT_EQ(v.capacity(), 1000);
+    EXPECT_THROW(v.at(129), std::out_of_range);
+}
+
+TEST(IncrementalVectorTest, MoveAndClear) {
+    IncrementalVector<int, std::allocator<int>, DoublingGrowth, 1> a;
+    for (int i = 0; i < 17; ++i) {
+        a.push_back(i);
+    }
+    IncrementalVector<int, std::allocator<int>, DoublingGrowth, 1> b(std::move(a));
+    EXPECT_EQ(a.size(), 0);
+    EXPECT_EQ(b[16], 16);
+
+    b.clear();
+    EXPECT_TRUE(b.empty());
+    EXPECT_FALSE(b.migrating());
+}
+
+TEST(IncrementalVectorTest, AssignmentKeepsNonPropagatingAllocator) {
+    using PmrVector = IncrementalVector<int, std::pmr::polymorphic_allocator<int>, DoublingGrowth, 1>;
+    TrackingResource first;
+    TrackingResource second;
+
+    PmrVector a(&first);
+    PmrVector b(&second);
+    for (int i = 0; i < 33; ++i) {
+        a.push_back(i);
+    }
+    b.push_back(-1);
+    EXPECT_TRUE(a.migrating());
+
+    b = a;
+    EXPECT_EQ(b.get_allocator().resource(), &second);
+    EXPECT_EQ(b[32], 32);
+    EXPECT_TRUE(second.owns(b.data()));
+
+    PmrVector c(&second);
+    c.push_back(7);
+    c = std::move(a);
+    EXPECT_EQ(c.get_allocator().resource(), &second);
+    EXPECT_EQ(c.size(), 33);
+    EXPECT_EQ(c[20], 20);
+    EXPECT_TRUE(second.owns(c.data()));
+}
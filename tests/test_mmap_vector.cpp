@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "mmap_vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    struct Record {
+        uint64_t id;
+        double value;
+        char tag[16];
+    };
+
+    struct OtherRecord {
+        uint64_t id;
+        double value;
+        char tag[16];
+    };
+
+    // Removes the backing file when a test ends
+    struct TempFile {
+        std::string path;
+
+        TempFile() {
+            const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+            path = (std::filesystem::temp_directory_path() /
+                    ("mmap_vector_" + std::to_string(::getpid()) + "_" + info->name() + ".bin"))
+                       .string();
+            std::filesystem::remove(path);
+        }
+        ~TempFile() { std::filesystem::remove(path); }
+    };
+}
+
+template <>
+struct mmap_type_tag<OtherRecord> : std::integral_constant<uint64_t, 0x0757> {};
+
+TEST(MmapVectorTest, PushBackAndReopen) {
+    TempFile file;
+    {
+        MmapVector<Record> v(file.path);
+        EXPECT_TRUE(v.empty());
+        for (uint64_t i = 0; i < 10000; ++i) {
+            Record r{i, static_cast<double>(i) * 1.5, {}};
+            std::snprintf(r.tag, sizeof(r.tag), "rec%llu", static_cast<unsigned long long>(i));
+            v.push_back(r);
+        }
+        EXPECT_EQ(v.size(), 10000u);
+        EXPECT_GE(v.capacity(), 10000u);
+    }
+
+    MmapVector<Record> reopened(file.path, MmapOpenMode::OpenExisting);
+    ASSERT_EQ(reopened.size(), 10000u);
+    EXPECT_EQ(reopened[1234].id, 1234u);
+    EXPECT_EQ(reopened[1234].value, 1234 * 1.5);
+    EXPECT_STREQ(reopened[9999].tag, "rec9999");
+
+    // Keeps growing from where it left off
+    reopened.push_back(Record{10000, 0, {}});
+    EXPECT_EQ(reopened.at(10000).id, 10000u);
+    EXPECT_THROW(reopened.at(10001), std::out_of_range);
+}
+
+TEST(MmapVectorTest, DataIsAlignedAndFileMatchesCapacity) {
+    TempFile file;
+    MmapVector<uint64_t> v(file.path);
+    v.reserve(1000);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data()) % 64, 0u);
+    EXPECT_EQ(std::filesystem::file_size(file.path), MmapVector<uint64_t>::kDataOffset + 1000 * sizeof(uint64_t));
+
+    v.resize(10);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 10u);
+    EXPECT_EQ(std::filesystem::file_size(file.path), MmapVector<uint64_t>::kDataOffset + 10 * sizeof(uint64_t));
+    EXPECT_EQ(v[9], 0u);
+}
+
+TEST(MmapVectorTest, IteratorsAndAlgorithms) {
+    TempFile file;
+    MmapVector<int> v(file.path);
+    for (int i = 100; i > 0; --i) {
+        v.push_back(i);
+    }
+    std::sort(v.begin(), v.end());
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 5050);
+
+    const MmapVector<int> &cv = v;
+    EXPECT_EQ(cv.end() - cv.begin(), 100);
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 99u);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    EXPECT_THROW(v.pop_back(), std::out_of_range);
+}
+
+TEST(MmapVectorTest, SelfReferencingPushBackSurvivesGrowth) {
+    TempFile file;
+    MmapVector<int> v(file.path);
+    v.push_back(7);
+    v.shrink_to_fit();
+    ASSERT_EQ(v.capacity(), 1u);
+    v.push_back(v[0]);
+    EXPECT_EQ(v[1], 7);
+}
+
+TEST(MmapVectorTest, RejectsMismatchedFiles) {
+    TempFile file;
+    {
+        MmapVector<Record> v(file.path);
+        v.push_back(Record{1, 2, {}});
+    }
+    // Same size and alignment, different tag
+    EXPECT_THROW(MmapVector<OtherRecord> other(file.path), std::runtime_error);
+    EXPECT_THROW(MmapVector<uint32_t> other(file.path), std::runtime_error);
+
+    // A capacity whose byte length wraps around must not pass as small
+    {
+        std::FILE *f = std::fopen(file.path.c_str(), "r+b");
+        ASSERT_NE(f, nullptr);
+        const uint64_t counts[2] = {100000000, uint64_t{1} << 61};
+        std::fseek(f, offsetof(mmap_detail::Header, size), SEEK_SET);
+        std::fwrite(counts, sizeof(counts), 1, f);
+        std::fclose(f);
+    }
+    EXPECT_THROW(MmapVector<Record> wrapped(file.path), std::runtime_error);
+
+    {
+        std::FILE *f = std::fopen(file.path.c_str(), "r+b");
+        ASSERT_NE(f, nullptr);
+        std::fputs("garbage!", f);
+        std::fclose(f);
+    }
+    EXPECT_THROW(MmapVector<Record> corrupt(file.path), std::runtime_error);
+
+    // Truncate starts over regardless
+    MmapVector<Record> fresh(file.path, MmapOpenMode::Truncate);
+    EXPECT_TRUE(fresh.empty());
+}
+
+TEST(MmapVectorTest, OpenExistingRequiresFile) {
+    TempFile file;
+    EXPECT_THROW(MmapVector<int> v(file.path, MmapOpenMode::OpenExisting), std::system_error);
+}
+
+TEST(MmapVectorTest, FlushPoliciesAndMove) {
+    TempFile file;
+    MmapVector<double> v(file.path, MmapOpenMode::OpenOrCreate, MmapFlushPolicy::Always);
+    for (int i = 0; i < 5000; ++i) {
+        v.emplace_back(i * 0.25);
+    }
+    v.set_flush_policy(MmapFlushPolicy::None);
+    EXPECT_EQ(v.flush_policy(), MmapFlushPolicy::None);
+    v.flush();
+
+    MmapVector<double> moved(std::move(v));
+    EXPECT_FALSE(v.is_open());
+    EXPECT_EQ(moved.size(), 5000u);
+    moved.close();
+    EXPECT_FALSE(moved.is_open());
+
+    MmapVector<double> reopened(file.path);
+    EXPECT_EQ(reopened[4999], 4999 * 0.25);
+}
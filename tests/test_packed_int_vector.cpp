@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "packed_int_vector.hpp"
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(PACKED_INT_VECTOR_UNROLL)
+#error "packed_int_vector.hpp leaks PACKED_INT_VECTOR_UNROLL"
+#endif
+
+namespace {
+    // Lets allocationsLeft allocations through, then fails one
+    class FailOnceResource : public std::pmr::memory_resource {
+    public:
+        int allocationsLeft = -1;
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override {
+            if (allocationsLeft == 0) {
+                allocationsLeft = -1;
+                throw std::bad_alloc();
+            }
+            if (allocationsLeft > 0) {
+                --allocationsLeft;
+            }
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+    };
+
+    // Checks every access path of a PackedIntVector built from values
+    template <typename T>
+    void expectRoundTrip(const std::vector<T> &values) {
+        PackedIntVector<T> pushed;
+        for (const T value : values) {
+            pushed.push_back(value);
+        }
+        const PackedIntVector<T> appended(values);
+
+        ASSERT_EQ(pushed.size(), values.size());
+        ASSERT_EQ(appended.size(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            ASSERT_EQ(pushed[i], values[i]) << "index " << i;
+            ASSERT_EQ(appended[i], values[i]) << "index " << i;
+        }
+
+        const Vector<T> decoded = pushed.to_vector();
+        ASSERT_EQ(std::vector<T>(decoded.begin(), decoded.end()), values);
+
+        Vector<T> buffer;
+        std::vector<T> blocks;
+        appended.for_each_block(buffer, [&](std::span<const T> block) {
+            EXPECT_EQ(block.data(), buffer.data());
+            blocks.insert(blocks.end(), block.begin(), block.end());
+        });
+        ASSERT_EQ(blocks, values);
+    }
+
+    // Values of at most `bits` bits, and a sequence whose steps have `bits` bits
+    template <typename T>
+    void expectEveryWidthRoundTrips() {
+        using U = std::make_unsigned_t<T>;
+        std::mt19937_64 rng(sizeof(T));
+        for (unsigned bits = 0; bits <= std::numeric_limits<U>::digits; ++bits) {
+            const U mask = bits == std::numeric_limits<U>::digits ? U(~U(0)) : U((U(1) << bits) - 1);
+            std::vector<T> small;
+            std::vector<T> steps;
+            U running = 0;
+            for (size_t i = 0; i < 300; ++i) {
+                small.push_back(static_cast<T>(U(rng()) & mask));
+                running = U(running + (U(rng()) & mask));
+                steps.push_back(static_cast<T>(running));
+            }
+            SCOPED_TRACE(bits);
+            expectRoundTrip(small);
+            expectRoundTrip(steps);
+        }
+    }
+}
+
+TEST(PackedIntVectorTest, EveryBitWidthRoundTrips) {
+    expectEveryWidthRoundTrips<uint8_t>();
+    expectEveryWidthRoundTrips<uint16_t>();
+    expectEveryWidthRoundTrips<uint32_t>();
+    expectEveryWidthRoundTrips<uint64_t>();
+}
+
+TEST(PackedIntVectorTest, SignedValuesAndWrappingDeltas) {
+    std::mt19937 rng(1);
+    std::vector<int32_t> aroundZero;
+    std::vector<int64_t> extremes;
+    for (int i = 0; i < 1024; ++i) {
+        aroundZero.push_back(static_cast<int32_t>(rng() % 200) - 100);
+        extremes.push_back(i % 2 ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min());
+    }
+    expectRoundTrip(aroundZero);
+    expectRoundTrip(extremes);
+    expectRoundTrip(std::vector<int8_t>{-128, 127, -1, 0, 1});
+
+    // 8 full blocks of values in [-100, 100): 8 bits each instead of 32
+    PackedIntVector<int32_t> packed(aroundZero);
+    EXPECT_GT(packed.compression_ratio(), 3.0);
+}
+
+TEST(PackedIntVectorTest, SortedValuesCompressWithDeltas) {
+    std::mt19937_64 rng(2);
+    std::vector<uint64_t> stamps;
+    uint64_t t = 1700000000000ull;
+    for (int i = 0; i < 100000; ++i) {
+        t += rng() % 16;
+        stamps.push_back(t);
+    }
+    expectRoundTrip(stamps);
+
+    // Deltas over 2 positions stay below 32: about 6 bits per value plus
+    // the block header, against 64
+    const PackedIntVector<uint64_t> packed(stamps);
+    EXPECT_GT(packed.compression_ratio(), 7.0);
+    EXPECT_LT(packed.compressed_bytes(), stamps.size());
+
+    // Constant data needs no payload, only the block headers
+    const PackedIntVector<uint32_t> constant(std::vector<uint32_t>(1280, 42));
+    EXPECT_GT(constant.compression_ratio(), 20.0);
+    EXPECT_EQ(constant[1279], 42u);
+}
+
+TEST(PackedIntVectorTest, AppendDecodeAndBounds) {
+    PackedIntVector<uint32_t> packed{1, 2, 3};
+    const std::vector<uint32_t> more(300, 7);
+    packed.append_range(more);
+    packed.append_range(std::vector<int>{9, 9});
+    EXPECT_EQ(packed.size(), 305u);
+    EXPECT_EQ(packed.block_count(), 3u);
+    EXPECT_EQ(packed[2], 3u);
+    EXPECT_EQ(packed[3], 7u);
+    EXPECT_EQ(packed.at(304), 9u);
+    EXPECT_THROW(packed.at(305), std::out_of_range);
+
+    Vector<uint32_t> buffer;
+    EXPECT_EQ(packed.decode_block(2, buffer).size(), 49u);
+    EXPECT_EQ(packed.decode_block(0, buffer).size(), 128u);
+    EXPECT_EQ(buffer[0], 1u);
+
+    // decode reuses the output's capacity
+    Vector<uint32_t> out;
+    out.reserve(1000);
+    const uint32_t *storage = out.data();
+    packed.decode(out);
+    EXPECT_EQ(out.data(), storage);
+    EXPECT_EQ(out.size(), 305u);
+    EXPECT_EQ(out[304], 9u);
+
+    packed.clear();
+    EXPECT_TRUE(packed.empty());
+    EXPECT_EQ(packed.block_count(), 0u);
+    EXPECT_EQ(packed.compressed_bytes(), 0u);
+}
+
+TEST(PackedIntVectorTest, FailedBlockEncodingLeavesVectorUnchanged) {
+    // The first allocation the 128th value triggers is the payload, the
+    // second the block headers
+    for (int allocationsLeft : {0, 1}) {
+        FailOnceResource resource;
+        PackedIntVector<uint32_t, std::pmr::polymorphic_allocator<uint32_t>> packed(&resource);
+        for (uint32_t i = 0; i < 127; ++i) {
+            packed.push_back(i * i);
+        }
+
+        resource.allocationsLeft = allocationsLeft;
+        EXPECT_THROW(packed.push_back(127 * 127), std::bad_alloc);
+        EXPECT_EQ(packed.size(), 127u);
+        EXPECT_EQ(packed.block_count(), 1u);
+
+        for (uint32_t i = 127; i < 300; ++i) {
+            packed.push_back(i * i);
+        }
+        ASSERT_EQ(packed.size(), 300u);
+        EXPECT_EQ(packed.block_count(), 3u);
+        for (uint32_t i = 0; i < 300; ++i) {
+            EXPECT_EQ(packed[i], i * i);
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "remap_allocator.hpp"
+#include "vector.hpp"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Small threshold so tests cross into mappings quickly
+    template <typename T>
+    struct CountingRemap : RemapAllocator<T, 4096> {
+        static inline int reallocations = 0;
+
+        T *reallocate(T *p, size_t oldCapacity, size_t newCapacity, size_t used) {
+            ++reallocations;
+            return RemapAllocator<T, 4096>::reallocate(p, oldCapacity, newCapacity, used);
+        }
+    };
+
+    // Trivially copyable, but construction from a negative value throws
+    struct Checked {
+        int value;
+
+        Checked(int v) : value(v) {
+            if (v < 0) {
+                throw std::invalid_argument("negative");
+            }
+        }
+    };
+}
+
+TEST(RemapAllocatorTest, GrowthReallocatesInPlaceOfCopying) {
+    CountingRemap<uint64_t>::reallocations = 0;
+    Vector<uint64_t, CountingRemap<uint64_t>> v;
+    for (uint64_t i = 0; i < 200000; ++i) {
+        v.push_back(i * 3);
+    }
+    EXPECT_GT(CountingRemap<uint64_t>::reallocations, 10);
+    for (uint64_t i = 0; i < 200000; ++i) {
+        ASSERT_EQ(v[i], i * 3);
+    }
+
+    // Large blocks are page mappings
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data()) % 4096, 0u);
+}
+
+TEST(RemapAllocatorTest, ReserveAndShrinkAcrossThreshold) {
+    Vector<int, RemapAllocator<int, 4096>> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    v.reserve(100000);
+    EXPECT_EQ(v.capacity(), 100000u);
+    EXPECT_EQ(v[99], 99);
+
+    for (int i = 100; i < 50000; ++i) {
+        v.push_back(i);
+    }
+    v.reserve(1000000);
+    EXPECT_EQ(v[49999], 49999);
+
+    // Mapping to mapping, then back below the threshold
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 50000u);
+    v.resize(10);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 10u);
+    EXPECT_EQ(v[9], 9);
+
+    v.clear();
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 0u);
+}
+
+TEST(RemapAllocatorTest, EmplaceDuringReallocation) {
+    Vector<int, RemapAllocator<int, 4096>> v;
+    for (int i = 0; i < 2048; ++i) {
+        v.push_back(i);
+    }
+    v.shrink_to_fit();
+
+    // Argument refers into the block being remapped
+    v.push_back(v[0]);
+    EXPECT_EQ(v[2048], 0);
+
+    v.shrink_to_fit();
+    v.emplace(v.begin() + 1, v[2047]);
+    EXPECT_EQ(v.size(), 2050u);
+    EXPECT_EQ(v[0], 0);
+    EXPECT_EQ(v[1], 2047);
+    EXPECT_EQ(v[2], 1);
+    EXPECT_EQ(v[2049], 0);
+}
+
+TEST(RemapAllocatorTest, RelocatableNonTrivialElements) {
+    Vector<std::unique_ptr<std::string>, RemapAllocator<std::unique_ptr<std::string>, 4096>> v;
+    for (int i = 0; i < 5000; ++i) {
+        v.push_back(std::make_unique<std::string>(std::to_string(i)));
+    }
+    EXPECT_EQ(*v[0], "0");
+    EXPECT_EQ(*v[4999], "4999");
+
+    Vector<std::unique_ptr<std::string>, RemapAllocator<std::unique_ptr<std::string>, 4096>> moved(std::move(v));
+    EXPECT_EQ(*moved[1234], "1234");
+}
+
+TEST(RemapAllocatorTest, ThrowingConstructionLeavesVectorUntouched) {
+    Vector<Checked, RemapAllocator<Checked, 4096>> v;
+    for (int i = 0; i < 4096; ++i) {
+        v.emplace_back(i);
+    }
+    v.shrink_to_fit();
+    const Checked *before = v.data();
+
+    EXPECT_THROW(v.emplace_back(-1), std::invalid_argument);
+    EXPECT_EQ(v.size(), 4096u);
+    EXPECT_EQ(v.capacity(), 4096u);
+    EXPECT_EQ(v.data(), before);
+    EXPECT_EQ(v[4095].value, 4095);
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include "segmented_vector.hpp"
+#include "vector_algorithms.hpp"
+#include "tracking_resource.hpp"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+static_assert(std::random_access_iterator<SegmentedVector<int>::iterator>);
+static_assert(std::random_access_iterator<SegmentedVector<int>::const_iterator>);
+static_assert(std::ranges::random_access_range<SegmentedVector<int>>);
+
+namespace {
+    struct Counted {
+        static inline int live = 0;
+        static inline int copiesUntilThrow = -1;
+
+        int value;
+
+        Counted(int v = 0) : value(v) { ++live; }
+        Counted(const Counted &other) : value(other.value) {
+            if (copiesUntilThrow == 0) {
+                throw std::runtime_error("copy failed");
+            }
+            --copiesUntilThrow;
+            ++live;
+        }
+        ~Counted() { --live; }
+    };
+}
+
+TEST(SegmentedVectorTest, IndexMathAcrossSegments) {
+    SegmentedVector<size_t> v;
+    for (size_t i = 0; i < 100000; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(v.size(), 100000u);
+    EXPECT_GE(v.capacity(), 100000u);
+    EXPECT_LT(v.capacity(), 2 * 100000u + SegmentedVector<size_t>::kFirstSegmentSize);
+    for (size_t i = 0; i < 100000; ++i) {
+        ASSERT_EQ(v[i], i);
+    }
+    EXPECT_EQ(v.front(), 0u);
+    EXPECT_EQ(v.back(), 99999u);
+    EXPECT_THROW(v.at(100000), std::out_of_range);
+}
+
+TEST(SegmentedVectorTest, GrowthNeverMovesElements) {
+    SegmentedVector<std::string> v;
+    std::string &first = v.emplace_back("first");
+    auto it = v.begin();
+    for (int i = 0; i < 10000; ++i) {
+        // Arguments may point into the container while it grows
+        v.push_back(v[0]);
+    }
+    EXPECT_EQ(&v[0], &first);
+    EXPECT_EQ(*it, "first");
+    EXPECT_EQ(v[10000], "first");
+}
+
+TEST(SegmentedVectorTest, IteratorsAndAlgorithms) {
+    SegmentedVector<int> v;
+    for (int i = 1000; i > 0; --i) {
+        v.push_back(i);
+    }
+    std::sort(v.begin(), v.end());
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(std::accumulate(v.cbegin(), v.cend(), 0), 500500);
+
+    auto it = v.begin() + 15;
+    EXPECT_EQ(*it, 16);
+    ++it;
+    EXPECT_EQ(*it, 17);
+    --it;
+    --it;
+    EXPECT_EQ(*it, 15);
+    EXPECT_EQ(it[500], 515);
+    EXPECT_EQ(v.end() - v.begin(), 1000);
+    EXPECT_EQ(std::prev(v.end()).index(), 999u);
+
+    int expected = 1000;
+    for (auto rit = v.end(); rit != v.begin();) {
+        --rit;
+        ASSERT_EQ(*rit, expected--);
+    }
+
+    SegmentedVector<int>::const_iterator converted = v.begin();
+    EXPECT_EQ(converted, v.cbegin());
+}
+
+TEST(SegmentedVectorTest, ChunksCoverElementsInOrder) {
+    SegmentedVector<int32_t> v;
+    for (int32_t i = 0; i < 5000; ++i) {
+        v.push_back(i);
+    }
+
+    size_t seen = 0;
+    int64_t sum = 0;
+    for (std::span<int32_t> chunk : v.chunks()) {
+        EXPECT_EQ(chunk[0], static_cast<int32_t>(seen));
+        seen += chunk.size();
+        sum += vector_algorithms::reduce(chunk);
+    }
+    EXPECT_EQ(seen, 5000u);
+    EXPECT_EQ(sum, 4999 * 5000 / 2);
+    EXPECT_EQ(v.chunk(0).size(), SegmentedVector<int32_t>::kFirstSegmentSize);
+    EXPECT_EQ(v.chunk(v.chunk_count() - 1).back(), 4999);
+
+    const SegmentedVector<int32_t> &cv = v;
+    EXPECT_EQ(std::ranges::distance(cv.chunks()), static_cast<std::ptrdiff_t>(v.chunk_count()));
+}
+
+TEST(SegmentedVectorTest, ResizeReserveShrink) {
+    SegmentedVector<std::unique_ptr<int>> v;
+    v.resize(100);
+    EXPECT_EQ(v.size(), 100u);
+    EXPECT_EQ(v[99], nullptr);
+    v[5] = std::make_unique<int>(5);
+
+    v.reserve(10000);
+    EXPECT_GE(v.capacity(), 10000u);
+    v.resize(10);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), SegmentedVector<int>::kFirstSegmentSize);
+    EXPECT_EQ(*v[5], 5);
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 9u);
+    v.clear();
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 0u);
+    EXPECT_THROW(v.pop_back(), std::out_of_range);
+}
+
+TEST(SegmentedVectorTest, CopyMoveSwap) {
+    SegmentedVector<std::string> a{"one", "two", "three"};
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(std::to_string(i));
+    }
+
+    SegmentedVector<std::string> b(a);
+    EXPECT_EQ(b.size(), 103u);
+    EXPECT_EQ(b[102], "99");
+
+    const std::string *address = &b[50];
+    SegmentedVector<std::string> c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(&c[50], address);
+
+    SegmentedVector<std::string> d;
+    d = c;
+    d.push_back("extra");
+    swap(c, d);
+    EXPECT_EQ(c.size(), 104u);
+    EXPECT_EQ(d.size(), 103u);
+
+    d = std::move(c);
+    EXPECT_EQ(d[103], "extra");
+}
+
+TEST(SegmentedVectorTest, AssignmentKeepsNonPropagatingAllocator) {
+    using PmrVector = SegmentedVector<int, std::pmr::polymorphic_allocator<int>>;
+    TrackingResource first;
+    TrackingResource second;
+
+    PmrVector a(&first);
+    PmrVector b(&second);
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(i);
+    }
+    b.push_back(-1);
+
+    b = a;
+    EXPECT_EQ(b.get_allocator().resource(), &second);
+    EXPECT_EQ(b[99], 99);
+    EXPECT_TRUE(second.owns(b.chunk(b.chunk_count() - 1).data()));
+
+    PmrVector c(&second);
+    c.push_back(7);
+    c = std::move(a);
+    EXPECT_EQ(c.get_allocator().resource(), &second);
+    EXPECT_EQ(c.size(), 100u);
+    EXPECT_EQ(c[50], 50);
+    EXPECT_TRUE(second.owns(c.chunk(0).data()));
+
+    // Equal allocators still hand the segments over
+    const int *address = &c[50];
+    b = std::move(c);
+    EXPECT_EQ(&b[50], address);
+}
+
+static_assert(std::is_nothrow_move_assignable_v<SegmentedVector<std::string>>);
+static_assert(!std::is_nothrow_move_assignable_v<SegmentedVector<int, std::pmr::polymorphic_allocator<int>>>);
+
+TEST(SegmentedVectorTest, FailedCopiesReleaseEverything) {
+    {
+        SegmentedVector<Counted> v;
+        v.resize(100);
+        const int live = Counted::live;
+
+        Counted::copiesUntilThrow = 60;
+        EXPECT_THROW(SegmentedVector<Counted> copy(v), std::runtime_error);
+        EXPECT_EQ(Counted::live, live);
+
+        Counted::copiesUntilThrow = 5;
+        EXPECT_THROW(v.resize(200, Counted(7)), std::runtime_error);
+        Counted::copiesUntilThrow = -1;
+        EXPECT_EQ(v.size(), 100u);
+        EXPECT_EQ(Counted::live, live);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "small_vector.hpp"
+#include <string>
+#include <stdexcept>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Counts heap allocations so tests can tell inline from spilled storage
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    std::shared_ptr<int> allocations = std::make_shared<int>(0);
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& o) : allocations(o.allocations) {}
+
+    T* allocate(size_t n) {
+        ++*allocations;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p); }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>& o) const { return allocations == o.allocations; }
+};
+
+} // namespace
+
+// CONSTRUCTORS
+
+TEST(SmallVectorTest, DefaultIsInline) {
+    SmallVector<int, 4> v;
+    EXPECT_EQ(v.size(), 0);
+    EXPECT_EQ(v.capacity(), 4);
+    EXPECT_TRUE(v.isInline());
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(SmallVectorTest, NoAllocationUpToInlineCapacity) {
+    CountingAllocator<int> alloc;
+    SmallVector<int, 16, CountingAllocator<int>> v(alloc);
+
+    for (int i = 0; i < 16; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(*alloc.allocations, 0);
+    EXPECT_TRUE(v.isInline());
+
+    v.push_back(16);
+    EXPECT_EQ(*alloc.allocations, 1);
+    EXPECT_FALSE(v.isInline());
+    EXPECT_GE(v.capacity(), 17);
+
+    for (int i = 0; i < 17; ++i) {
+        EXPECT_EQ(v[i], i);
+    }
+}
+
+TEST(SmallVectorTest, InitializerList) {
+    SmallVector<std::string, 2> v{"a", "b", "c"};
+    EXPECT_FALSE(v.isInline());
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[2], "c");
+}
+
+TEST(SmallVectorTest, CopyConstructor) {
+    SmallVector<std::string, 4> inlineVec{"a", "b"};
+    SmallVector<std::string, 4> inlineCopy(inlineVec);
+    EXPECT_TRUE(inlineCopy.isInline());
+    EXPECT_EQ(inlineCopy[1], "b");
+
+    SmallVector<std::string, 1> heapVec{"a", "b"};
+    SmallVector<std::string, 1> heapCopy(heapVec);
+    EXPECT_FALSE(heapCopy.isInline());
+    EXPECT_NE(heapCopy.data(), heapVec.data());
+    EXPECT_EQ(heapCopy[1], "b");
+}
+
+// MOVES
+
+TEST(SmallVectorTest, MoveInline) {
+    SmallVector<std::string, 4> a{"x", "y"};
+    SmallVector<std::string, 4> b(std::move(a));
+
+    EXPECT_TRUE(b.isInline());
+    ASSERT_EQ(b.size(), 2);
+    EXPECT_EQ(b[0], "x");
+    EXPECT_EQ(a.size(), 0);
+}
+
+TEST(SmallVectorTest, MoveSpilledStealsBuffer) {
+    SmallVector<std::string, 2> a{"x", "y", "z"};
+    const std::string* buffer = a.data();
+
+    SmallVector<std::string, 2> b(std::move(a));
+    EXPECT_EQ(b.data(), buffer);
+    EXPECT_EQ(b.size(), 3);
+    EXPECT_TRUE(a.isInline());
+    EXPECT_EQ(a.size(), 0);
+}
+
+TEST(SmallVectorTest, MoveAssignmentAcrossModes) {
+    SmallVector<std::string, 2> spilled{"1", "2", "3"};
+    SmallVector<std::string, 2> small{"a"};
+
+    small = std::move(spilled);
+    EXPECT_FALSE(small.isInline());
+    EXPECT_EQ(small.size(), 3);
+
+    SmallVector<std::string, 2> other{"q"};
+    small = std::move(other);
+    EXPECT_TRUE(small.isInline());
+    ASSERT_EQ(small.size(), 1);
+    EXPECT_EQ(small[0], "q");
+}
+
+TEST(SmallVectorTest, SwapAllCombinations) {
+    using SV = SmallVector<std::string, 2>;
+
+    SV a{"a"}, b{"b1", "b2", "b3"};
+    a.swap(b);
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(a[2], "b3");
+    ASSERT_EQ(b.size(), 1);
+    EXPECT_EQ(b[0], "a");
+
+    SV c{"c"}, d{"d1", "d2"};
+    swap(c, d);
+    EXPECT_EQ(c[1], "d2");
+    EXPECT_EQ(d[0], "c");
+
+    SV e{"e1", "e2", "e3"}, f{"f1", "f2", "f3", "f4"};
+    const std::string* eData = e.data();
+    e.swap(f);
+    EXPECT_EQ(f.data(), eData);
+    EXPECT_EQ(e.size(), 4);
+}
+
+TEST(SmallVectorTest, AssignmentKeepsNonPropagatingAllocator) {
+    using SV = SmallVector<int, 2, std::pmr::polymorphic_allocator<int>>;
+    std::pmr::monotonic_buffer_resource first;
+    std::pmr::monotonic_buffer_resource second;
+
+    SV a({1, 2, 3}, &first);
+    SV b({4, 5, 6, 7}, &second);
+    b = a;
+    EXPECT_EQ(b.get_allocator().resource(), &second);
+    EXPECT_EQ(b[2], 3);
+
+    // The block of a belongs to another resource: elements are moved over
+    SV c(&second);
+    c = std::move(a);
+    EXPECT_EQ(c.get_allocator().resource(), &second);
+    EXPECT_FALSE(c.isInline());
+    EXPECT_EQ(c[1], 2);
+    EXPECT_TRUE(a.empty());
+}
+
+// Moves may allocate with a stateful allocator that does not propagate
+static_assert(std::is_nothrow_move_assignable_v<SmallVector<std::string, 2>>);
+static_assert(!std::is_nothrow_move_assignable_v<SmallVector<int, 2, std::pmr::polymorphic_allocator<int>>>);
+static_assert(std::is_nothrow_swappable_v<SmallVector<std::string, 2>>);
+
+// CAPACITY
+
+TEST(SmallVectorTest, ShrinkToFitReturnsInline) {
+    SmallVector<int, 4> v{1, 2, 3, 4, 5, 6};
+    EXPECT_FALSE(v.isInline());
+
+    v.pop_back();
+    v.pop_back();
+    v.shrink_to_fit();
+
+    EXPECT_TRUE(v.isInline());
+    EXPECT_EQ(v.capacity(), 4);
+    EXPECT_EQ(v[3], 4);
+}
+
+TEST(SmallVectorTest, AtAndIterators) {
+    SmallVector<int, 8> v{1, 2, 3};
+    EXPECT_THROW(v.at(3), std::out_of_range);
+
+    int sum = 0;
+    for (int x : v) {
+        sum += x;
+    }
+    EXPECT_EQ(sum, 6);
+
+    EXPECT_EQ(*v.rbegin(), 3);
+    EXPECT_EQ(std::vector<int>(v.crbegin(), v.crend()), (std::vector<int>{3, 2, 1}));
+    *v.rbegin() = 30;
+    EXPECT_EQ(v[2], 30);
+}
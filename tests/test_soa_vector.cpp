@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include "soa_vector.hpp"
+#include "vector_algorithms.hpp"
+#include "tracking_resource.hpp"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Move may throw, so growth has to copy it to keep the strong guarantee
+    struct ThrowingCopy {
+        static inline int copiesUntilThrow = -1;
+        static inline int live = 0;
+
+        int value;
+
+        explicit ThrowingCopy(int v = 0) : value(v) { ++live; }
+        ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+            if (copiesUntilThrow == 0) {
+                throw std::runtime_error("copy failed");
+            }
+            --copiesUntilThrow;
+            ++live;
+        }
+        ThrowingCopy(ThrowingCopy &&other) noexcept(false) : value(other.value) { ++live; }
+        ThrowingCopy &operator=(const ThrowingCopy &) = default;
+        ~ThrowingCopy() { --live; }
+    };
+}
+
+TEST(SoAVectorTest, PushBackAndRowAccess) {
+    SoAVector<float, int, std::string> v;
+    EXPECT_TRUE(v.empty());
+
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(static_cast<float>(i) * 0.5f, i, std::to_string(i));
+    }
+    EXPECT_EQ(v.size(), 100u);
+    EXPECT_GE(v.capacity(), 100u);
+
+    for (int i = 0; i < 100; ++i) {
+        auto [x, id, name] = v[i];
+        EXPECT_EQ(x, static_cast<float>(i) * 0.5f);
+        EXPECT_EQ(id, i);
+        EXPECT_EQ(name, std::to_string(i));
+    }
+
+    // Proxy references write through
+    std::get<1>(v[3]) = 42;
+    v[4] = std::make_tuple(1.0f, 2, std::string("four"));
+    EXPECT_EQ(std::get<1>(v.at(3)), 42);
+    EXPECT_EQ(std::get<2>(v[4]), "four");
+    EXPECT_THROW(v.at(100), std::out_of_range);
+
+    const SoAVector<float, int, std::string>::value_type row = v.back();
+    EXPECT_EQ(std::get<2>(row), "99");
+}
+
+TEST(SoAVectorTest, ColumnsAreContiguousAndAligned) {
+    SoAVector<double, int32_t, char> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i * 2.0, i, static_cast<char>('a' + i % 26));
+    }
+
+    std::span<double> xs = v.column<0>();
+    std::span<int32_t> ids = v.column<1>();
+    EXPECT_EQ(xs.size(), 1000u);
+    EXPECT_EQ(ids.data(), v.data<1>());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<0>()) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<1>()) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<2>()) % 64, 0u);
+
+    // Spans feed the SIMD kernels directly
+    EXPECT_EQ(vector_algorithms::reduce(ids), 999 * 1000 / 2);
+    EXPECT_EQ(vector_algorithms::max(xs), 1998.0);
+    vector_algorithms::scale(ids, 2);
+    EXPECT_EQ(std::get<1>(v[10]), 20);
+}
+
+TEST(SoAVectorTest, IteratorsYieldRows) {
+    SoAVector<int, int> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i, i * i);
+    }
+
+    int expected = 0;
+    for (auto [a, b] : v) {
+        EXPECT_EQ(a, expected);
+        EXPECT_EQ(b, expected * expected);
+        b = -b;
+        ++expected;
+    }
+    EXPECT_EQ(std::get<1>(v[3]), -9);
+
+    const auto &cv = v;
+    EXPECT_EQ(cv.end() - cv.begin(), 10);
+    auto it = cv.begin() + 5;
+    EXPECT_EQ(std::get<0>(*it), 5);
+    EXPECT_EQ(std::get<0>(it[2]), 7);
+    EXPECT_EQ(it.index(), 5u);
+    EXPECT_TRUE(cv.begin() < it);
+    SoAVector<int, int>::const_iterator converted = v.begin();
+    EXPECT_EQ(converted, cv.begin());
+
+    // Ranges algorithms and views take a const vector too
+    const auto found = std::ranges::find_if(cv, [](const auto &row) { return std::get<1>(row) == -16; });
+    EXPECT_EQ(found.index(), 4u);
+    const auto [last, square] = *(cv | std::views::reverse).begin();
+    EXPECT_EQ(last, 9);
+    EXPECT_EQ(square, -81);
+}
+
+static_assert(std::ranges::random_access_range<SoAVector<int, double>>);
+static_assert(std::ranges::random_access_range<const SoAVector<int, double>>);
+static_assert(std::ranges::random_access_range<const SoAVector<float, int, std::string>>);
+
+TEST(SoAVectorTest, SelfReferencingPushBackSurvivesGrowth) {
+    SoAVector<std::string, int> v;
+    v.push_back(std::string(40, 'x'), 1);
+    v.shrink_to_fit();
+    ASSERT_EQ(v.capacity(), 1u);
+
+    v.push_back(std::get<0>(v[0]), std::get<1>(v[0]) + 1);
+    EXPECT_EQ(std::get<0>(v[1]), std::string(40, 'x'));
+    EXPECT_EQ(std::get<1>(v[1]), 2);
+}
+
+TEST(SoAVectorTest, ResizeReserveShrink) {
+    SoAVector<int, std::unique_ptr<int>> v;
+    v.resize(5);
+    EXPECT_EQ(v.size(), 5u);
+    EXPECT_EQ(std::get<0>(v[4]), 0);
+    EXPECT_EQ(std::get<1>(v[4]), nullptr);
+
+    std::get<1>(v[2]) = std::make_unique<int>(7);
+    v.reserve(100);
+    EXPECT_EQ(v.capacity(), 100u);
+    EXPECT_EQ(*std::get<1>(v[2]), 7);
+
+    v.resize(3);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 3u);
+    EXPECT_EQ(*std::get<1>(v[2]), 7);
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 2u);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    EXPECT_THROW(v.pop_back(), std::out_of_range);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 0u);
+}
+
+TEST(SoAVectorTest, CopyMoveSwap) {
+    SoAVector<int, std::string> a;
+    for (int i = 0; i < 20; ++i) {
+        a.push_back(i, std::string(30, static_cast<char>('a' + i)));
+    }
+
+    SoAVector<int, std::string> b(a);
+    EXPECT_EQ(b.size(), 20u);
+    EXPECT_EQ(std::get<1>(b[19]), std::string(30, 't'));
+
+    SoAVector<int, std::string> c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(std::get<0>(c[7]), 7);
+
+    SoAVector<int, std::string> d;
+    d = c;
+    d.push_back(100, "extra");
+    EXPECT_EQ(c.size(), 20u);
+    EXPECT_EQ(d.size(), 21u);
+
+    swap(c, d);
+    EXPECT_EQ(c.size(), 21u);
+    EXPECT_EQ(d.size(), 20u);
+
+    d = std::move(c);
+    EXPECT_EQ(d.size(), 21u);
+    EXPECT_EQ(std::get<1>(d[20]), "extra");
+}
+
+TEST(SoAVectorTest, AssignmentKeepsNonPropagatingAllocator) {
+    using PmrSoAVector = BasicSoAVector<std::pmr::polymorphic_allocator<std::byte>, DoublingGrowth, int, double>;
+    TrackingResource first;
+    TrackingResource second;
+
+    PmrSoAVector a(&first);
+    PmrSoAVector b(&second);
+    for (int i = 0; i < 20; ++i) {
+        a.push_back(i, i * 0.5);
+    }
+    b.push_back(-1, -1.0);
+
+    b = a;
+    EXPECT_EQ(b.get_allocator().resource(), &second);
+    EXPECT_EQ(b.size(), 20u);
+    EXPECT_EQ(std::get<1>(b[19]), 9.5);
+    EXPECT_TRUE(second.owns(b.column<0>().data()));
+
+    PmrSoAVector c(&second);
+    c = std::move(a);
+    EXPECT_EQ(c.get_allocator().resource(), &second);
+    EXPECT_EQ(std::get<0>(c[7]), 7);
+    EXPECT_TRUE(second.owns(c.column<0>().data()));
+
+    // Equal allocators still hand the block over
+    const int *rows = c.column<0>().data();
+    b = std::move(c);
+    EXPECT_EQ(b.column<0>().data(), rows);
+}
+
+static_assert(std::is_nothrow_move_assignable_v<SoAVector<int, std::string>>);
+
+TEST(SoAVectorTest, GrowthKeepsStrongGuarantee) {
+    {
+        SoAVector<std::string, ThrowingCopy> v;
+        for (int i = 0; i < 8; ++i) {
+            v.push_back(std::string(30, 's'), ThrowingCopy(i));
+        }
+        v.shrink_to_fit();
+        ASSERT_EQ(v.size(), v.capacity());
+        const int live = ThrowingCopy::live;
+
+        // The new row's field is built from a temporary by move, then the
+        // third copy during growth fails
+        ThrowingCopy::copiesUntilThrow = 2;
+        EXPECT_THROW(v.push_back(std::string("new"), ThrowingCopy(99)), std::runtime_error);
+        ThrowingCopy::copiesUntilThrow = -1;
+
+        EXPECT_EQ(ThrowingCopy::live, live);
+        EXPECT_EQ(v.size(), 8u);
+        for (int i = 0; i < 8; ++i) {
+            EXPECT_EQ(std::get<0>(v[i]), std::string(30, 's'));
+            EXPECT_EQ(std::get<1>(v[i]).value, i);
+        }
+    }
+    EXPECT_EQ(ThrowingCopy::live, 0);
+}
+
+TEST(SoAVectorTest, GrowthFollowsPolicyWithRowSize) {
+    BasicSoAVector<std::allocator<std::byte>, FixedIncrementGrowth<10>, int, double> v;
+    v.push_back(1, 1.0);
+    EXPECT_EQ(v.capacity(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i, i);
+    }
+    EXPECT_EQ(v.capacity(), 20u);
+    EXPECT_EQ(decltype(v)::kRowBytes, sizeof(int) + sizeof(double));
+}
@@ -2,6 +2,18 @@
 #include "vector.hpp"
 #include <string>
 #include <stdexcept>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <ranges>
+#include <cstdint>
+#include <algorithm>
+#include <forward_list>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <sstream>
+#include <array>
 
 // CONSTRUCTORS
 
@@ -129,6 +141,195 @@ TEST(VectorTest, PushBackReallocation) {
     }
 }
 
+// emplace
+
+TEST(VectorTest, EmplaceBackConstructsInPlace) {
+    Vector<std::pair<int, std::string>> v;
+    auto& ref = v.emplace_back(1, "one");
+    EXPECT_EQ(&ref, &v[0]);
+
+    for (int i = 2; i <= 10; ++i) {
+        v.emplace_back(i, std::to_string(i));
+    }
+    EXPECT_EQ(v.size(), 10);
+    EXPECT_EQ(v[9].second, "10");
+}
+
+TEST(VectorTest, EmplaceBackOwnElementDuringGrowth) {
+    Vector<std::string> v{"first element, long enough to live on the heap", "b"};
+    ASSERT_EQ(v.size(), v.capacity());
+    v.emplace_back(v[0]);
+    EXPECT_EQ(v[2], v[0]);
+}
+
+TEST(VectorTest, EmplaceAtPosition) {
+    Vector<std::string> v{"a", "c"};
+    v.reserve(10);
+
+    auto it = v.emplace(v.begin() + 1, "b");
+    EXPECT_EQ(*it, "b");
+    v.emplace(v.begin(), "_");
+    v.emplace(v.end(), "d");
+
+    ASSERT_EQ(v.size(), 5);
+    EXPECT_EQ(v[0], "_");
+    EXPECT_EQ(v[1], "a");
+    EXPECT_EQ(v[2], "b");
+    EXPECT_EQ(v[3], "c");
+    EXPECT_EQ(v[4], "d");
+}
+
+TEST(VectorTest, EmplaceWithReallocation) {
+    Vector<int> v{1, 2, 4};
+    ASSERT_EQ(v.size(), v.capacity());
+
+    v.emplace(v.begin() + 2, 3);
+    ASSERT_EQ(v.size(), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(v[i], i + 1);
+    }
+
+    // Argument aliasing an element that is shifted
+    v.reserve(8);
+    v.emplace(v.begin(), v[3]);
+    EXPECT_EQ(v[0], 4);
+    EXPECT_EQ(v[4], 4);
+}
+
+// insert / erase / assign
+
+TEST(ModifierTest, InsertSingleAndCount) {
+    Vector<std::string> v{"a", "d"};
+    v.insert(v.begin() + 1, std::string("b"));
+    auto it = v.insert(v.begin() + 2, 2, "c");
+    EXPECT_EQ(it - v.begin(), 2);
+
+    ASSERT_EQ(v.size(), 5);
+    EXPECT_EQ(v[1], "b");
+    EXPECT_EQ(v[2], "c");
+    EXPECT_EQ(v[3], "c");
+    EXPECT_EQ(v[4], "d");
+
+    // value aliasing an element of the vector
+    v.insert(v.begin(), 3, v[4]);
+    EXPECT_EQ(v[0], "d");
+    EXPECT_EQ(v[2], "d");
+    EXPECT_EQ(v.size(), 8);
+}
+
+TEST(ModifierTest, InsertRangeInPlace) {
+    // Both in-place cases: tail longer and shorter than the inserted range
+    Vector<std::string> v{"0", "1", "2", "3", "4"};
+    v.reserve(20);
+    const std::string* data = v.data();
+
+    std::vector<std::string> two{"x", "y"};
+    v.insert(v.begin() + 1, two.begin(), two.end());
+    std::vector<std::string> four{"p", "q", "r", "s"};
+    v.insert(v.begin() + 6, four.begin(), four.end());
+
+    EXPECT_EQ(v.data(), data);
+    const char* expected[] = {"0", "x", "y", "1", "2", "3", "p", "q", "r", "s", "4"};
+    ASSERT_EQ(v.size(), 11);
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(v[i], expected[i]);
+    }
+}
+
+TEST(ModifierTest, InsertRangeReallocatesOnce) {
+    Vector<int> v{1, 2, 3};
+    std::vector<int> src(100);
+    for (int i = 0; i < 100; ++i) {
+        src[i] = 100 + i;
+    }
+
+    v.insert(v.begin() + 1, src.begin(), src.end());
+    ASSERT_EQ(v.size(), 103);
+    EXPECT_EQ(v.capacity(), 103);
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(v[1], 100);
+    EXPECT_EQ(v[100], 199);
+    EXPECT_EQ(v[102], 3);
+
+    v.insert(v.end(), {7, 8});
+    EXPECT_EQ(v[104], 8);
+}
+
+TEST(ModifierTest, EraseSingleAndRange) {
+    Vector<std::string> v{"0", "1", "2", "3", "4", "5"};
+
+    auto it = v.erase(v.begin() + 1);
+    EXPECT_EQ(*it, "2");
+
+    it = v.erase(v.begin() + 1, v.begin() + 3);
+    EXPECT_EQ(*it, "4");
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0], "0");
+    EXPECT_EQ(v[1], "4");
+    EXPECT_EQ(v[2], "5");
+
+    it = v.erase(v.begin() + 1, v.end());
+    EXPECT_EQ(it, v.end());
+    EXPECT_EQ(v.size(), 1);
+}
+
+TEST(ModifierTest, EraseRelocatable) {
+    Vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < 6; ++i) {
+        v.push_back(std::make_unique<int>(i));
+    }
+    v.erase(v.begin(), v.begin() + 2);
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(*v[0], 2);
+    EXPECT_EQ(*v[3], 5);
+}
+
+TEST(ModifierTest, Assign) {
+    Vector<std::string> v{"a", "b", "c"};
+    std::vector<std::string> src{"x", "y"};
+
+    v.assign(src.begin(), src.end());
+    ASSERT_EQ(v.size(), 2);
+    EXPECT_EQ(v[1], "y");
+
+    v.assign(5, "z");
+    ASSERT_EQ(v.size(), 5);
+    EXPECT_EQ(v[4], "z");
+
+    v.assign({"q"});
+    ASSERT_EQ(v.size(), 1);
+    EXPECT_EQ(v[0], "q");
+
+    v.assign(3, v[0]);
+    EXPECT_EQ(v[2], "q");
+}
+
+TEST(ModifierTest, AppendRange) {
+    Vector<int> v{1};
+    std::vector<int> src{2, 3, 4, 5};
+    v.append_range(src);
+    v.append_range(std::views::iota(6, 10));
+
+    ASSERT_EQ(v.size(), 9);
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_EQ(v[i], i + 1);
+    }
+
+    Vector<int> other{10, 11};
+    v.append_range(other);
+    EXPECT_EQ(v[10], 11);
+}
+
+TEST(ModifierTest, EraseIf) {
+    Vector<int> v{1, 2, 3, 4, 5, 6, 7};
+    EXPECT_EQ(erase_if(v, [](int x) { return x % 2 == 0; }), 3);
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v[3], 7);
+
+    EXPECT_EQ(erase(v, 5), 1);
+    EXPECT_EQ(v.size(), 3);
+}
+
 // pop_back
 
 TEST(VectorTest, PopBackBasic) {
@@ -213,6 +414,56 @@ TEST(CapacityTest, ShrinkToFit) {
     EXPECT_EQ(v[1], 2);
 }
 
+TEST(CapacityTest, Resize) {
+    Vector<int> v{1, 2, 3};
+
+    v.resize(6);
+    ASSERT_EQ(v.size(), 6);
+    EXPECT_EQ(v[2], 3);
+    EXPECT_EQ(v[5], 0);
+
+    v.resize(2);
+    ASSERT_EQ(v.size(), 2);
+    EXPECT_EQ(v[1], 2);
+
+    Vector<std::string> s{"a"};
+    s.resize(4, "b");
+    ASSERT_EQ(s.size(), 4);
+    EXPECT_EQ(s[3], "b");
+
+    s.resize(10, s[0]);
+    EXPECT_EQ(s[9], "a");
+
+    s.resize(1);
+    EXPECT_EQ(s.size(), 1);
+}
+
+TEST(CapacityTest, ResizeDefaultInit) {
+    Vector<float> v;
+    v.resize_default_init(100);
+    EXPECT_EQ(v.size(), 100);
+    EXPECT_GE(v.capacity(), 100);
+
+    Vector<std::string> s;
+    s.resize_default_init(3);
+    ASSERT_EQ(s.size(), 3);
+    EXPECT_TRUE(s[2].empty());
+}
+
+TEST(CapacityTest, AppendUninitialized) {
+    Vector<uint8_t> buffer{1, 2};
+
+    uint8_t* tail = buffer.append_uninitialized(4);
+    EXPECT_EQ(tail, buffer.data() + 2);
+    for (int i = 0; i < 4; ++i) {
+        tail[i] = static_cast<uint8_t>(10 + i);
+    }
+
+    ASSERT_EQ(buffer.size(), 6);
+    EXPECT_EQ(buffer[0], 1);
+    EXPECT_EQ(buffer[5], 13);
+}
+
 TEST(CapacityTest, Clear) {
     Vector<int> v{1, 2, 3, 4, 5};
     size_t original_capacity = v.capacity();
@@ -299,6 +550,76 @@ TEST(IteratorTest, IteratorConstConversion) {
     EXPECT_TRUE(cit == it);
 }
 
+static_assert(std::contiguous_iterator<Vector<int>::iterator>);
+static_assert(std::contiguous_iterator<Vector<int>::const_iterator>);
+static_assert(std::same_as<std::iter_value_t<Vector<const int>::iterator>, int>);
+static_assert(std::ranges::contiguous_range<Vector<int>>);
+static_assert(std::ranges::sized_range<Vector<int>>);
+static_assert(std::ranges::contiguous_range<const Vector<std::string>>);
+
+TEST(IteratorTest, ContiguousRangeInterop) {
+    Vector<int> v{5, 3, 1, 4, 2};
+    std::sort(v.begin(), v.end());
+    EXPECT_TRUE(std::ranges::is_sorted(v));
+    EXPECT_EQ(std::to_address(v.begin() + 2), v.data() + 2);
+
+    std::span<int> s = v;
+    s[0] = 10;
+    EXPECT_EQ(v[0], 10);
+    std::span<const int> cs = std::as_const(v);
+    EXPECT_EQ(cs.size(), 5u);
+    EXPECT_EQ(std::ranges::data(v), v.data());
+
+    Vector<int> copy;
+    copy.resize(5);
+    std::ranges::copy(v, copy.begin());
+    EXPECT_TRUE(std::ranges::equal(v, copy));
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), copy.cbegin()));
+}
+
+TEST(IteratorTest, ReverseIterators) {
+    Vector<int> v{1, 2, 3, 4};
+    Vector<int> reversed(v | std::views::reverse);
+    EXPECT_EQ(reversed[0], 4);
+    EXPECT_EQ(reversed[3], 1);
+
+    const Vector<int> &cv = v;
+    EXPECT_EQ(*cv.rbegin(), 4);
+    EXPECT_EQ(std::accumulate(v.crbegin(), v.crend(), 0), 10);
+    *v.rbegin() = 40;
+    EXPECT_EQ(v[3], 40);
+}
+
+TEST(ConstructorTest, FromRangeAllocatesOnce) {
+    std::vector<std::string> strings{"a", "b", "c"};
+    Vector<std::string> fromVector(strings);
+    EXPECT_EQ(fromVector.size(), 3u);
+    EXPECT_EQ(fromVector.capacity(), 3u);
+    EXPECT_EQ(fromVector[2], "c");
+
+    std::forward_list<int> list{1, 2, 3, 4, 5, 6, 7};
+    Vector<int> fromList(list);
+    EXPECT_EQ(fromList.capacity(), 7u);
+    EXPECT_EQ(fromList[6], 7);
+
+    Vector<int> squares(std::views::iota(0, 10) | std::views::transform([](int i) { return i * i; }));
+    EXPECT_EQ(squares.capacity(), 10u);
+    EXPECT_EQ(squares[9], 81);
+
+    // Single-pass input falls back to appending
+    std::istringstream in("4 5 6");
+    Vector<int> fromStream(std::views::istream<int>(in));
+    EXPECT_EQ(fromStream.size(), 3u);
+    EXPECT_EQ(fromStream[2], 6);
+
+    Vector<int> empty(std::views::empty<int>);
+    EXPECT_EQ(empty.capacity(), 0u);
+
+    // Non-const lvalues still pick the copy constructor
+    Vector<int> copy(fromList);
+    EXPECT_EQ(copy.size(), 7u);
+}
+
 // utility
 
 TEST(UtilityTest, Empty) {
@@ -323,4 +644,248 @@ TEST(UtilityTest, Data) {
     const Vector<int>& cv = v;
     const int* cptr = cv.data();
     EXPECT_EQ(cptr[2], 3);
-}
\ No newline at end of file
+}
+// allocators
+
+namespace {
+
+// Stateful allocator tagged with an id, counts live allocations per instance
+template <typename T, bool Propagate>
+struct TaggedAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_swap = std::bool_constant<Propagate>;
+    using is_always_equal = std::false_type;
+
+    int id = 0;
+    std::shared_ptr<int> live = std::make_shared<int>(0);
+
+    TaggedAllocator() = default;
+    explicit TaggedAllocator(int i) : id(i) {}
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Propagate>& o) : id(o.id), live(o.live) {}
+
+    T* allocate(size_t n) {
+        ++*live;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) {
+        --*live;
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const TaggedAllocator<U, Propagate>& o) const { return id == o.id; }
+};
+
+} // namespace
+
+TEST(AllocatorTest, UsesProvidedAllocator) {
+    TaggedAllocator<int, true> alloc(1);
+    {
+        Vector<int, TaggedAllocator<int, true>> v(alloc);
+        for (int i = 0; i < 10; ++i) {
+            v.push_back(i);
+        }
+        EXPECT_EQ(*alloc.live, 1);
+        EXPECT_EQ(v.get_allocator().id, 1);
+    }
+    EXPECT_EQ(*alloc.live, 0);
+}
+
+TEST(AllocatorTest, PropagatingAllocatorFollowsCopyMoveSwap) {
+    using Alloc = TaggedAllocator<int, true>;
+    Vector<int, Alloc> a({1, 2, 3}, Alloc(1));
+    Vector<int, Alloc> b({4, 5}, Alloc(2));
+
+    b = a;
+    EXPECT_EQ(b.get_allocator().id, 1);
+    EXPECT_EQ(b[2], 3);
+
+    Vector<int, Alloc> c({7}, Alloc(3));
+    c = std::move(b);
+    EXPECT_EQ(c.get_allocator().id, 1);
+    EXPECT_EQ(c.size(), 3);
+
+    Vector<int, Alloc> d({9}, Alloc(4));
+    c.swap(d);
+    EXPECT_EQ(c.get_allocator().id, 4);
+    EXPECT_EQ(d.get_allocator().id, 1);
+    EXPECT_EQ(d.size(), 3);
+}
+
+TEST(AllocatorTest, NonPropagatingAllocatorMovesElementwise) {
+    using Alloc = TaggedAllocator<std::string, false>;
+    Vector<std::string, Alloc> a({"x", "y"}, Alloc(1));
+    Vector<std::string, Alloc> b(Alloc(2));
+
+    b = std::move(a);
+    EXPECT_EQ(b.get_allocator().id, 2);
+    ASSERT_EQ(b.size(), 2);
+    EXPECT_EQ(b[1], "y");
+
+    b = Vector<std::string, Alloc>({"z"}, Alloc(3));
+    EXPECT_EQ(b.get_allocator().id, 2);
+    EXPECT_EQ(b[0], "z");
+}
+
+TEST(AllocatorTest, PmrVectorUsesMemoryResource) {
+    std::byte buffer[1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    pmr::Vector<int> v(&arena);
+    for (int i = 0; i < 32; ++i) {
+        v.push_back(i);
+    }
+
+    EXPECT_GE(reinterpret_cast<std::byte*>(v.data()), buffer);
+    EXPECT_LT(reinterpret_cast<std::byte*>(v.data()), buffer + sizeof(buffer));
+    EXPECT_EQ(v[31], 31);
+
+    // pmr allocators do not propagate on copy construction
+    pmr::Vector<int> copy(v);
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy[31], 31);
+}
+
+// relocation
+
+namespace {
+
+// Handle type whose move constructor is observable but which opts into
+// bitwise relocation
+struct RelocatableHandle {
+    static inline int moves = 0;
+    static inline int destructions = 0;
+
+    int* ptr;
+
+    explicit RelocatableHandle(int v) : ptr(new int(v)) {}
+    RelocatableHandle(const RelocatableHandle& o) : ptr(new int(*o.ptr)) {}
+    RelocatableHandle(RelocatableHandle&& o) noexcept : ptr(std::exchange(o.ptr, nullptr)) { ++moves; }
+    ~RelocatableHandle() {
+        ++destructions;
+        delete ptr;
+    }
+};
+
+} // namespace
+
+template <>
+struct is_trivially_relocatable<RelocatableHandle> : std::true_type {};
+
+TEST(RelocationTest, TraitDefaults) {
+    EXPECT_TRUE(is_trivially_relocatable_v<int>);
+    EXPECT_TRUE(is_trivially_relocatable_v<std::unique_ptr<int>>);
+    EXPECT_TRUE((is_trivially_relocatable_v<std::pair<int, std::shared_ptr<int>>>));
+    EXPECT_FALSE(is_trivially_relocatable_v<std::string>);
+}
+
+TEST(RelocationTest, GrowthSkipsMoveAndDestroy) {
+    RelocatableHandle::moves = 0;
+    RelocatableHandle::destructions = 0;
+    {
+        Vector<RelocatableHandle> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(RelocatableHandle(i));
+        }
+        // Only the temporaries passed to push_back are moved and destroyed
+        EXPECT_EQ(RelocatableHandle::moves, 100);
+        EXPECT_EQ(RelocatableHandle::destructions, 100);
+
+        v.reserve(1000);
+        v.shrink_to_fit();
+        EXPECT_EQ(RelocatableHandle::moves, 100);
+        EXPECT_EQ(RelocatableHandle::destructions, 100);
+
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_EQ(*v[i].ptr, i);
+        }
+    }
+    EXPECT_EQ(RelocatableHandle::destructions, 200);
+}
+
+TEST(RelocationTest, UniquePtrGrowth) {
+    Vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < 50; ++i) {
+        v.push_back(std::make_unique<int>(i));
+    }
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(*v[i], i);
+    }
+}
+
+TEST(RelocationTest, PushBackOwnElementDuringGrowth) {
+    Vector<std::string> v{"a long string that does not fit in SSO"};
+    ASSERT_EQ(v.size(), v.capacity());
+    v.push_back(v[0]);
+    EXPECT_EQ(v[1], v[0]);
+}
+
+// CONSTANT EVALUATION
+
+namespace {
+    // CRC-32 lookup table built by pushing into a transient Vector at
+    // compile time, then copied out into a static array
+    constexpr std::array<uint32_t, 256> makeCrcTable() {
+        Vector<uint32_t> table;
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+            }
+            table.push_back(crc);
+        }
+        std::array<uint32_t, 256> out{};
+        std::copy(table.begin(), table.end(), out.begin());
+        return out;
+    }
+
+    constexpr std::array<uint32_t, 256> kCrcTable = makeCrcTable();
+
+    // Runs the relocation, insert and erase paths that use memmove at runtime
+    constexpr std::array<int, 6> editAtCompileTime() {
+        Vector<int> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i * i);
+        }
+        v.insert(v.begin() + 1, {7, 8, 9});
+        v.erase(v.begin() + 2);
+        v.emplace(v.begin(), -1);
+        Vector<int> copy = v;
+        copy.reserve(1000);
+        copy.shrink_to_fit();
+        copy.resize(200, 5);
+        copy.pop_back();
+        const Vector<int> moved(std::move(copy));
+        return {moved[0], moved.at(1), moved[2], moved[3], moved[4], static_cast<int>(moved.size())};
+    }
+
+    constexpr size_t stringLengthsAtCompileTime() {
+        Vector<std::string> v{"a", "bb"};
+        for (size_t i = 0; i < 20; ++i) {
+            v.emplace_back(i, 'x');
+        }
+        v.insert(v.begin(), "ccc");
+        v.erase(v.begin() + 1);
+        size_t total = 0;
+        for (auto it = v.rbegin(); it != v.rend(); ++it) {
+            total += it->size();
+        }
+        return total;
+    }
+}
+
+static_assert(kCrcTable[0] == 0);
+static_assert(kCrcTable[1] == 0x77073096u);
+static_assert(kCrcTable[255] == 0x2D02EF8Du);
+static_assert(editAtCompileTime() == std::array<int, 6>{-1, 0, 7, 9, 1, 199});
+static_assert(stringLengthsAtCompileTime() == 3 + 2 + 190);
+
+TEST(ConstexprTest, CompileTimeTableMatchesRuntime) {
+    const std::array<uint32_t, 256> runtime = makeCrcTable();
+    EXPECT_EQ(runtime, kCrcTable);
+    EXPECT_EQ(editAtCompileTime(), (std::array<int, 6>{-1, 0, 7, 9, 1, 199}));
+    EXPECT_EQ(stringLengthsAtCompileTime(), 195u);
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "vector.hpp"
+#include "small_vector.hpp"
+#include "vector_algorithms.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#if defined(VECTOR_SIMD_X86)
+#error "vector_algorithms.hpp leaks VECTOR_SIMD_X86"
+#endif
+
+namespace va = vector_algorithms;
+
+namespace {
+    // Every instruction set this CPU can run, narrowest first
+    std::vector<va::Isa> availableIsas() {
+        std::vector<va::Isa> isas;
+        for (va::Isa isa : {va::Isa::Scalar, va::Isa::SSE2, va::Isa::AVX2, va::Isa::AVX512}) {
+            if (static_cast<int>(isa) <= static_cast<int>(va::detectIsa())) {
+                isas.push_back(isa);
+            }
+        }
+        return isas;
+    }
+
+    // Restores the best instruction set when a test ends
+    struct IsaGuard {
+        ~IsaGuard() { va::setIsa(va::detectIsa()); }
+    };
+
+    // Small integer values, so float sums are exact whatever the order
+    template <typename T>
+    Vector<T> randomVector(size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> dist(-50, 50);
+        Vector<T> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(static_cast<T>(dist(rng)));
+        }
+        return v;
+    }
+
+    // Sizes around every lane count and unroll factor, plus a large one
+    const size_t kSizes[] = {0, 1, 2, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 1000, 4099};
+}
+
+template <typename T>
+class VectorAlgorithmsTest : public ::testing::Test {};
+
+using SimdTypes = ::testing::Types<int32_t, int64_t, float, double>;
+TYPED_TEST_SUITE(VectorAlgorithmsTest, SimdTypes);
+
+TYPED_TEST(VectorAlgorithmsTest, ReductionsMatchScalar) {
+    using T = TypeParam;
+    IsaGuard guard;
+    for (va::Isa isa : availableIsas()) {
+        va::setIsa(isa);
+        for (size_t n : kSizes) {
+            const Vector<T> a = randomVector<T>(n, static_cast<unsigned>(n));
+            const Vector<T> b = randomVector<T>(n, static_cast<unsigned>(n + 1));
+
+            T sum{}, dot{};
+            for (size_t i = 0; i < n; ++i) {
+                sum += a[i];
+                dot += a[i] * b[i];
+            }
+            EXPECT_EQ(va::reduce(a), sum) << "isa " << static_cast<int>(isa) << " n " << n;
+            EXPECT_EQ(va::dot(a, b), dot) << "isa " << static_cast<int>(isa) << " n " << n;
+
+            if (n == 0) {
+                EXPECT_THROW(va::min(a), std::out_of_range);
+                EXPECT_EQ(va::argmax(a), 0u);
+                continue;
+            }
+            size_t lo = 0, hi = 0;
+            for (size_t i = 1; i < n; ++i) {
+                lo = a[i] < a[lo] ? i : lo;
+                hi = a[i] > a[hi] ? i : hi;
+            }
+            EXPECT_EQ(va::min(a), a[lo]);
+            EXPECT_EQ(va::max(a), a[hi]);
+            EXPECT_EQ(va::argmin(a), lo);
+            EXPECT_EQ(va::argmax(a), hi);
+        }
+    }
+}
+
+TYPED_TEST(VectorAlgorithmsTest, SearchMatchesScalar) {
+    using T = TypeParam;
+    IsaGuard guard;
+    for (va::Isa isa : availableIsas()) {
+        va::setIsa(isa);
+        for (size_t n : kSizes) {
+            const Vector<T> a = randomVector<T>(n, static_cast<unsigned>(3 * n));
+            for (T needle : {T(0), T(7), T(-50), T(1000)}) {
+                size_t first = n, matches = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    if (a[i] == needle) {
+                        first = std::min(first, i);
+                        ++matches;
+                    }
+                }
+                EXPECT_EQ(va::find(a, needle), first) << "isa " << static_cast<int>(isa) << " n " << n;
+                EXPECT_EQ(va::count(a, needle), matches) << "isa " << static_cast<int>(isa) << " n " << n;
+            }
+
+            Vector<T> b(a);
+            EXPECT_TRUE(va::equal(a, b));
+            if (n > 0) {
+                b[n - 1] += T(1);
+                EXPECT_FALSE(va::equal(a, b));
+                b[n - 1] = a[n - 1];
+                b[0] += T(1);
+                EXPECT_FALSE(va::equal(a, b));
+            }
+            b.push_back(T(1));
+            EXPECT_FALSE(va::equal(a, b));
+        }
+    }
+}
+
+TYPED_TEST(VectorAlgorithmsTest, TransformsMatchScalar) {
+    using T = TypeParam;
+    IsaGuard guard;
+    for (va::Isa isa : availableIsas()) {
+        va::setIsa(isa);
+        for (size_t n : kSizes) {
+            const Vector<T> a = randomVector<T>(n, static_cast<unsigned>(5 * n));
+            const Vector<T> b = randomVector<T>(n, static_cast<unsigned>(5 * n + 1));
+
+            Vector<T> sum(a), product(a), scaled(a), filled(a);
+            va::add(sum, b);
+            va::multiply(product, b);
+            va::scale(scaled, T(3));
+            va::fill(filled, T(9));
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(sum[i], a[i] + b[i]);
+                ASSERT_EQ(product[i], a[i] * b[i]);
+                ASSERT_EQ(scaled[i], a[i] * T(3));
+                ASSERT_EQ(filled[i], T(9));
+            }
+        }
+    }
+}
+
+TEST(VectorAlgorithmsTest, SizeMismatchThrows) {
+    Vector<float> a = randomVector<float>(8, 1);
+    const Vector<float> b = randomVector<float>(9, 2);
+    EXPECT_THROW(va::dot(a, b), std::invalid_argument);
+    EXPECT_THROW(va::add(a, b), std::invalid_argument);
+    EXPECT_THROW(va::multiply(a, b), std::invalid_argument);
+}
+
+TEST(VectorAlgorithmsTest, WorksOnOtherContiguousContainers) {
+    SmallVector<double, 4> small;
+    std::vector<double> standard;
+    for (int i = 0; i < 100; ++i) {
+        small.push_back(i);
+        standard.push_back(i);
+    }
+    EXPECT_EQ(va::reduce(small), 4950.0);
+    EXPECT_EQ(va::reduce(standard), 4950.0);
+    EXPECT_EQ(va::find(small, 42.0), 42u);
+    EXPECT_TRUE(va::equal(small, standard));
+}
+
+TEST(VectorAlgorithmsTest, SetIsaClampsToCpu) {
+    IsaGuard guard;
+    EXPECT_EQ(va::setIsa(va::Isa::Scalar), va::Isa::Scalar);
+    EXPECT_EQ(va::activeIsa(), va::Isa::Scalar);
+    EXPECT_EQ(va::setIsa(va::Isa::AVX512), va::detectIsa());
+}
@@ -0,0 +1,68 @@
+// Built with -DVECTOR_INSTRUMENTATION, see tests/CMakeLists.txt
+#include <gtest/gtest.h>
+#include "vector.hpp"
+#include "vector_instrumentation.hpp"
+#include <sstream>
+#include <string>
+
+using instrumented::Registry;
+
+TEST(InstrumentationTest, CountsAllocationsAndReallocations) {
+    auto site = instrumented::named("growth");
+    site.stats->reset();
+    {
+        instrumented::Vector<int> v(site);
+        for (int i = 0; i < 8; ++i) {
+            v.push_back(i);
+        }
+        // capacities 1, 2, 4, 8
+        EXPECT_EQ(site.stats->allocations, 4);
+        EXPECT_EQ(site.stats->reallocations, 3);
+        EXPECT_EQ(site.stats->elementsMoved, 1 + 2 + 4);
+        EXPECT_EQ(site.stats->bytesAllocated, (1 + 2 + 4 + 8) * sizeof(int));
+        EXPECT_EQ(site.stats->liveBytes, 8 * sizeof(int));
+        EXPECT_EQ(site.stats->peakCapacity, 8);
+    }
+    EXPECT_EQ(site.stats->deallocations, 4);
+    EXPECT_EQ(site.stats->liveBytes, 0);
+    EXPECT_EQ(site.stats->peakSize, 8);
+}
+
+TEST(InstrumentationTest, CountsCopiesAndSlack) {
+    auto site = instrumented::named("copies");
+    site.stats->reset();
+    {
+        instrumented::Vector<std::string> v(site);
+        v.reserve(10);
+        v.push_back("a");
+        v.push_back("b");
+
+        instrumented::Vector<std::string> copy(v);
+        EXPECT_EQ(site.stats->elementsCopied, 2);
+        EXPECT_EQ(copy.get_allocator().site(), site.stats);
+    }
+    // v released 8 unused slots, the exact-size copy none
+    EXPECT_EQ(site.stats->slackBytes, 8 * sizeof(std::string));
+}
+
+TEST(InstrumentationTest, HereNamesCallSite) {
+    instrumented::Vector<int> v(instrumented::here());
+    v.push_back(1);
+
+    const std::string name = v.get_allocator().site()->name;
+    EXPECT_NE(name.find("test_vector_instrumentation.cpp:"), std::string::npos);
+}
+
+TEST(InstrumentationTest, MacroInstrumentsDefaultVector) {
+    static_assert(std::is_same_v<Vector<double>::allocator_type, instrumented::Allocator<double>>);
+
+    Vector<double> v;
+    auto* stats = v.get_allocator().site();
+    stats->reset();
+    v.reserve(16);
+    EXPECT_EQ(stats->allocations, 1);
+
+    std::ostringstream os;
+    Registry::instance().dump(os);
+    EXPECT_NE(os.str().find(stats->name), std::string::npos);
+}
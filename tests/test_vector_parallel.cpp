@@ -0,0 +1,281 @@
+#include <gtest/gtest.h>
+#include "vector_parallel.hpp"
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using vector_parallel::ThreadPool;
+
+namespace {
+    Vector<int64_t> iota(size_t n) {
+        Vector<int64_t> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(static_cast<int64_t>(i));
+        }
+        return v;
+    }
+}
+
+TEST(ThreadPoolTest, RunsEveryIndexOnce) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(hits.size(), [&](size_t i) { hits[i].fetch_add(1); });
+    for (const auto &h : hits) {
+        EXPECT_EQ(h.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, SingleThreadRunsInline) {
+    ThreadPool pool(1);
+    const auto caller = std::this_thread::get_id();
+    pool.parallelFor(16, [&](size_t) { EXPECT_EQ(std::this_thread::get_id(), caller); });
+}
+
+TEST(ThreadPoolTest, PropagatesException) {
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallelFor(100, [](size_t i) {
+        if (i == 37) {
+            throw std::runtime_error("chunk failed");
+        }
+    }),
+                 std::runtime_error);
+
+    // The pool stays usable afterwards
+    std::atomic<size_t> total{0};
+    pool.parallelFor(100, [&](size_t i) { total += i; });
+    EXPECT_EQ(total.load(), 4950u);
+}
+
+TEST(ThreadPoolTest, NestedParallelForCompletes) {
+    ThreadPool pool(3);
+    std::atomic<size_t> total{0};
+    pool.parallelFor(8, [&](size_t) {
+        pool.parallelFor(8, [&](size_t) { total.fetch_add(1); });
+    });
+    EXPECT_EQ(total.load(), 64u);
+}
+
+TEST(ParallelAlgorithmsTest, ForEachAndReduce) {
+    ThreadPool pool(4);
+    for (size_t n : {0u, 1u, 100u, 100003u}) {
+        Vector<int64_t> v = iota(n);
+        vector_parallel::parallel_for_each(v, [](int64_t &x) { x *= 2; }, 1000, pool);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(v[i], 2 * static_cast<int64_t>(i));
+        }
+
+        const int64_t expected = n == 0 ? 0 : static_cast<int64_t>(n) * static_cast<int64_t>(n - 1);
+        EXPECT_EQ(vector_parallel::parallel_reduce(v, 1000, pool), expected);
+        EXPECT_EQ(vector_parallel::parallel_reduce(v, int64_t(5), std::plus<>{}, vector_parallel::kAutoGrain, pool),
+                  expected + 5);
+    }
+}
+
+TEST(ParallelAlgorithmsTest, ReduceKeepsChunkOrder) {
+    // String concatenation is associative but not commutative
+    ThreadPool pool(4);
+    Vector<std::string> v;
+    std::string expected = ">";
+    for (int i = 0; i < 2000; ++i) {
+        v.push_back(std::to_string(i % 10));
+        expected += v[v.size() - 1];
+    }
+    EXPECT_EQ(vector_parallel::parallel_reduce(v, std::string(">"), std::plus<>{}, 64, pool), expected);
+}
+
+// Chunks start from an element and partials are combined with op, so a
+// reduction into another type is rejected unless both work
+namespace {
+    template <typename T, typename U, typename Op>
+    concept Reducible = requires(const Vector<T> &v, U init, Op op) {
+        vector_parallel::parallel_reduce(v, init, op);
+    };
+
+    const auto addLength = [](size_t total, const std::string &s) { return total + s.size(); };
+}
+
+static_assert(Reducible<int, int64_t, std::plus<>>);
+static_assert(Reducible<std::string, std::string, std::plus<>>);
+static_assert(!Reducible<std::string, size_t, decltype(addLength)>);
+
+TEST(ParallelAlgorithmsTest, TransformAndCopy) {
+    ThreadPool pool(4);
+    const Vector<int64_t> in = iota(50000);
+    Vector<double> out;
+    out.resize(in.size());
+    vector_parallel::parallel_transform(in, out, [](int64_t x) { return x * 0.5; }, 777, pool);
+    for (size_t i = 0; i < in.size(); ++i) {
+        ASSERT_EQ(out[i], static_cast<double>(i) * 0.5);
+    }
+
+    Vector<int64_t> copy;
+    copy.resize(in.size());
+    vector_parallel::parallel_copy(in, copy, 777, pool);
+    EXPECT_TRUE(std::equal(in.begin(), in.end(), copy.begin()));
+
+    Vector<std::string> words, wordsCopy;
+    for (int i = 0; i < 5000; ++i) {
+        words.push_back(std::string(40, static_cast<char>('a' + i % 26)));
+    }
+    wordsCopy.resize(words.size());
+    vector_parallel::parallel_copy(words, wordsCopy, 100, pool);
+    EXPECT_TRUE(std::equal(words.begin(), words.end(), wordsCopy.begin()));
+
+    copy.pop_back();
+    EXPECT_THROW(vector_parallel::parallel_copy(in, copy, 777, pool), std::invalid_argument);
+    EXPECT_THROW(vector_parallel::parallel_transform(in, copy, [](int64_t x) { return x; }, 777, pool),
+                 std::invalid_argument);
+}
+
+TEST(ParallelAlgorithmsTest, SortMatchesStdSort) {
+    ThreadPool pool(4);
+    std::mt19937 rng(42);
+    for (size_t n : {0u, 1u, 2u, 1000u, 99999u}) {
+        for (size_t grain : {size_t(16), size_t(1000), vector_parallel::kAutoGrain}) {
+            Vector<int> v;
+            std::vector<int> reference;
+            for (size_t i = 0; i < n; ++i) {
+                const int x = static_cast<int>(rng() % 1000);
+                v.push_back(x);
+                reference.push_back(x);
+            }
+            vector_parallel::parallel_sort(v, std::less<>{}, grain, pool);
+            std::sort(reference.begin(), reference.end());
+            ASSERT_TRUE(std::equal(v.begin(), v.end(), reference.begin())) << "n " << n << " grain " << grain;
+        }
+    }
+
+    Vector<int> descending;
+    for (int i = 0; i < 10000; ++i) {
+        descending.push_back(i);
+    }
+    vector_parallel::parallel_sort(descending, std::greater<>{}, 100, pool);
+    EXPECT_TRUE(std::is_sorted(descending.begin(), descending.end(), std::greater<>{}));
+}
+
+TEST(ParallelAlgorithmsTest, ChunksStartOnCacheLines) {
+    Vector<int> v;
+    v.resize(10000);
+    const vector_parallel::parallel_detail::Chunking<int> chunking(v.data(), v.size(), 100, 4);
+    EXPECT_EQ(chunking.begin(0), 0u);
+    EXPECT_EQ(chunking.end(chunking.chunks - 1), v.size());
+    for (size_t c = 1; c < chunking.chunks; ++c) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data() + chunking.begin(c)) % vector_parallel::kCacheLine, 0u);
+        EXPECT_GT(chunking.begin(c), chunking.begin(c - 1));
+    }
+}
+
+namespace {
+    // Counts live instances; copying the instance tagged poison throws
+    struct Tracked {
+        static inline std::atomic<int> live{0};
+
+        int value = 0;
+        bool poison = false;
+
+        explicit Tracked(int v, bool p = false) : value(v), poison(p) { ++live; }
+        Tracked(const Tracked &other) : value(other.value), poison(other.poison) {
+            if (poison) {
+                throw std::runtime_error("poisoned copy");
+            }
+            ++live;
+        }
+        Tracked &operator=(const Tracked &) = default;
+        ~Tracked() { --live; }
+    };
+}
+
+TEST(ParallelConstructionTest, CopyAssignAndResize) {
+    ThreadPool pool(4);
+    Vector<std::string> table;
+    for (int i = 0; i < 20000; ++i) {
+        table.push_back(std::string(40, static_cast<char>('a' + i % 26)) + std::to_string(i));
+    }
+
+    vector_parallel::ParallelConstructionScope scope(100, pool);
+    Vector<std::string> snapshot(table);
+    EXPECT_TRUE(std::equal(table.begin(), table.end(), snapshot.begin()));
+    EXPECT_EQ(snapshot.size(), table.size());
+
+    Vector<std::string> assigned;
+    assigned.assign(table.begin(), table.end());
+    EXPECT_TRUE(std::equal(table.begin(), table.end(), assigned.begin()));
+    assigned.assign(5000, std::string(50, 'q'));
+    EXPECT_EQ(assigned.size(), 5000u);
+    EXPECT_TRUE(std::all_of(assigned.begin(), assigned.end(), [](const std::string &s) { return s == std::string(50, 'q'); }));
+
+    Vector<std::string> grown;
+    grown.push_back("first");
+    grown.resize(30000, std::string(33, 'z'));
+    EXPECT_EQ(grown[0], "first");
+    EXPECT_TRUE(std::all_of(grown.begin() + 1, grown.end(), [](const std::string &s) { return s == std::string(33, 'z'); }));
+}
+
+TEST(ParallelConstructionTest, ThrowingCopyDestroysEverything) {
+    ThreadPool pool(4);
+    {
+        Vector<Tracked> source;
+        for (int i = 0; i < 10000; ++i) {
+            source.push_back(Tracked(i));
+        }
+        source[7777].poison = true;
+        const int before = Tracked::live.load();
+
+        vector_parallel::ParallelConstructionScope scope(100, pool);
+        EXPECT_THROW(Vector<Tracked> copy(source), std::runtime_error);
+        EXPECT_EQ(Tracked::live.load(), before);
+
+        Vector<Tracked> target;
+        target.push_back(Tracked(-1));
+        EXPECT_THROW(target.assign(source.begin(), source.end()), std::runtime_error);
+        EXPECT_EQ(Tracked::live.load(), before + 1);
+        EXPECT_EQ(target.size(), 1u);
+        EXPECT_EQ(target[0].value, -1);
+
+        const Tracked poisoned(0, true);
+        EXPECT_THROW(target.resize(5000, poisoned), std::runtime_error);
+        EXPECT_EQ(target.size(), 1u);
+        EXPECT_EQ(Tracked::live.load(), before + 2);
+    }
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
+
+TEST(ParallelConstructionTest, ViewsAreEvaluatedInOrderOnTheCallingThread) {
+    ThreadPool pool(4);
+    vector_parallel::ParallelConstructionScope scope(100, pool);
+
+    const std::thread::id caller = std::this_thread::get_id();
+    int next = 0;
+    bool inOrder = true;
+    const auto render = [&](int i) {
+        inOrder = inOrder && std::this_thread::get_id() == caller && i == next++;
+        return std::to_string(i);
+    };
+
+    Vector<std::string> v;
+    v.append_range(std::views::iota(0, 20000) | std::views::transform(render));
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(v.size(), 20000u);
+    EXPECT_EQ(v[12345], "12345");
+}
+
+TEST(ParallelConstructionTest, ScopesNestAndRestore) {
+    EXPECT_EQ(vector_detail::currentParallelExecutor(), nullptr);
+    {
+        vector_parallel::ParallelConstructionScope outer;
+        EXPECT_EQ(vector_detail::currentParallelExecutor(), &outer);
+        {
+            vector_parallel::ParallelConstructionScope inner(10);
+            EXPECT_EQ(vector_detail::currentParallelExecutor(), &inner);
+        }
+        EXPECT_EQ(vector_detail::currentParallelExecutor(), &outer);
+    }
+    EXPECT_EQ(vector_detail::currentParallelExecutor(), nullptr);
+}
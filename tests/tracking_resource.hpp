@@ -0,0 +1,33 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory_resource>
+#include <set>
+
+// Memory resource for allocator-propagation tests: fails the test when a
+// block is released through a resource that did not allocate it, or is
+// never released at all
+class TrackingResource : public std::pmr::memory_resource {
+public:
+    ~TrackingResource() override { EXPECT_TRUE(m_blocks.empty()); }
+
+    bool owns(const void *p) const { return m_blocks.count(p) != 0; }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        void *p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        m_blocks.insert(p);
+        return p;
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        EXPECT_TRUE(owns(p)) << "block freed by the wrong resource";
+        m_blocks.erase(p);
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    std::set<const void *> m_blocks;
+};